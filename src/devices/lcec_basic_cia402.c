@@ -106,6 +106,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types, CIA402_MAX_CHANNELS, modparams_perchannel
 
 static void lcec_basic_cia402_read(lcec_slave_t *slave, long period);
 static void lcec_basic_cia402_write(lcec_slave_t *slave, long period);
+static int lcec_basic_cia402_post_reg(lcec_slave_t *slave);
 
 typedef struct {
   lcec_class_cia402_channels_t *cia402;
@@ -190,6 +191,7 @@ static int lcec_basic_cia402_init(int comp_id, lcec_slave_t *slave) {
   // initialize read/write
   slave->proc_read = lcec_basic_cia402_read;
   slave->proc_write = lcec_basic_cia402_write;
+  slave->proc_post_reg = lcec_basic_cia402_post_reg;
 
   // XXXX: we should generally (always?) run CiA 402 devices in
   // distributed-clock mode.  Consider turning this on by default if
@@ -291,7 +293,7 @@ static void lcec_basic_cia402_read(lcec_slave_t *slave, long period) {
 
   // XXXX: If you need to read device-specific PDOs and set pins, then you should do this here.
   //
-  // uint8_t *pd = slave->master->process_data;
+  // uint8_t *pd = slave->sync_unit->process_data;
   // *(hal_data->alarm_code) = EC_READ_U16(&pd[hal_data->alarm_code_os]);
 
   lcec_cia402_read_all(slave, hal_data->cia402);
@@ -310,3 +312,10 @@ static void lcec_basic_cia402_write(lcec_slave_t *slave, long period) {
 
   lcec_cia402_write_all(slave, hal_data->cia402);
 }
+
+static int lcec_basic_cia402_post_reg(lcec_slave_t *slave) {
+  lcec_basic_cia402_data_t *hal_data = (lcec_basic_cia402_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  return 0;
+}
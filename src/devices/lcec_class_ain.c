@@ -62,6 +62,16 @@ static const lcec_pindesc_t slave_pins_status[] = {
     {HAL_TYPE_UNSPECIFIED, HAL_DIR_UNSPECIFIED, -1, NULL},
 };
 
+/// @brief Names accepted for `oversampling_filter`, e.g. by the `filter` modParam.
+const lcec_lookuptable_int_t lcec_ain_filters[] = {
+    {"mean", LCEC_AIN_FILTER_MEAN},
+    {"min", LCEC_AIN_FILTER_MIN},
+    {"max", LCEC_AIN_FILTER_MAX},
+    {"fir", LCEC_AIN_FILTER_FIR},
+    {"iir", LCEC_AIN_FILTER_IIR},
+    {NULL},
+};
+
 /// @brief Allocate a block of memory for holding the results from
 /// `count` calls to `lcec_ain_register_device() and friends.
 ///
@@ -76,6 +86,13 @@ lcec_class_ain_channels_t *lcec_ain_allocate_channels(int count) {
   channels = LCEC_HAL_ALLOCATE(lcec_class_ain_channels_t);
   channels->count = count;
   channels->channels = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_ain_channel_t *, count);
+  channels->batch = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_ain_batch_t, count);
+  channels->recip = LCEC_HAL_ALLOCATE_ARRAY(double, count);
+  channels->scale = LCEC_HAL_ALLOCATE_ARRAY(double, count);
+  channels->factor = LCEC_HAL_ALLOCATE_ARRAY(double, count);
+  channels->bias = LCEC_HAL_ALLOCATE_ARRAY(double, count);
+  channels->raw = LCEC_HAL_ALLOCATE_ARRAY(double, count);
+  channels->val = LCEC_HAL_ALLOCATE_ARRAY(double, count);
 
   return channels;
 }
@@ -87,6 +104,65 @@ lcec_class_ain_channels_t *lcec_ain_allocate_channels(int count) {
 /// everything to 0 here.
 lcec_class_ain_options_t *lcec_ain_options(void) { return LCEC_HAL_ALLOCATE(lcec_class_ain_options_t); }
 
+/// @brief Set up the oversampling state of a channel and register its sample PDO entries.
+static lcec_class_ain_oversampling_t *lcec_ain_register_oversampling(
+    lcec_slave_t *slave, int id, const char *name_prefix, uint16_t idx, uint16_t sidx, lcec_class_ain_options_t *opt) {
+  lcec_class_ain_oversampling_t *os = LCEC_HAL_ALLOCATE(lcec_class_ain_oversampling_t);
+  int count = opt->oversampling, total = 0, pad = 0;
+
+  os->count = count;
+  os->padded = (count + LCEC_AIN_LANES - 1) & ~(LCEC_AIN_LANES - 1);
+  os->filter = opt->oversampling_filter;
+  os->sample_os = LCEC_HAL_ALLOCATE_ARRAY(unsigned int, count);
+  os->samples = LCEC_HAL_ALLOCATE_ARRAY(int32_t, os->padded);
+  os->weights = LCEC_HAL_ALLOCATE_ARRAY(int32_t, os->padded);
+
+  for (int k = 0; k < count; k++) {
+    lcec_pdo_init(slave, idx + k * opt->sample_idx_step, sidx, &os->sample_os[k], NULL);
+  }
+
+  // the padding must not move the result: 0 for sums, the far end of
+  // the range for min and max
+  if (os->filter == LCEC_AIN_FILTER_MIN) pad = INT32_MAX;
+  if (os->filter == LCEC_AIN_FILTER_MAX) pad = INT32_MIN;
+  for (int k = count; k < os->padded; k++) {
+    os->samples[k] = pad;
+  }
+
+  // triangular window, scaled to Q15 with the rounding error in the
+  // middle tap so the taps sum to exactly 1 << 15
+  for (int k = 0; k < count; k++) {
+    total += (k < count - k) ? k + 1 : count - k;
+  }
+  pad = 1 << 15;
+  for (int k = 0; k < count; k++) {
+    os->weights[k] = (((k < count - k) ? k + 1 : count - k) << 15) / total;
+    pad -= os->weights[k];
+  }
+  os->weights[count / 2] += pad;
+
+  // one cycle's worth of samples as the IIR time constant
+  os->alpha = 1.0 / count;
+  if (os->filter == LCEC_AIN_FILTER_IIR) {
+    if (lcec_param_newf(HAL_FLOAT, HAL_RW, (void *)&os->alpha, "%s.%s.%s.%s-%d-filter-alpha", LCEC_MODULE_NAME, slave->master->name,
+            slave->name, name_prefix, id) != 0) {
+      return NULL;
+    }
+  }
+
+  if (opt->oversampling_pins) {
+    os->sample_pins = LCEC_HAL_ALLOCATE_ARRAY(hal_s32_t *, count);
+    for (int k = 0; k < count; k++) {
+      if (lcec_pin_newf(HAL_S32, HAL_OUT, (void **)&os->sample_pins[k], "%s.%s.%s.%s-%d-sample-%d", LCEC_MODULE_NAME,
+              slave->master->name, slave->name, name_prefix, id, k) != 0) {
+        return NULL;
+      }
+    }
+  }
+
+  return os;
+}
+
 /// @brief registers a single analog-input channel and publishes it as a LinuxCNC HAL pin.
 ///
 /// @param slave The slave, from `_init`.
@@ -110,6 +186,8 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
   uint16_t overrange_idx = idx, overrange_sidx = 0x02;
   uint16_t error_idx = idx, error_sidx = 0x07;
   uint16_t syncerror_idx = idx, syncerror_sidx = 0x0e;
+  int oversampling = 1;
+  uint16_t sample_idx_step = 0x10;
 
   // Handle options in `opt`.  Remember that `opt` can be `NULL`, and
   // any unset values should retain their values from above.
@@ -129,6 +207,14 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
   if (opt && opt->error_sidx) error_sidx = opt->error_sidx;
   if (opt && opt->syncerror_idx) syncerror_idx = opt->syncerror_idx;
   if (opt && opt->syncerror_sidx) syncerror_sidx = opt->syncerror_sidx;
+  if (opt && opt->oversampling) oversampling = opt->oversampling;
+  if (opt && opt->sample_idx_step) sample_idx_step = opt->sample_idx_step;
+
+  if (oversampling < 1 || oversampling > LCEC_AIN_MAX_OVERSAMPLING) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s channel %d: oversampling must be between 1 and %d, not %d\n",
+        slave->master->name, slave->name, id, LCEC_AIN_MAX_OVERSAMPLING, oversampling);
+    return NULL;
+  }
 
   // The default name depends on the port type.
   const char *name_prefix = "ain";
@@ -154,6 +240,8 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
   opt->is_pressure = is_pressure;
   opt->is_temperature = is_temperature;
   opt->max_value = max_value;
+  opt->oversampling = oversampling;
+  opt->sample_idx_step = sample_idx_step;
 
   // This is written into `data`, not `opt`, because there are cases
   // where we want drivers to be able to override it at runtime.  For
@@ -164,8 +252,15 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
   // treat `opt` as read-only after this point.
   data->is_unsigned = is_unsigned;
 
-  // Register basic PDO pins
-  lcec_pdo_init(slave, value_idx, value_sidx, &data->val_pdo_os, NULL);
+  // Register basic PDO pins.  With oversampling, the value is sample 0.
+  if (oversampling > 1) {
+    data->oversampling = lcec_ain_register_oversampling(slave, id, name_prefix, value_idx, value_sidx, opt);
+    if (data->oversampling == NULL) {
+      return NULL;
+    }
+  } else {
+    lcec_pdo_init(slave, value_idx, value_sidx, &data->val_pdo_os, NULL);
+  }
 
   // Register sync error PDO, if used.
   if (has_sync) lcec_pdo_init(slave, syncerror_idx, syncerror_sidx, &data->sync_err_pdo_os, &data->sync_err_pdo_bp);
@@ -221,6 +316,162 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
   return data;
 }
 
+/// @brief Decode `count` consecutive 16-bit samples, `LCEC_AIN_LANES` at a time.
+static void lcec_ain_decode(int32_t *restrict samples, const uint8_t *restrict p, int count, int32_t sign) {
+  int k = 0;
+
+  for (; k + LCEC_AIN_LANES <= count; k += LCEC_AIN_LANES) {
+    for (int j = 0; j < LCEC_AIN_LANES; j++) {
+      samples[k + j] = (int32_t)(EC_READ_U16(&p[2 * (k + j)]) ^ sign) - sign;
+    }
+  }
+  for (; k < count; k++) {
+    samples[k] = (int32_t)(EC_READ_U16(&p[2 * k]) ^ sign) - sign;
+  }
+}
+
+/// @brief Decode this cycle's samples into `os->samples`.
+static inline void lcec_ain_gather(lcec_class_ain_oversampling_t *os, const uint8_t *pd, int32_t sign) {
+  int32_t *samples = os->samples;
+  const unsigned int *sample_os = os->sample_os;
+
+  if (os->contiguous) {
+    lcec_ain_decode(samples, &pd[sample_os[0]], os->count, sign);
+    return;
+  }
+  for (int k = 0; k < os->count; k++) {
+    samples[k] = (int32_t)(EC_READ_U16(&pd[sample_os[k]]) ^ sign) - sign;
+  }
+}
+
+// The integer reductions below keep LCEC_AIN_LANES partial results
+// side by side, so they vectorize without reassociating floating
+// point math.  16-bit samples can't overflow them: at most 100 samples
+// are summed, and the FIR taps sum to 1 << 15.
+
+static int32_t lcec_ain_sum(const int32_t *restrict s, int padded) {
+  int32_t acc[LCEC_AIN_LANES] = {0}, sum = 0;
+
+  for (int k = 0; k < padded; k += LCEC_AIN_LANES) {
+    for (int j = 0; j < LCEC_AIN_LANES; j++) {
+      acc[j] += s[k + j];
+    }
+  }
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    sum += acc[j];
+  }
+  return sum;
+}
+
+static int32_t lcec_ain_min(const int32_t *restrict s, int padded) {
+  int32_t acc[LCEC_AIN_LANES], min = INT32_MAX;
+
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    acc[j] = INT32_MAX;
+  }
+  for (int k = 0; k < padded; k += LCEC_AIN_LANES) {
+    for (int j = 0; j < LCEC_AIN_LANES; j++) {
+      acc[j] = (s[k + j] < acc[j]) ? s[k + j] : acc[j];
+    }
+  }
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    min = (acc[j] < min) ? acc[j] : min;
+  }
+  return min;
+}
+
+static int32_t lcec_ain_max(const int32_t *restrict s, int padded) {
+  int32_t acc[LCEC_AIN_LANES], max = INT32_MIN;
+
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    acc[j] = INT32_MIN;
+  }
+  for (int k = 0; k < padded; k += LCEC_AIN_LANES) {
+    for (int j = 0; j < LCEC_AIN_LANES; j++) {
+      acc[j] = (s[k + j] > acc[j]) ? s[k + j] : acc[j];
+    }
+  }
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    max = (acc[j] > max) ? acc[j] : max;
+  }
+  return max;
+}
+
+static int32_t lcec_ain_dot(const int32_t *restrict s, const int32_t *restrict w, int padded) {
+  int32_t acc[LCEC_AIN_LANES] = {0}, sum = 0;
+
+  for (int k = 0; k < padded; k += LCEC_AIN_LANES) {
+    for (int j = 0; j < LCEC_AIN_LANES; j++) {
+      acc[j] += s[k + j] * w[k + j];
+    }
+  }
+  for (int j = 0; j < LCEC_AIN_LANES; j++) {
+    sum += acc[j];
+  }
+  return sum;
+}
+
+/// @brief One-pole low-pass, run over the samples in order.
+///
+/// Each sample depends on the previous output, so unlike the other
+/// filters this one can't be vectorized.  The state carries over from
+/// cycle to cycle, starting from the first sample seen.
+static double lcec_ain_iir(lcec_class_ain_oversampling_t *os) {
+  const int32_t *samples = os->samples;
+  double alpha = os->alpha, keep = 1.0 - alpha, y = os->primed ? os->state : samples[0];
+
+  // `keep * y + alpha * s` rather than `y + alpha * (s - y)`: the
+  // second product doesn't wait for the previous output
+  for (int k = 0; k < os->count; k++) {
+    y = keep * y + alpha * samples[k];
+  }
+  os->state = y;
+  os->primed = 1;
+  return y;
+}
+
+/// @brief Read a channel's samples and reduce them to one raw value.
+///
+/// Also updates the `-sample-K` pins, if the channel has them.
+///
+/// @param os The channel's oversampling state.
+/// @param pd The slave's process data.
+/// @param sign 0x8000 for signed samples, 0 for unsigned ones.
+/// @return The filtered value, in raw units.
+double lcec_ain_oversample(lcec_class_ain_oversampling_t *os, const uint8_t *pd, int32_t sign) {
+  double value;
+
+  lcec_ain_gather(os, pd, sign);
+
+  switch (os->filter) {
+    case LCEC_AIN_FILTER_MIN:
+      value = lcec_ain_min(os->samples, os->padded);
+      break;
+    case LCEC_AIN_FILTER_MAX:
+      value = lcec_ain_max(os->samples, os->padded);
+      break;
+    case LCEC_AIN_FILTER_FIR:
+      value = lcec_ain_dot(os->samples, os->weights, os->padded) * (1.0 / (1 << 15));
+      break;
+    case LCEC_AIN_FILTER_IIR:
+      value = lcec_ain_iir(os);
+      break;
+    default:
+      value = (double)lcec_ain_sum(os->samples, os->padded) / os->count;
+      break;
+  }
+
+  if (os->sample_pins != NULL) {
+    for (int k = 0; k < os->count; k++) {
+      *(os->sample_pins[k]) = os->samples[k];
+    }
+  }
+  return value;
+}
+
+/// @brief Round a filtered value for the `raw` pin.
+static inline int32_t lcec_ain_round(double value) { return (int32_t)((value < 0) ? value - 0.5 : value + 0.5); }
+
 /// @brief Reads data from a single analog in port.
 ///
 /// @param slave The `slave`, passed from the per-device `_read`.
@@ -229,8 +480,9 @@ lcec_class_ain_channel_t *lcec_ain_register_channel(lcec_slave_t *slave, int id,
 /// Call this once per channel registered, from inside of your device's
 /// read function.  Use `lcec_ain_read_all` to read all pins.
 void lcec_ain_read(lcec_slave_t *slave, lcec_class_ain_channel_t *data) {
-  uint8_t *pd = slave->master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int value;  // Needs to be large enough to hold either a uint16_t or an sint16_t without loss.
+  double filtered;
   int max_value = data->options->max_value;
 
   // Update status bits, if enabled
@@ -246,35 +498,207 @@ void lcec_ain_read(lcec_slave_t *slave, lcec_class_ain_channel_t *data) {
   }
 
   // update value
-  if (data->is_unsigned) {
-    value = EC_READ_U16(&pd[data->val_pdo_os]);
+  if (data->oversampling != NULL) {
+    filtered = lcec_ain_oversample(data->oversampling, pd, data->is_unsigned ? 0 : 0x8000);
+    value = lcec_ain_round(filtered);
   } else {
-    value = EC_READ_S16(&pd[data->val_pdo_os]);
+    if (data->is_unsigned) {
+      value = EC_READ_U16(&pd[data->val_pdo_os]);
+    } else {
+      value = EC_READ_S16(&pd[data->val_pdo_os]);
+    }
+    filtered = value;
   }
   *(data->raw_val) = value;
   if (data->options->is_temperature) {
     // Temperature uses different value calculations than regular analog sensors.
-    *(data->val) = *(data->scale) * (double)value;
+    *(data->val) = *(data->scale) * filtered;
   } else {
     // Normal analog sensors return a value between -1.0 and 1.0 (or 0
     // and 1.0, depending on the sensor type), where 1.0 is the
     // largest possible input value.
     //
     // Then, the result is multipled by `scale` (default: 1.0) and `bias` is added (default 0).
-    *(data->val) = *(data->bias) + *(data->scale) * (double)value * ((double)1 / (double)max_value);
+    *(data->val) = *(data->bias) + *(data->scale) * filtered * ((double)1 / (double)max_value);
+  }
+}
+
+/// @brief Absolute bit position of a status bit in the process data.
+static inline unsigned int lcec_ain_bit(unsigned int os, unsigned int bp) { return (os << 3) + bp; }
+
+/// @brief Set up the struct-of-arrays copy of the channels.
+///
+/// If a channel's status bits don't all fit in one 8-byte word, the
+/// channels stay on the one-by-one path.  Either way, each oversampled
+/// channel learns whether its samples can be decoded in one pass.
+///
+/// @param slave The slave, passed from the per-device `_post_reg`.
+/// @param channels An `lcec_class_ain_channels_t *`, as returned by `lcec_ain_allocate_channels()`.
+void lcec_ain_plan(lcec_slave_t *slave, lcec_class_ain_channels_t *channels) {
+  int n = 0;
+
+  for (int i = 0; i < channels->count; i++) {
+    lcec_class_ain_channel_t *channel = channels->channels[i];
+    lcec_class_ain_oversampling_t *os = (channel != NULL) ? channel->oversampling : NULL;
+
+    if (os != NULL) {
+      os->contiguous = 1;
+      for (int k = 1; k < os->count; k++) {
+        os->contiguous &= (os->sample_os[k] == os->sample_os[0] + 2 * k);
+      }
+      channel->val_pdo_os = os->sample_os[0];
+    }
+  }
+
+  channels->has_status = 0;
+  channels->has_sync = 0;
+  for (int i = 0; i < channels->count; i++) {
+    lcec_class_ain_channel_t *channel = channels->channels[i];
+    lcec_class_ain_options_t *opt;
+    lcec_class_ain_batch_t *batch;
+    unsigned int first = ~0u, last = 0;
+
+    if (channel == NULL) {
+      continue;
+    }
+    opt = channel->options;
+
+    // find the word holding the status bits
+    if (!opt->valueonly) {
+      unsigned int bits[3] = {lcec_ain_bit(channel->ovr_pdo_os, channel->ovr_pdo_bp),
+          lcec_ain_bit(channel->udr_pdo_os, channel->udr_pdo_bp), lcec_ain_bit(channel->error_pdo_os, channel->error_pdo_bp)};
+      for (int b = 0; b < 3; b++) {
+        first = (bits[b] < first) ? bits[b] : first;
+        last = (bits[b] > last) ? bits[b] : last;
+      }
+    }
+    if (opt->has_sync) {
+      unsigned int bit = lcec_ain_bit(channel->sync_err_pdo_os, channel->sync_err_pdo_bp);
+      first = (bit < first) ? bit : first;
+      last = (bit > last) ? bit : last;
+    }
+    if (first == ~0u) {
+      first = last = channel->val_pdo_os << 3;
+    }
+    channels->has_status |= !opt->valueonly;
+    channels->has_sync |= opt->has_sync;
+    if ((last >> 3) - (first >> 3) >= 8) {
+      channels->batched = 0;
+      return;
+    }
+
+    batch = &channels->batch[n];
+    batch->val_os = channel->val_pdo_os;
+    batch->status_os = first >> 3;
+    batch->sign = channel->is_unsigned ? 0 : 0x8000;
+    batch->ovr = opt->valueonly ? &channels->sink : channel->overrange;
+    batch->udr = opt->valueonly ? &channels->sink : channel->underrange;
+    batch->error = opt->valueonly ? &channels->sink : channel->error;
+    batch->sync_err = opt->has_sync ? channel->sync_err : &channels->sink;
+    batch->ovr_bit = opt->valueonly ? 0 : lcec_ain_bit(channel->ovr_pdo_os, channel->ovr_pdo_bp) - (first & ~7u);
+    batch->udr_bit = opt->valueonly ? 0 : lcec_ain_bit(channel->udr_pdo_os, channel->udr_pdo_bp) - (first & ~7u);
+    batch->error_bit = opt->valueonly ? 0 : lcec_ain_bit(channel->error_pdo_os, channel->error_pdo_bp) - (first & ~7u);
+    batch->sync_err_bit = opt->has_sync ? lcec_ain_bit(channel->sync_err_pdo_os, channel->sync_err_pdo_bp) - (first & ~7u) : 0;
+    batch->raw_val = channel->raw_val;
+    batch->val = channel->val;
+    batch->scale = channel->scale;
+    batch->bias = (channel->bias != NULL) ? channel->bias : &channels->zero;
+    batch->oversampling = channel->oversampling;
+    // temperatures are scaled raw values, everything else is scaled relative to max_value
+    channels->recip[n] = opt->is_temperature ? 1.0 : (double)1 / (double)opt->max_value;
+    channels->scale[n] = *(channel->scale);
+    channels->factor[n] = channels->scale[n] * channels->recip[n];
+    n++;
   }
+
+  channels->batch_count = n;
+  channels->batched = 1;
 }
 
 /// @brief Reads data from all analog in ports.
 ///
+/// One pass gathers the status bits, the raw or oversampled values and
+/// the pins, then the conversion runs as a plain multiply-add loop over
+/// the struct-of-arrays copies, which the compiler can vectorize.  The
+/// `scale * 1/max_value` factor is only recomputed when a `scale` pin
+/// changes.
+///
 /// @param slave The `slave`, passed from the per-device `_read`.
 /// @param channels An `lcec_class_ain_channel_t *`, as returned by lcec_ain_register_channel.
 void lcec_ain_read_all(lcec_slave_t *slave, lcec_class_ain_channels_t *channels) {
-  for (int i = 0; i < channels->count; i++) {
-    lcec_class_ain_channel_t *channel = channels->channels[i];
+  uint8_t *pd = slave->sync_unit->process_data;
+  unsigned int len = slave->sync_unit->process_data_len;
+  const lcec_class_ain_batch_t *batch;
+  double *restrict raw, *restrict bias, *restrict val, *restrict factor, *restrict scales;
+  const double *recip;
+  int n, has_status, has_sync;
+
+  if (!channels->batched) {
+    for (int i = 0; i < channels->count; i++) {
+      lcec_class_ain_channel_t *channel = channels->channels[i];
+
+      if (channel != NULL) {
+        lcec_ain_read(slave, channel);
+      }
+    }
+    return;
+  }
 
-    if (channel != NULL) {
-      lcec_ain_read(slave, channel);
+  // Pin stores may alias anything, so everything the loops need is
+  // loaded into locals first.
+  n = channels->batch_count;
+  batch = channels->batch;
+  raw = channels->raw;
+  bias = channels->bias;
+  val = channels->val;
+  factor = channels->factor;
+  scales = channels->scale;
+  has_status = channels->has_status;
+  has_sync = channels->has_sync;
+  recip = channels->recip;
+
+  // status bits from one word load per channel, raw values, and the
+  // pins feeding the conversion
+  for (int i = 0; i < n; i++) {
+    const lcec_class_ain_batch_t *b = &batch[i];
+    hal_bit_t *ovr = b->ovr, *udr = b->udr, *error = b->error, *sync_err = b->sync_err;
+    hal_s32_t *raw_val = b->raw_val;
+    uint8_t ovr_bit = b->ovr_bit, udr_bit = b->udr_bit, error_bit = b->error_bit, sync_err_bit = b->sync_err_bit;
+    uint64_t word = lcec_pd_read_window(pd, b->status_os, len);
+    // sign-extended without a branch
+    int32_t value = (int32_t)(EC_READ_U16(&pd[b->val_os]) ^ b->sign) - b->sign;
+    double filtered = value;
+    hal_float_t scale;
+
+    if (b->oversampling != NULL) {
+      filtered = lcec_ain_oversample(b->oversampling, pd, b->sign);
+      value = lcec_ain_round(filtered);
+    }
+    scale = *(b->scale);
+    bias[i] = *(b->bias);
+    raw[i] = filtered;
+    if (scale != scales[i]) {
+      scales[i] = scale;
+      factor[i] = scale * recip[i];
     }
+    *raw_val = value;
+    if (has_status) {
+      *ovr = (word >> ovr_bit) & 1;
+      *udr = (word >> udr_bit) & 1;
+      *error = (word >> error_bit) & 1;
+    }
+    if (has_sync) {
+      *sync_err = (word >> sync_err_bit) & 1;
+    }
+  }
+
+  for (int i = 0; i < n; i++) {
+    val[i] = bias[i] + factor[i] * raw[i];
+  }
+
+  for (int i = 0; i < n; i++) {
+    hal_float_t *val_pin = batch[i].val;
+
+    *val_pin = val[i];
   }
 }
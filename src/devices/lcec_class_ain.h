@@ -21,6 +21,15 @@
 
 #include "../lcec.h"
 
+#define LCEC_AIN_MAX_OVERSAMPLING 100  ///< Most samples per cycle a channel can map.
+#define LCEC_AIN_LANES            8    ///< Samples reduced side by side; sample buffers are padded to a multiple of this.
+
+#define LCEC_AIN_FILTER_MEAN 0  ///< Oversampling filter: average of the cycle's samples.
+#define LCEC_AIN_FILTER_MIN  1  ///< Oversampling filter: smallest of the cycle's samples.
+#define LCEC_AIN_FILTER_MAX  2  ///< Oversampling filter: largest of the cycle's samples.
+#define LCEC_AIN_FILTER_FIR  3  ///< Oversampling filter: triangular-window FIR low-pass over the cycle's samples.
+#define LCEC_AIN_FILTER_IIR  4  ///< Oversampling filter: one-pole IIR low-pass running at the sample rate.
+
 typedef struct {
   const char *name_prefix;         ///< Prefix for device naming, defaults to "aio".
   int has_sync;                    ///< Device supports the sync_err PDO.
@@ -36,8 +45,32 @@ typedef struct {
   uint16_t overrange_idx, overrange_sidx;    ///< PDO index/subindex for reading overrange status.
   uint16_t error_idx, error_sidx;            ///< PDO index/subindex for reading error status.
   uint16_t syncerror_idx, syncerror_sidx;    ///< PDO index/subindex for reading sync error status.
+  int oversampling;                          ///< Samples per cycle; 0 or 1 reads a single value.
+  int oversampling_filter;                   ///< How the samples are reduced to `val`, one of `LCEC_AIN_FILTER_*`.
+  int oversampling_pins;                     ///< Also publish every sample on a `-sample-K` pin.
+  uint16_t sample_idx_step;                  ///< PDO index step from one sample to the next, defaults to 0x10.
 } lcec_class_ain_options_t;
 
+/// @brief Oversampling state of a single analog channel.
+///
+/// Sample `k` is read from PDO entry `value_idx + k * sample_idx_step`,
+/// `value_sidx`.  The integer filters reduce `LCEC_AIN_LANES` samples
+/// side by side; the padding after the last sample holds a value that
+/// doesn't change the result.
+typedef struct {
+  int count;                ///< Samples per cycle.
+  int padded;               ///< `count` rounded up to a multiple of `LCEC_AIN_LANES`.
+  int filter;               ///< One of `LCEC_AIN_FILTER_*`.
+  int contiguous;           ///< The samples are consecutive 16-bit words starting at `sample_os[0]`.
+  unsigned int *sample_os;  ///< Byte offset of each sample.
+  int32_t *samples;         ///< This cycle's samples, `padded` long.
+  int32_t *weights;         ///< FIR taps in Q15, summing to 1 << 15, `padded` long.
+  hal_s32_t **sample_pins;  ///< `-sample-K` pins, or NULL.
+  hal_float_t alpha;        ///< `-filter-alpha` param: IIR coefficient per sample.
+  double state;             ///< IIR output after the last sample.
+  int primed;               ///< `state` holds a filtered sample.
+} lcec_class_ain_oversampling_t;
+
 /// @brief Data for a single analog channel.
 typedef struct {
   hal_bit_t *overrange;   ///< Device reading is over-range.
@@ -58,17 +91,61 @@ typedef struct {
   unsigned int sync_err_pdo_bp;
   unsigned int val_pdo_os;
   int is_unsigned;
+  lcec_class_ain_oversampling_t *oversampling;  ///< Oversampling state, or NULL for a single value.
   lcec_class_ain_options_t *options;  ///< The options used to create this device.
 } lcec_class_ain_channel_t;
 
+/// @brief Per-channel pointers and offsets used by `lcec_ain_read_all()`.
+typedef struct {
+  hal_bit_t *ovr;           ///< `overrange` pin, or the channels' `sink`.
+  hal_bit_t *udr;           ///< `underrange` pin, or the channels' `sink`.
+  hal_bit_t *error;         ///< `error` pin, or the channels' `sink`.
+  hal_bit_t *sync_err;      ///< `sync-err` pin, or the channels' `sink`.
+  hal_s32_t *raw_val;       ///< `raw` pin.
+  hal_float_t *val;         ///< `val` pin.
+  hal_float_t *scale;       ///< `scale` pin.
+  hal_float_t *bias;        ///< `bias` pin, or the channels' `zero` for temperature channels.
+  lcec_class_ain_oversampling_t *oversampling;  ///< Oversampling state, or NULL.
+  unsigned int val_os;      ///< Byte offset of the value.
+  unsigned int status_os;   ///< First byte of the word holding the status bits.
+  int32_t sign;             ///< 0x8000 for signed values, 0 for unsigned ones.
+  uint8_t ovr_bit;          ///< Bit of `overrange` within the status word.
+  uint8_t udr_bit;          ///< Bit of `underrange` within the status word.
+  uint8_t error_bit;        ///< Bit of `error` within the status word.
+  uint8_t sync_err_bit;     ///< Bit of `sync_err` within the status word.
+} lcec_class_ain_batch_t;
+
 /// @brief Data for an analog input device.
+///
+/// Besides the channels, this holds what `lcec_ain_read_all()` needs,
+/// set up by `lcec_ain_plan()` once the PDO offsets are known: one
+/// compact `batch` record per non-NULL channel for the pin and process
+/// data accesses, and struct-of-arrays copies of the numbers for the
+/// conversion itself.
 typedef struct {
   int count;                            ///< The number of channels in use with this device.
   lcec_class_ain_channel_t **channels;  ///< Dynamic array holding pin data for each channel.
+  int batched;                          ///< All channels fit the batched path; else they're read one by one.
+  int batch_count;                      ///< Number of entries in the arrays below.
+  int has_status;                       ///< At least one channel has overrange/underrange/error bits.
+  int has_sync;                         ///< At least one channel has a sync error bit.
+  lcec_class_ain_batch_t *batch;        ///< Pins and offsets of each channel.
+  double *recip;                        ///< `1 / max_value`, or 1 for temperature channels.
+  double *scale;                        ///< `scale` as of the last time `factor` was computed.
+  double *factor;                       ///< `scale * recip`.
+  double *bias;                         ///< This cycle's `bias`.
+  double *raw;                          ///< This cycle's raw values.
+  double *val;                          ///< This cycle's converted values.
+  hal_bit_t sink;                       ///< Target for status bits a channel doesn't have.
+  hal_float_t zero;                     ///< Bias of channels without a `bias` pin.
 } lcec_class_ain_channels_t;
 
 lcec_class_ain_channels_t *lcec_ain_allocate_channels(int count);
 lcec_class_ain_channel_t *lcec_ain_register_channel(struct lcec_slave *slave, int id, uint16_t idx, lcec_class_ain_options_t *opt);
 void lcec_ain_read(struct lcec_slave *slave, lcec_class_ain_channel_t *data);
 void lcec_ain_read_all(struct lcec_slave *slave, lcec_class_ain_channels_t *channels);
+void lcec_ain_plan(struct lcec_slave *slave, lcec_class_ain_channels_t *channels);
 lcec_class_ain_options_t *lcec_ain_options(void);
+double lcec_ain_oversample(lcec_class_ain_oversampling_t *os, const uint8_t *pd, int32_t sign);
+
+extern const lcec_lookuptable_int_t lcec_ain_filters[];
@@ -306,6 +306,90 @@ int lcec_cia402_add_input_sync(lcec_slave_t *slave, lcec_syncs_t *syncs, lcec_cl
   return 0;
 };
 
+/// @brief Signedness bit of a PDO op's kind, from `PDO_SIGN_foo`.
+#define LCEC_CIA402_SIGNED_S 1
+#define LCEC_CIA402_SIGNED_U 0
+
+/// @brief Kind of a PDO op, from its width in bits and signedness.
+#define LCEC_CIA402_OP_KIND(bits, is_signed) \
+  (((bits) == 8 ? LCEC_CIA402_OP_U8 : (bits) == 16 ? LCEC_CIA402_OP_U16 : LCEC_CIA402_OP_U32) + (is_signed))
+
+/// @brief Append a PDO op for a pin and its offset in the process data.
+static void lcec_cia402_add_pdo_op(lcec_class_cia402_pdo_op_t *ops, int *count, volatile void *pin, unsigned int os, int kind) {
+  lcec_class_cia402_pdo_op_t *op = &ops[(*count)++];
+
+  op->pin = (hal_s32_t *)pin;
+  op->os = os;
+  op->kind = kind;
+}
+
+/// @brief Sort PDO ops by kind, and find where each kind ends.
+static void lcec_cia402_sort_pdo_ops(lcec_class_cia402_pdo_op_t *ops, int count, int *ends) {
+  // Insertion sort; there are never more than a couple of dozen ops,
+  // and this keeps objects of the same kind in their usual order.
+  for (int i = 1; i < count; i++) {
+    lcec_class_cia402_pdo_op_t op = ops[i];
+    int j;
+
+    for (j = i; j > 0 && ops[j - 1].kind > op.kind; j--) {
+      ops[j] = ops[j - 1];
+    }
+    ops[j] = op;
+  }
+  for (int kind = 0, i = 0; kind < LCEC_CIA402_OP_KINDS; kind++) {
+    while (i < count && ops[i].kind == kind) i++;
+    ends[kind] = i;
+  }
+}
+
+/// @brief Build the PDO and SDO ops for a channel's enabled objects.
+///
+/// Runs from `lcec_cia402_plan()`, once the PDO offsets are filled in.
+static void lcec_cia402_build_ops(lcec_class_cia402_channel_t *data) {
+  lcec_class_cia402_enabled_t *enabled = data->enabled;
+  int reads = 1, writes = 1, sdos = 0;
+
+#define COUNT_OP(pin_name, counter) \
+  if (enabled->enable_##pin_name) counter++
+#define COUNT_READ_OP(pin_name)  COUNT_OP(pin_name, reads)
+#define COUNT_WRITE_OP(pin_name) COUNT_OP(pin_name, writes)
+#define COUNT_SDO_OP(pin_name)   COUNT_OP(pin_name, sdos)
+
+  FOR_ALL_READ_PDOS_DO(COUNT_READ_OP);
+  FOR_ALL_WRITE_PDOS_DO(COUNT_WRITE_OP);
+  FOR_ALL_WRITE_SDOS_DO(COUNT_SDO_OP);
+
+  data->read_ops = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_cia402_pdo_op_t, reads);
+  data->write_ops = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_cia402_pdo_op_t, writes);
+  data->sdo_ops = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_cia402_sdo_op_t, sdos > 0 ? sdos : 1);
+
+  lcec_cia402_add_pdo_op(data->read_ops, &data->read_op_count, data->statusword, data->statusword_os, LCEC_CIA402_OP_U16);
+  lcec_cia402_add_pdo_op(data->write_ops, &data->write_op_count, data->controlword, data->controlword_os, LCEC_CIA402_OP_U16);
+
+#define ADD_PDO_OP(pin_name, ops, count)                                                \
+  if (enabled->enable_##pin_name)                                                       \
+  lcec_cia402_add_pdo_op(data->ops, &data->count, data->pin_name, data->pin_name##_os, \
+      LCEC_CIA402_OP_KIND(PDO_BITS_##pin_name, SUBSTJOIN2(LCEC_CIA402_SIGNED_, PDO_SIGN_##pin_name)))
+#define ADD_READ_OP(pin_name)  ADD_PDO_OP(pin_name, read_ops, read_op_count)
+#define ADD_WRITE_OP(pin_name) ADD_PDO_OP(pin_name, write_ops, write_op_count)
+
+  FOR_ALL_READ_PDOS_DO(ADD_READ_OP);
+  FOR_ALL_WRITE_PDOS_DO(ADD_WRITE_OP);
+  lcec_cia402_sort_pdo_ops(data->read_ops, data->read_op_count, data->read_op_ends);
+  lcec_cia402_sort_pdo_ops(data->write_ops, data->write_op_count, data->write_op_ends);
+
+#define ADD_SDO_OP(pin_name)                                               \
+  if (enabled->enable_##pin_name) {                                        \
+    lcec_class_cia402_sdo_op_t *op = &data->sdo_ops[data->sdo_op_count++]; \
+    op->pin = (hal_s32_t *)data->pin_name;                                 \
+    op->old = (hal_s32_t *)&data->pin_name##_old;                          \
+    op->entry = data->pin_name##_sdo;                                      \
+    *(op->old) = *(op->pin);                                               \
+  }
+
+  FOR_ALL_WRITE_SDOS_DO(ADD_SDO_OP);
+}
+
 /// @brief Register a new CiA 402 channel.
 ///
 /// This creates a new CiA 402 channel, which is basically a single
@@ -358,14 +442,17 @@ lcec_class_cia402_channel_t *lcec_cia402_register_channel(
   FOR_ALL_READ_PDOS_DO(INIT_OPTIONAL_PDO);
   FOR_ALL_WRITE_PDOS_DO(INIT_OPTIONAL_PDO);
 
-#define INIT_SDO_REQUEST(pin_name) \
-  data->pin_name##_sdorequest =    \
-      ecrt_slave_config_create_sdo_request(slave->config, base_idx + PDO_IDX_OFFSET_##pin_name, PDO_SIDX_##pin_name, PDO_BITS_##pin_name)
+#define INIT_SDO_ENTRY(pin_name)                                                                                          \
+  if (enabled->enable_##pin_name) {                                                                                       \
+    data->pin_name##_sdo = lcec_sdo_sched_add(                                                                            \
+        slave, base_idx + PDO_IDX_OFFSET_##pin_name, PDO_SIDX_##pin_name, PDO_BITS_##pin_name / 8, LCEC_SDO_PRIO_NORMAL); \
+    if (data->pin_name##_sdo == NULL) return NULL;                                                                        \
+  }
 
-  // Call `ecrt_slave_config_create_sdo_request()` for all writable
-  // SDOs, so we're able to write to them after we flip to real-time
-  // mode.
-  FOR_ALL_WRITE_SDOS_DO(INIT_SDO_REQUEST);
+  // Register the enabled writable SDOs with the master's SDO
+  // scheduler, so we're able to write to them after we flip to
+  // real-time mode.
+  FOR_ALL_WRITE_SDOS_DO(INIT_SDO_ENTRY);
 
   // Register pins
   err = lcec_pin_newf_list(data, pins_required, LCEC_MODULE_NAME, slave->master->name, slave->name, name_prefix);
@@ -480,16 +567,21 @@ lcec_class_cia402_channel_t *lcec_cia402_register_channel(
 /// Call this once per channel registered, from inside of your device's
 /// read function.  Use `lcec_cia402_read_all` to read all channels.
 void lcec_cia402_read(lcec_slave_t *slave, lcec_class_cia402_channel_t *data) {
-  uint8_t *pd = slave->master->process_data;
-
-#define READ_OPT(pin_name)              \
-  if (data->enabled->enable_##pin_name) \
-  *(data->pin_name) = (SUBSTJOIN3(EC_READ_, PDO_SIGN_##pin_name, PDO_BITS_##pin_name)(&pd[data->pin_name##_os]))
-
-  *(data->statusword) = EC_READ_U16(&pd[data->statusword_os]);
-
-  // Read from all readable PDOs.
-  FOR_ALL_READ_PDOS_DO(READ_OPT);
+  uint8_t *pd = slave->sync_unit->process_data;
+  const lcec_class_cia402_pdo_op_t *op = data->read_ops, *end;
+
+  // One loop per kind of entry, so each copy is a single load of the
+  // right width.
+#define READ_OPS(kind, read_fn)                                         \
+  for (end = data->read_ops + data->read_op_ends[kind]; op < end; op++) \
+  *(op->pin) = read_fn(&pd[op->os])
+
+  READ_OPS(LCEC_CIA402_OP_U8, EC_READ_U8);
+  READ_OPS(LCEC_CIA402_OP_S8, EC_READ_S8);
+  READ_OPS(LCEC_CIA402_OP_U16, EC_READ_U16);
+  READ_OPS(LCEC_CIA402_OP_S16, EC_READ_S16);
+  READ_OPS(LCEC_CIA402_OP_U32, EC_READ_U32);
+  READ_OPS(LCEC_CIA402_OP_S32, EC_READ_S32);
 
   if (data->enabled->enable_digital_input) {
     lcec_din_read_all(slave, data->din);
@@ -506,48 +598,30 @@ void lcec_cia402_read_all(lcec_slave_t *slave, lcec_class_cia402_channels_t *cha
   }
 }
 
-#define WRITE_OPT(name) \
-  if (data->enabled->enable_##name) SUBSTJOIN3(EC_WRITE_, PDO_SIGN_##name, PDO_BITS_##name)(&pd[data->name##_os], *(data->name))
-
-/// OK, this is kind of a mess.  It presents the same interface as
-/// WRITE_OPT(), but instead of writing to a mapped PDO entry, it
-/// writes to an SDO.  Unfortunately, Etherlab's EtherCAT library
-/// doesn't make this entirely trivial.  We have to have allocated an
-/// SDO request before real-time mode started (which we did, it's
-/// stored in `name##_sdorequest`).  Then we need to do 3 things:
-///
-/// 1. Make sure that another write isn't in progress for this SDO.
-///    To do this, we need to check `ecrt_sdo_request_state()` and make
-///    sure that it's not EC_REQUEST_BUSY.
-/// 2. Next, we need to write the data into the request struct, using
-///    `ecrt_sdo_request_data()` and one of the
-///    `EC_WRITE_*()`. macros.
-/// 3. Finally, we call `ecrt_sdo_request_write()` to start a write.
-///    It may not finish for a while.
-#define WRITE_OPT_SDO(name)                                                                   \
-  do {                                                                                        \
-    if (data->enabled->enable_##name) {                                                       \
-      if (*(data->name) != data->name##_old) {                                                \
-        if (ecrt_sdo_request_state(data->name##_sdorequest) != EC_REQUEST_BUSY) {             \
-          data->name##_old = *(data->name);                                                   \
-          uint8_t *sdo_tmp = ecrt_sdo_request_data(data->name##_sdorequest);                  \
-          SUBSTJOIN3(EC_WRITE_, PDO_SIGN_##name, PDO_BITS_##name)(sdo_tmp, data->name##_old); \
-          ecrt_sdo_request_write(data->name##_sdorequest);                                    \
-        }                                                                                     \
-      }                                                                                       \
-    }                                                                                         \
-  } while (0)
-
 void lcec_cia402_write(lcec_slave_t *slave, lcec_class_cia402_channel_t *data) {
-  uint8_t *pd = slave->master->process_data;
-
-  EC_WRITE_U16(&pd[data->controlword_os], (uint16_t)(*(data->controlword)));
-
-  // Write PDOs (mapped, auto-synced between slaves and the master)
-  FOR_ALL_WRITE_PDOS_DO(WRITE_OPT);
-
-  // Write SDOs (*not* mapped, written on demand, slower)
-  FOR_ALL_WRITE_SDOS_DO(WRITE_OPT_SDO);
+  uint8_t *pd = slave->sync_unit->process_data;
+  const lcec_class_cia402_pdo_op_t *op = data->write_ops, *end;
+  const lcec_class_cia402_sdo_op_t *sdo, *sdo_end;
+
+  // Write PDOs (mapped, auto-synced between slaves and the master).
+  // Signed and unsigned entries of the same width are stored alike.
+#define WRITE_OPS(kind, write_fn)                                         \
+  for (end = data->write_ops + data->write_op_ends[kind]; op < end; op++) \
+  write_fn(&pd[op->os], *(op->pin))
+
+  WRITE_OPS(LCEC_CIA402_OP_S8, EC_WRITE_U8);
+  WRITE_OPS(LCEC_CIA402_OP_S16, EC_WRITE_U16);
+  WRITE_OPS(LCEC_CIA402_OP_S32, EC_WRITE_U32);
+
+  // Write SDOs (*not* mapped, written on demand, slower).  The
+  // master's SDO scheduler queues the change, and coalesces it with
+  // later ones if the mailbox is busy.
+  for (sdo = data->sdo_ops, sdo_end = sdo + data->sdo_op_count; sdo < sdo_end; sdo++) {
+    if (*(sdo->pin) != *(sdo->old)) {
+      *(sdo->old) = *(sdo->pin);
+      lcec_sdo_sched_write(sdo->entry, (uint32_t)*(sdo->old));
+    }
+  }
 
   if (data->enabled->enable_digital_output) {
     lcec_dout_write_all(slave, data->dout);
@@ -564,6 +638,37 @@ void lcec_cia402_write_all(lcec_slave_t *slave, lcec_class_cia402_channels_t *ch
   }
 }
 
+/// @brief Sets up the cyclic access of a single CiA 402 channel.
+///
+/// Call this once per channel registered, from inside of your device's
+/// post-registration function.  Use `lcec_cia402_plan_all` for all
+/// channels.
+///
+/// @param slave The `slave`, passed from the per-device `_post_reg`.
+/// @param data  Which channel to set up; a `lcec_class_cia402_channel_t *`, as returned by lcec_cia402_register_channel.
+void lcec_cia402_plan(lcec_slave_t *slave, lcec_class_cia402_channel_t *data) {
+  // Compile the per-cycle copies, so `_read` and `_write` don't have
+  // to check every optional object.
+  lcec_cia402_build_ops(data);
+
+  if (data->enabled->enable_digital_input) {
+    lcec_din_plan(slave, data->din);
+  }
+  if (data->enabled->enable_digital_output) {
+    lcec_dout_plan(slave, data->dout);
+  }
+}
+
+/// @brief Sets up the cyclic access of all CiA 402 channels.
+///
+/// @param slave The `slave`, passed from the per-device `_post_reg`.
+/// @param channels An `lcec_class_cia402_channel_t *`, as returned by lcec_cia402_register_channel.
+void lcec_cia402_plan_all(lcec_slave_t *slave, lcec_class_cia402_channels_t *channels) {
+  for (int i = 0; i < channels->count; i++) {
+    lcec_cia402_plan(slave, channels->channels[i]);
+  }
+}
+
 #define ENABLE_MODPARAM(name) {PDO_MP_NAME_##name, CIA402_MP_ENABLE_##name, MODPARAM_TYPE_BIT},
 
 /// @brief Modparams settings available via XML.
@@ -204,6 +204,31 @@ typedef struct {
   int enable_vl_minimum;
 } lcec_class_cia402_enabled_t;
 
+#define LCEC_CIA402_OP_U8    0  ///< `lcec_class_cia402_pdo_op_t` kind: unsigned 8-bit entry.
+#define LCEC_CIA402_OP_S8    1  ///< `lcec_class_cia402_pdo_op_t` kind: signed 8-bit entry.
+#define LCEC_CIA402_OP_U16   2  ///< `lcec_class_cia402_pdo_op_t` kind: unsigned 16-bit entry.
+#define LCEC_CIA402_OP_S16   3  ///< `lcec_class_cia402_pdo_op_t` kind: signed 16-bit entry.
+#define LCEC_CIA402_OP_U32   4  ///< `lcec_class_cia402_pdo_op_t` kind: unsigned 32-bit entry.
+#define LCEC_CIA402_OP_S32   5  ///< `lcec_class_cia402_pdo_op_t` kind: signed 32-bit entry.
+#define LCEC_CIA402_OP_KINDS 6
+
+/// @brief One PDO entry copied by `lcec_cia402_read()` or `lcec_cia402_write()`.
+///
+/// `lcec_cia402_plan()` builds these for the enabled objects only,
+/// sorted by `kind`, so each kind is copied by its own loop.
+typedef struct {
+  hal_s32_t *pin;   ///< The pin; `hal_u32_t` pins are accessed through the same pointer.
+  unsigned int os;  ///< Byte offset in the process data.
+  int kind;         ///< Width and sign of the entry, `LCEC_CIA402_OP_*`.
+} lcec_class_cia402_pdo_op_t;
+
+/// @brief One SDO-backed pin checked by `lcec_cia402_write()`.
+typedef struct {
+  hal_s32_t *pin;           ///< The pin; `hal_u32_t` pins are accessed through the same pointer.
+  hal_s32_t *old;           ///< The value last handed to the SDO scheduler.
+  lcec_sdo_entry_t *entry;  ///< The object's SDO scheduler entry.
+} lcec_class_cia402_sdo_op_t;
+
 typedef struct {
 #define PDO_PIN(name, pin_type) \
   pin_type *name;               \
@@ -213,7 +238,7 @@ typedef struct {
 #define SDO_PIN(name, pin_type) \
   pin_type *name;               \
   pin_type name##_old;          \
-  ec_sdo_request_t *name##_sdorequest;
+  lcec_sdo_entry_t *name##_sdo;
 
   // Out
   PDO_PIN(controlword, hal_u32_t);
@@ -287,6 +312,15 @@ typedef struct {
 
   lcec_class_cia402_channel_options_t *options;  ///< The options used to create this device.
   lcec_class_cia402_enabled_t *enabled;
+
+  int read_op_count;                            ///< Number of entries in `read_ops`.
+  int write_op_count;                           ///< Number of entries in `write_ops`.
+  int sdo_op_count;                             ///< Number of entries in `sdo_ops`.
+  int read_op_ends[LCEC_CIA402_OP_KINDS];       ///< Index in `read_ops` past the last op of each kind.
+  int write_op_ends[LCEC_CIA402_OP_KINDS];      ///< Index in `write_ops` past the last op of each kind.
+  lcec_class_cia402_pdo_op_t *read_ops;         ///< The statusword and enabled input PDO entries.
+  lcec_class_cia402_pdo_op_t *write_ops;        ///< The controlword and enabled output PDO entries.
+  lcec_class_cia402_sdo_op_t *sdo_ops;          ///< The enabled SDO-backed pins.
 } lcec_class_cia402_channel_t;
 
 typedef struct {
@@ -306,6 +340,8 @@ void lcec_cia402_read(struct lcec_slave *slave, lcec_class_cia402_channel_t *dat
 void lcec_cia402_read_all(struct lcec_slave *slave, lcec_class_cia402_channels_t *channels);
 void lcec_cia402_write(struct lcec_slave *slave, lcec_class_cia402_channel_t *data);
 void lcec_cia402_write_all(struct lcec_slave *slave, lcec_class_cia402_channels_t *channels);
+void lcec_cia402_plan(struct lcec_slave *slave, lcec_class_cia402_channel_t *data);
+void lcec_cia402_plan_all(struct lcec_slave *slave, lcec_class_cia402_channels_t *channels);
 lcec_class_cia402_options_t *lcec_cia402_options(void);
 lcec_class_cia402_channel_options_t *lcec_cia402_channel_options(void);
 void lcec_cia402_rename_multiaxis_channels(lcec_class_cia402_options_t *opt);
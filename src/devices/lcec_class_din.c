@@ -41,6 +41,8 @@ lcec_class_din_channels_t *lcec_din_allocate_channels(int count) {
   channels = LCEC_HAL_ALLOCATE(lcec_class_din_channels_t);
   channels->count = count;
   channels->channels = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_din_channel_t *, count);
+  channels->groups = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_din_group_t, count);
+  channels->bits = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_din_bit_t, count);
 
   return channels;
 }
@@ -136,8 +138,7 @@ lcec_class_din_channel_t *lcec_din_register_channel_packed(lcec_slave_t *slave,
 /// Call this once per pin registered, from inside of your device's
 /// read function.  See `lcec_din_read_all` for an alternative approach.
 void lcec_din_read(lcec_slave_t *slave, lcec_class_din_channel_t *data) {
-  lcec_master_t *master = slave->master;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   hal_bit_t s;
   int os = data->pdo_os;
   int bp = data->pdo_bp;
@@ -157,14 +158,62 @@ void lcec_din_read(lcec_slave_t *slave, lcec_class_din_channel_t *data) {
   *(data->in_not) = !s;
 }
 
-/// @brief reads data from all digital in ports.
+/// @brief Group the channels by the 8-byte word they're in.
 ///
-/// @param slave The slave, passed from the per-device `_read`.
+/// Consecutive channels within 8 bytes of the first one's byte share a
+/// group, so the 8 or 16 channels of a typical terminal are one group.
+///
+/// @param slave The slave, passed from the per-device `_post_reg`.
 /// @param channels An `lcec_class_din_channels_t *`, as returned by `lcec_din_allocate_channels()`.
-void lcec_din_read_all(lcec_slave_t *slave, lcec_class_din_channels_t *channels) {
+void lcec_din_plan(lcec_slave_t *slave, lcec_class_din_channels_t *channels) {
+  lcec_class_din_group_t *group = NULL;
+  lcec_class_din_bit_t *bit = channels->bits;
+
+  channels->group_count = 0;
   for (int i = 0; i < channels->count; i++) {
     lcec_class_din_channel_t *channel = channels->channels[i];
+    unsigned int pos;
+
+    if (channel == NULL) {
+      continue;
+    }
+
+    // absolute bit position, see lcec_din_read() for packed channels
+    pos = (channel->pdo_os << 3) + ((channel->pdo_bp_packed != 0xffff) ? channel->pdo_bp_packed : channel->pdo_bp);
+    if (group == NULL || (pos >> 3) < group->os || (pos >> 3) >= group->os + 8) {
+      group = &channels->groups[channels->group_count++];
+      group->os = pos >> 3;
+      group->first = bit - channels->bits;
+      group->count = 0;
+    }
+    bit->in = channel->in;
+    bit->in_not = channel->in_not;
+    bit->bit = pos - (group->os << 3);
+    group->count++;
+    bit++;
+  }
+}
 
-    if (channel != NULL) lcec_din_read(slave, channel);
+/// @brief reads data from all digital in ports.
+///
+/// Each group of channels sharing a word is read with one load, and
+/// its bits are scattered to the channels' pins.
+///
+/// @param slave The slave, passed from the per-device `_read`.
+/// @param channels An `lcec_class_din_channels_t *`, as returned by `lcec_din_allocate_channels()`.
+void lcec_din_read_all(lcec_slave_t *slave, lcec_class_din_channels_t *channels) {
+  uint8_t *pd = slave->sync_unit->process_data;
+  unsigned int len = slave->sync_unit->process_data_len;
+
+  for (int g = 0; g < channels->group_count; g++) {
+    const lcec_class_din_group_t *group = &channels->groups[g];
+    const lcec_class_din_bit_t *bit = &channels->bits[group->first];
+    uint64_t raw = lcec_pd_read_window(pd, group->os, len);
+
+    for (int i = 0; i < group->count; i++, bit++) {
+      hal_bit_t s = (raw >> bit->bit) & 1;
+      *(bit->in) = s;
+      *(bit->in_not) = !s;
+    }
   }
 }
@@ -32,9 +32,26 @@ typedef struct {
   unsigned int pdo_bp_packed;  ///< This bit's bit position in the master's PDO data structure, for packed din.
 } lcec_class_din_channel_t;
 
+/// @brief One channel's place in a `lcec_class_din_group_t`.
+typedef struct {
+  hal_bit_t *in;      ///< Copy of the channel's `in` pin pointer.
+  hal_bit_t *in_not;  ///< Copy of the channel's `in_not` pin pointer.
+  unsigned int bit;   ///< The channel's bit within the group's word.
+} lcec_class_din_bit_t;
+
+/// @brief Channels read together with a single load of up to 8 bytes.
+typedef struct {
+  unsigned int os;  ///< Process data byte where the group's word starts.
+  int first;        ///< Index of the group's first entry in `bits`.
+  int count;        ///< Number of entries in the group.
+} lcec_class_din_group_t;
+
 typedef struct {
   int count;                            ///< The number of channels described by this structure.
   lcec_class_din_channel_t **channels;  ///< a dynamic array of `lcec_class_din_channel_t` channels.
+  int group_count;                      ///< Number of entries in `groups`.
+  lcec_class_din_group_t *groups;       ///< Channels sharing a word, set up by `lcec_din_plan()`.
+  lcec_class_din_bit_t *bits;           ///< Per-channel entries of all groups, in group order.
 } lcec_class_din_channels_t;
 
 lcec_class_din_channels_t *lcec_din_allocate_channels(int count);
@@ -44,4 +61,5 @@ lcec_class_din_channel_t *lcec_din_register_channel_packed(struct lcec_slave *sl
 
 void lcec_din_read(struct lcec_slave *slave, lcec_class_din_channel_t *data);
 void lcec_din_read_all(struct lcec_slave *slave, lcec_class_din_channels_t *channels);
+void lcec_din_plan(struct lcec_slave *slave, lcec_class_din_channels_t *channels);
 #endif
@@ -51,6 +51,8 @@ lcec_class_dout_channels_t *lcec_dout_allocate_channels(int count) {
   }
   channels->count = count;
   channels->channels = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_dout_channel_t *, count);
+  channels->groups = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_dout_group_t, count);
+  channels->bits = LCEC_HAL_ALLOCATE_ARRAY(lcec_class_dout_bit_t, count);
 
   return channels;
 }
@@ -147,8 +149,7 @@ lcec_class_dout_channel_t *lcec_dout_register_channel_packed(lcec_slave_t *slave
 /// @param slave The slave, passed from the per-device `_write`.
 /// @param data A lcec_class_dout_channel_t *, as returned by lcec_dout_register_channel.
 void lcec_dout_write(lcec_slave_t *slave, lcec_class_dout_channel_t *data) {
-  lcec_master_t *master = slave->master;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   hal_bit_t s;
   int os = data->pdo_os;
   int bp = data->pdo_bp;
@@ -169,15 +170,65 @@ void lcec_dout_write(lcec_slave_t *slave, lcec_class_dout_channel_t *data) {
   EC_WRITE_BIT(&pd[os], bp, s);
 }
 
+/// @brief Group the channels by the 8-byte word they're in.
+///
+/// Same grouping as `lcec_din_plan()`; each group also gets the mask
+/// of the bits its channels own, so writing it leaves the other bits
+/// of the word alone.
+///
+/// @param slave The slave, passed from the per-device `_post_reg`.
+/// @param channels A `lcec_class_dout_channels_t *`, as returned by `lcec_dout_allocate_channels()`.
+void lcec_dout_plan(lcec_slave_t *slave, lcec_class_dout_channels_t *channels) {
+  lcec_class_dout_group_t *group = NULL;
+  lcec_class_dout_bit_t *bit = channels->bits;
+
+  channels->group_count = 0;
+  for (int i = 0; i < channels->count; i++) {
+    lcec_class_dout_channel_t *channel = channels->channels[i];
+    unsigned int pos;
+
+    if (channel == NULL) {
+      continue;
+    }
+
+    // absolute bit position, see lcec_dout_write() for packed channels
+    pos = (channel->pdo_os << 3) + ((channel->pdo_bp_packed != 0xffff) ? channel->pdo_bp_packed : channel->pdo_bp);
+    if (group == NULL || (pos >> 3) < group->os || (pos >> 3) >= group->os + 8) {
+      group = &channels->groups[channels->group_count++];
+      group->os = pos >> 3;
+      group->mask = 0;
+      group->first = bit - channels->bits;
+      group->count = 0;
+    }
+    bit->out = channel->out;
+    bit->invert = &channel->invert;
+    bit->bit = pos - (group->os << 3);
+    group->mask |= 1ULL << bit->bit;
+    group->count++;
+    bit++;
+  }
+}
+
 /// @brief Write data to all digital out channels attached to this device.
 ///
+/// The bits of each group of channels sharing a word are gathered and
+/// stored with one read-modify-write.
+///
 /// @param slave The slave, passed from the per-device `_write`.
 /// @param channels A `lcec_class_dout_channels_t *`, as returned by
 /// `lcec_dout_register_channel`.
 void lcec_dout_write_all(lcec_slave_t *slave, lcec_class_dout_channels_t *channels) {
-  for (int i = 0; i < channels->count; i++) {
-    lcec_class_dout_channel_t *channel = channels->channels[i];
-
-    if (channel != NULL) lcec_dout_write(slave, channel);
+  uint8_t *pd = slave->sync_unit->process_data;
+  unsigned int len = slave->sync_unit->process_data_len;
+
+  for (int g = 0; g < channels->group_count; g++) {
+    const lcec_class_dout_group_t *group = &channels->groups[g];
+    const lcec_class_dout_bit_t *bit = &channels->bits[group->first];
+    uint64_t val = 0;
+
+    for (int i = 0; i < group->count; i++, bit++) {
+      val |= (uint64_t)((*(bit->out) != 0) ^ (*(bit->invert) != 0)) << bit->bit;
+    }
+    lcec_pd_write_window(pd, group->os, len, group->mask, val);
   }
 }
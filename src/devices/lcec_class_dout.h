@@ -32,9 +32,27 @@ typedef struct {
   unsigned int pdo_bp_packed;  ///< Controls is this is a packed-bit port, where more than one channel is found in a single PDO entry.
 } lcec_class_dout_channel_t;
 
+/// @brief One channel's place in a `lcec_class_dout_group_t`.
+typedef struct {
+  hal_bit_t *out;     ///< Copy of the channel's `out` pin pointer.
+  hal_bit_t *invert;  ///< The channel's `invert` param.
+  unsigned int bit;   ///< The channel's bit within the group's word.
+} lcec_class_dout_bit_t;
+
+/// @brief Channels written together with a single store of up to 8 bytes.
+typedef struct {
+  unsigned int os;  ///< Process data byte where the group's word starts.
+  uint64_t mask;    ///< The bits of the word owned by the group's channels.
+  int first;        ///< Index of the group's first entry in `bits`.
+  int count;        ///< Number of entries in the group.
+} lcec_class_dout_group_t;
+
 typedef struct {
   int count;
   lcec_class_dout_channel_t **channels;
+  int group_count;                  ///< Number of entries in `groups`.
+  lcec_class_dout_group_t *groups;  ///< Channels sharing a word, set up by `lcec_dout_plan()`.
+  lcec_class_dout_bit_t *bits;      ///< Per-channel entries of all groups, in group order.
 } lcec_class_dout_channels_t;
 
 lcec_class_dout_channels_t *lcec_dout_allocate_channels(int count);
@@ -44,5 +62,6 @@ lcec_class_dout_channel_t *lcec_dout_register_channel_packed(
     struct lcec_slave *slave, uint16_t idx, uint16_t sidx, int bit, const char *name);
 void lcec_dout_write(struct lcec_slave *slave, lcec_class_dout_channel_t *data);
 void lcec_dout_write_all(struct lcec_slave *slave, lcec_class_dout_channels_t *pins);
+void lcec_dout_plan(struct lcec_slave *slave, lcec_class_dout_channels_t *channels);
 
 #endif
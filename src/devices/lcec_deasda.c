@@ -215,6 +215,7 @@ static void lcec_deasda_check_scales(lcec_deasda_data_t *hal_data);
 static void lcec_deasda_read(lcec_slave_t *slave, long period);
 static void lcec_deasda_write_csv(lcec_slave_t *slave, long period);
 static void lcec_deasda_write_csp(lcec_slave_t *slave, long period);
+static int lcec_deasda_post_reg(lcec_slave_t *slave);
 
 static const drive_operationmodes_t *drive_opmode(char *drivemode);
 
@@ -297,6 +298,7 @@ static int lcec_deasda_init(int comp_id, lcec_slave_t *slave) {
 
   // initialize callbacks
   slave->proc_read = lcec_deasda_read;
+  slave->proc_post_reg = lcec_deasda_post_reg;
 
   if (operationmode == DEASDA_OPMODE_CSV) {
     slave->proc_write = lcec_deasda_write_csv;
@@ -437,9 +439,8 @@ void lcec_deasda_check_scales(lcec_deasda_data_t *hal_data) {
 }
 
 static void lcec_deasda_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_deasda_data_t *hal_data = (lcec_deasda_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint16_t status;
   uint32_t status_di;
   int32_t speed_raw;
@@ -533,9 +534,8 @@ static void lcec_deasda_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_deasda_write_csv(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_deasda_data_t *hal_data = (lcec_deasda_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint16_t control;
   double speed_raw;
   int switch_on_edge;
@@ -586,9 +586,8 @@ static void lcec_deasda_write_csv(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_deasda_write_csp(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_deasda_data_t *hal_data = (lcec_deasda_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint16_t control;
   int32_t pos_puu;
   int switch_on_edge;
@@ -632,6 +631,13 @@ static void lcec_deasda_write_csp(lcec_slave_t *slave, long period) {
   EC_WRITE_S32(&pd[hal_data->cmdvalue_pdo_os], pos_puu);
 }
 
+static int lcec_deasda_post_reg(lcec_slave_t *slave) {
+  lcec_deasda_data_t *hal_data = (lcec_deasda_data_t *)slave->hal_data;
+
+  if (hal_data->dout) lcec_dout_plan(slave, hal_data->dout);
+  return 0;
+}
+
 // Match the drive mode configuration in modparams and return the settings for that particular operational mode.
 // the value is then used both for setting the mode and to differnetiate between CSV (0) and CSP
 static const drive_operationmodes_t *drive_opmode(char *drivemode) {
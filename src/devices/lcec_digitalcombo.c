@@ -115,6 +115,7 @@ typedef struct {
 
 static void lcec_digitalcombo_read(lcec_slave_t *slave, long period);
 static void lcec_digitalcombo_write(lcec_slave_t *slave, long period);
+static int lcec_digitalcombo_post_reg(lcec_slave_t *slave);
 
 static int lcec_digitalcombo_init(int comp_id, lcec_slave_t *slave) {
   lcec_digitalcombo_data_t *hal_data;
@@ -126,6 +127,7 @@ static int lcec_digitalcombo_init(int comp_id, lcec_slave_t *slave) {
   // initialize callbacks
   if (in_channels > 0) slave->proc_read = lcec_digitalcombo_read;
   if (out_channels > 0) slave->proc_write = lcec_digitalcombo_write;
+  slave->proc_post_reg = lcec_digitalcombo_post_reg;
 
   // alloc hal memory
   hal_data = LCEC_HAL_ALLOCATE(lcec_digitalcombo_data_t);
@@ -191,3 +193,11 @@ static void lcec_digitalcombo_write(lcec_slave_t *slave, long period) {
 
   if (hal_data->channels_out != NULL) lcec_dout_write_all(slave, hal_data->channels_out);
 }
+
+static int lcec_digitalcombo_post_reg(lcec_slave_t *slave) {
+  lcec_digitalcombo_data_t *hal_data = (lcec_digitalcombo_data_t *)slave->hal_data;
+
+  if (hal_data->channels_in != NULL) lcec_din_plan(slave, hal_data->channels_in);
+  if (hal_data->channels_out != NULL) lcec_dout_plan(slave, hal_data->channels_out);
+  return 0;
+}
@@ -45,6 +45,7 @@ ADD_TYPES(types)
 
 static void lcec_easyio_write(lcec_slave_t *slave, long period);
 static void lcec_easyio_read(lcec_slave_t *slave, long period);
+static int lcec_easyio_post_reg(lcec_slave_t *slave);
 
 static int lcec_easyio_init(int comp_id, lcec_slave_t *slave) {
   lcec_easyio_data_t *hal_data;
@@ -57,6 +58,7 @@ static int lcec_easyio_init(int comp_id, lcec_slave_t *slave) {
   // initialize callbacks
   slave->proc_read = lcec_easyio_read;
   slave->proc_write = lcec_easyio_write;
+  slave->proc_post_reg = lcec_easyio_post_reg;
 
   hal_data->digital_in = lcec_din_allocate_channels(16);
   hal_data->digital_out = lcec_dout_allocate_channels(16);
@@ -115,3 +117,12 @@ static void lcec_easyio_read(lcec_slave_t *slave, long period) {
   lcec_din_read_all(slave, hal_data->digital_in);
   lcec_ain_read_all(slave, hal_data->analog_in);
 }
+
+static int lcec_easyio_post_reg(lcec_slave_t *slave) {
+  lcec_easyio_data_t *hal_data = (lcec_easyio_data_t *)slave->hal_data;
+
+  lcec_din_plan(slave, hal_data->digital_in);
+  lcec_dout_plan(slave, hal_data->digital_out);
+  lcec_ain_plan(slave, hal_data->analog_in);
+  return 0;
+}
@@ -129,9 +129,8 @@ static int lcec_el1904_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el1904_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el1904_data_t *hal_data = (lcec_el1904_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_el1904_data_in_t *in;
 
@@ -67,6 +67,7 @@ static lcec_typelist_t types[] = {
 ADD_TYPES(types)
 
 static void lcec_el1xxx_read(lcec_slave_t *slave, long period);
+static int lcec_el1xxx_post_reg(lcec_slave_t *slave);
 
 static int lcec_el1xxx_init(int comp_id, lcec_slave_t *slave) {
   lcec_class_din_channels_t *hal_data;
@@ -76,6 +77,7 @@ static int lcec_el1xxx_init(int comp_id, lcec_slave_t *slave) {
 
   // initialize callbacks
   slave->proc_read = lcec_el1xxx_read;
+  slave->proc_post_reg = lcec_el1xxx_post_reg;
 
   hal_data = lcec_din_allocate_channels(channels);
   if (hal_data == NULL) {
@@ -109,3 +111,10 @@ static void lcec_el1xxx_read(lcec_slave_t *slave, long period) {
 
   lcec_din_read_all(slave, hal_data);
 }
+
+static int lcec_el1xxx_post_reg(lcec_slave_t *slave) {
+  lcec_class_din_channels_t *hal_data = (lcec_class_din_channels_t *)slave->hal_data;
+
+  lcec_din_plan(slave, hal_data);
+  return 0;
+}
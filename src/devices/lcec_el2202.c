@@ -126,8 +126,7 @@ static int lcec_el2202_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el2202_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
 
   lcec_el2202_data_t *hal_data = (lcec_el2202_data_t *)slave->hal_data;
   lcec_el2202_chan_t *chan;
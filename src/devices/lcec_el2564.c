@@ -174,9 +174,8 @@ static int lcec_el2564_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el2564_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el2564_data_t *hal_data = (lcec_el2564_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_el2564_chan_t *chan;
   int i;
 
@@ -196,9 +195,8 @@ static void lcec_el2564_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el2564_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el2564_data_t *hal_data = (lcec_el2564_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_el2564_chan_t *chan;
   int i;
   int32_t value;
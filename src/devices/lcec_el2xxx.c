@@ -53,6 +53,7 @@ static lcec_typelist_t types[] = {
 ADD_TYPES(types);
 
 static void lcec_el2xxx_write(lcec_slave_t *slave, long period);
+static int lcec_el2xxx_post_reg(lcec_slave_t *slave);
 
 static int lcec_el2xxx_init(int comp_id, lcec_slave_t *slave) {
   lcec_class_dout_channels_t *hal_data;
@@ -60,6 +61,7 @@ static int lcec_el2xxx_init(int comp_id, lcec_slave_t *slave) {
 
   // initialize callbacks
   slave->proc_write = lcec_el2xxx_write;
+  slave->proc_post_reg = lcec_el2xxx_post_reg;
 
   hal_data = lcec_dout_allocate_channels(slave->flags);
   if (hal_data == NULL) {
@@ -83,3 +85,10 @@ static void lcec_el2xxx_write(lcec_slave_t *slave, long period) {
   }
   lcec_dout_write_all(slave, hal_data);
 }
+
+static int lcec_el2xxx_post_reg(lcec_slave_t *slave) {
+  lcec_class_dout_channels_t *hal_data = (lcec_class_dout_channels_t *)slave->hal_data;
+
+  lcec_dout_plan(slave, hal_data);
+  return 0;
+}
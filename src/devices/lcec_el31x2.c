@@ -126,9 +126,8 @@ static int lcec_el31x2_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el31x2_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el31x2_data_t *hal_data = (lcec_el31x2_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_el31x2_chan_t *chan;
   uint8_t state;
@@ -32,9 +32,12 @@
 //   without 0x6000:e (the sync error PDO).  It looks like it was
 //   added in r18.  Is there a point in keeping the sync error pin at all?
 
-#define LCEC_EL3XXX_MODPARAM_SENSOR     0
-#define LCEC_EL3XXX_MODPARAM_RESOLUTION 8
-#define LCEC_EL3XXX_MODPARAM_WIRES      16
+#define LCEC_EL3XXX_MODPARAM_SENSOR       0
+#define LCEC_EL3XXX_MODPARAM_RESOLUTION   8
+#define LCEC_EL3XXX_MODPARAM_WIRES        16
+#define LCEC_EL3XXX_MODPARAM_OVERSAMPLING 24
+#define LCEC_EL3XXX_MODPARAM_FILTER       25
+#define LCEC_EL3XXX_MODPARAM_SAMPLES      26
 
 #define LCEC_EL3XXX_MAXCHANS 8  // for sizing arrays
 
@@ -82,6 +85,15 @@ static const lcec_modparam_desc_t modparams_temperature8[] = {
     {NULL},
 };
 
+/// @brief Modparams for oversampling devices.
+static const lcec_modparam_desc_t modparams_oversampling[] = {
+    {"oversampling", LCEC_EL3XXX_MODPARAM_OVERSAMPLING, MODPARAM_TYPE_U32, "1",
+        "Samples per channel and servo cycle, 1 to 100.  Needs DC, see el3xxx.md"},
+    {"filter", LCEC_EL3XXX_MODPARAM_FILTER, MODPARAM_TYPE_STRING, "mean", "How samples are reduced to val: mean|min|max|fir|iir"},
+    {"publishSamples", LCEC_EL3XXX_MODPARAM_SAMPLES, MODPARAM_TYPE_BIT, "false", "Also publish every sample on ain-N-sample-K pins"},
+    {NULL},
+};
+
 /// @brief Lookup table of known temperature sensor types and their codes.
 ///
 /// From https://download.beckhoff.com/download/Document/io/ethercat-terminals/el32xxen.pdf#page=223
@@ -139,10 +151,11 @@ static const lcec_lookuptable_int_t temp_wires[] = {
 };
 
 /// Flags for describing devices
-#define F_CHANNELS(x) (x)      ///< Number of input channels
-#define F_SYNC        1 << 14  ///< Device has `sync-error` PDO
-#define F_TEMPERATURE 1 << 15  ///< Device is a temperature sensor
-#define F_PRESSURE    1 << 16  ///< Device is a pressure sensor
+#define F_CHANNELS(x)  (x)      ///< Number of input channels
+#define F_SYNC         1 << 14  ///< Device has `sync-error` PDO
+#define F_TEMPERATURE  1 << 15  ///< Device is a temperature sensor
+#define F_PRESSURE     1 << 16  ///< Device is a pressure sensor
+#define F_OVERSAMPLING 1 << 17  ///< Device maps multiple samples per cycle through oversampling PDOs
 
 #define INPORTS(flag) ((flag)&0xf)  // Number of input channels
 #define PDOS(flag)    (((flag)&F_SYNC) ? (5 * INPORTS(flag)) : (4 * INPORTS(flag)))
@@ -222,18 +235,24 @@ static lcec_typelist_t types[] = {
     BECKHOFF_AIN_DEVICE("EM3701", 0x0e753452, F_CHANNELS(1) | F_PRESSURE),
     BECKHOFF_AIN_DEVICE("EM3702", 0x0e763452, F_CHANNELS(2) | F_PRESSURE),
     BECKHOFF_AIN_DEVICE("EM3712", 0x0e803452, F_CHANNELS(2) | F_PRESSURE),
+
+    // Oversampling devices.
+    BECKHOFF_AIN_DEVICE_PARAMS("EL3702", 0x0e763052, F_CHANNELS(2) | F_OVERSAMPLING, modparams_oversampling),
     {NULL},
 };
 ADD_TYPES(types)
 
 static void lcec_el3xxx_read(lcec_slave_t *slave, long period);
+static int lcec_el3xxx_post_reg(lcec_slave_t *slave);
 static int set_sensor_type(lcec_slave_t *slave, char *sensortype, lcec_class_ain_channel_t *chan, int idx, int sidx);
 static int set_resolution(lcec_slave_t *slave, char *resolution_name, lcec_class_ain_channel_t *chan, int idx, int sidx);
 static int set_wires(lcec_slave_t *slave, char *wires_name, lcec_class_ain_channel_t *chan, int idx, int sidx);
+static int setup_oversampling(lcec_slave_t *slave, lcec_class_ain_options_t *os_opt);
 
 /// @brief Initialize an EL3xxx device.
 static int lcec_el3xxx_init(int comp_id, lcec_slave_t *slave) {
   lcec_class_ain_channels_t *hal_data;
+  lcec_class_ain_options_t os_opt = {0};
   uint64_t flags;
 
   flags = slave->flags;
@@ -244,16 +263,32 @@ static int lcec_el3xxx_init(int comp_id, lcec_slave_t *slave) {
   hal_data = lcec_ain_allocate_channels(INPORTS(slave->flags));
   slave->hal_data = hal_data;
 
+  if (flags & F_OVERSAMPLING) {
+    if (setup_oversampling(slave, &os_opt) != 0) return -1;  // setup_oversampling logs an error message so we don't have to.
+  }
+
   for (int i = 0; i < hal_data->count; i++) {
     lcec_class_ain_options_t *options = lcec_ain_options();
     options->has_sync = flags & F_SYNC;
     options->is_temperature = flags & F_TEMPERATURE;
     options->is_pressure = flags & F_PRESSURE;
 
+    if (flags & F_OVERSAMPLING) {
+      // sample K of channel N is 0x6000 + 0x10 * K, subindex N + 1
+      options->valueonly = 1;
+      options->value_idx = 0x6000;
+      options->value_sidx = i + 1;
+      options->oversampling = os_opt.oversampling;
+      options->oversampling_filter = os_opt.oversampling_filter;
+      options->oversampling_pins = os_opt.oversampling_pins;
+    }
+
     hal_data->channels[i] = lcec_ain_register_channel(slave, i, 0x6000 + (i << 4), options);
+    if (hal_data->channels[i] == NULL) return -1;
   }
 
   slave->proc_read = lcec_el3xxx_read;
+  slave->proc_post_reg = lcec_el3xxx_post_reg;
 
   // handle modParams
   for (int i = 0; i < hal_data->count; i++) {
@@ -302,6 +337,14 @@ static void lcec_el3xxx_read(lcec_slave_t *slave, long period) {
   lcec_ain_read_all(slave, hal_data);
 }
 
+/// @brief Set up the cyclic reads, once the PDO offsets are known.
+static int lcec_el3xxx_post_reg(lcec_slave_t *slave) {
+  lcec_class_ain_channels_t *hal_data = (lcec_class_ain_channels_t *)slave->hal_data;
+
+  lcec_ain_plan(slave, hal_data);
+  return 0;
+}
+
 /// @brief Set the sensor type for a channel.
 static int set_sensor_type(lcec_slave_t *slave, char *sensortype, lcec_class_ain_channel_t *chan, int idx, int sidx) {
   int setting = lcec_lookupint_i(temp_sensors_setting, sensortype, -1);
@@ -358,3 +401,76 @@ static int set_wires(lcec_slave_t *slave, char *wires_name, lcec_class_ain_chann
   }
   return 0;
 }
+
+/// @brief Handle the oversampling modParams and map the sample PDOs.
+///
+/// EL37xx terminals have one PDO per channel and sample:
+/// `0x1a00 + 0x80 * N + K` holds sample K of channel N.  They are
+/// mapped channel by channel, so each channel's samples are
+/// consecutive in the process data.
+///
+/// The terminal takes a sample on every SYNC0, so SYNC0 has to run
+/// `oversampling` times per cycle of the slave's Sync Unit, with SYNC1
+/// marking the cycle.  Unless the XML has a `<dcConf>`, this sets that
+/// up the way Beckhoff's ESI does.
+static int setup_oversampling(lcec_slave_t *slave, lcec_class_ain_options_t *os_opt) {
+  LCEC_CONF_MODPARAM_VAL_T *pval;
+  lcec_syncs_t *syncs;
+
+  os_opt->oversampling = 1;
+  os_opt->oversampling_filter = LCEC_AIN_FILTER_MEAN;
+
+  // <modParam name="oversampling" value="???"/>
+  pval = lcec_modparam_get(slave, LCEC_EL3XXX_MODPARAM_OVERSAMPLING);
+  if (pval != NULL) os_opt->oversampling = pval->u32;
+  if (os_opt->oversampling < 1 || os_opt->oversampling > LCEC_AIN_MAX_OVERSAMPLING) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: oversampling must be between 1 and %d\n", slave->master->name,
+        slave->name, LCEC_AIN_MAX_OVERSAMPLING);
+    return -1;
+  }
+  if (slave->sync_unit->cycle_time % os_opt->oversampling != 0) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: oversampling %d does not divide the syncUnit cycle of %u ns\n",
+        slave->master->name, slave->name, os_opt->oversampling, slave->sync_unit->cycle_time);
+    return -1;
+  }
+
+  // <modParam name="filter" value="???"/>
+  pval = lcec_modparam_get(slave, LCEC_EL3XXX_MODPARAM_FILTER);
+  if (pval != NULL) {
+    os_opt->oversampling_filter = lcec_lookupint_i(lcec_ain_filters, pval->str, -1);
+    if (os_opt->oversampling_filter == -1) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "unknown filter \"%s\"\n", pval->str);
+      return -1;
+    }
+  }
+
+  // <modParam name="publishSamples" value="???"/>
+  pval = lcec_modparam_get(slave, LCEC_EL3XXX_MODPARAM_SAMPLES);
+  if (pval != NULL) os_opt->oversampling_pins = pval->bit;
+
+  syncs = LCEC_HAL_ALLOCATE(lcec_syncs_t);
+  lcec_syncs_init(slave, syncs);
+  lcec_syncs_add_sync(syncs, EC_DIR_OUTPUT, EC_WD_DEFAULT);
+  lcec_syncs_add_sync(syncs, EC_DIR_INPUT, EC_WD_DEFAULT);
+  lcec_syncs_add_sync(syncs, EC_DIR_OUTPUT, EC_WD_DEFAULT);
+  lcec_syncs_add_sync(syncs, EC_DIR_INPUT, EC_WD_DEFAULT);
+  for (int i = 0; i < INPORTS(slave->flags); i++) {
+    for (int k = 0; k < os_opt->oversampling; k++) {
+      lcec_syncs_add_pdo_info(syncs, 0x1a00 + (i << 7) + k);
+      lcec_syncs_add_pdo_entry(syncs, 0x6000 + (k << 4), i + 1, 16);  // Sample K
+    }
+  }
+  slave->sync_info = &syncs->syncs[0];
+
+  if (slave->dc_conf == NULL) {
+    lcec_slave_dc_t *dc = LCEC_HAL_ALLOCATE(lcec_slave_dc_t);
+    uint32_t sample_period = slave->sync_unit->cycle_time / os_opt->oversampling;
+
+    dc->assignActivate = 0x730;
+    dc->sync0Cycle = sample_period;
+    dc->sync1Cycle = slave->sync_unit->cycle_time - sample_period;
+    slave->dc_conf = dc;
+  }
+
+  return 0;
+}
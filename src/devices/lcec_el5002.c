@@ -279,9 +279,8 @@ static int lcec_el5002_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el5002_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el5002_data_t *hal_data = (lcec_el5002_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_el5002_chan_t *chan;
   int32_t raw_count, raw_delta;
@@ -198,9 +198,8 @@ static int lcec_el5101_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el5101_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el5101_data_t *hal_data = (lcec_el5101_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint8_t raw_status;
   int16_t raw_count, raw_latch, raw_delta;
   uint16_t raw_period, raw_window;
@@ -297,9 +296,8 @@ static void lcec_el5101_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el5101_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el5101_data_t *hal_data = (lcec_el5101_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint8_t raw_ctrl;
 
   // build control byte
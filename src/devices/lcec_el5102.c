@@ -212,9 +212,8 @@ static void lcec_el5102_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el5102_read_channel(lcec_slave_t *slave, long period, int channel) {
-  lcec_master_t *master = slave->master;
   lcec_el5102_channel_data_t *data = &((lcec_el5102_data_t *)slave->hal_data)->channel[channel];
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int16_t raw_count, raw_latch, raw_delta;
   // uint16_t raw_period;
   // uint32_t raw_frequency;
@@ -314,9 +313,8 @@ static void lcec_el5102_write(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el5102_write_channel(lcec_slave_t *slave, long period, int channel) {
-  lcec_master_t *master = slave->master;
   lcec_el5102_channel_data_t *data = &((lcec_el5102_data_t *)slave->hal_data)->channel[channel];
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
 
   // Set control bits.  Note that there are 10 of these defined above,
   // but we're only actually using 4 of them.  We should add the
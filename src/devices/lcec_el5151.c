@@ -231,9 +231,8 @@ static int lcec_el5151_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el5151_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el5151_data_t *hal_data = (lcec_el5151_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int32_t raw_count, raw_latch, raw_delta;
   uint32_t raw_period;
 
@@ -326,9 +325,8 @@ static void lcec_el5151_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el5151_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el5151_data_t *hal_data = (lcec_el5151_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
 
   // set output data
   EC_WRITE_BIT(&pd[hal_data->set_count_pdo_os], hal_data->set_count_pdo_bp, *(hal_data->set_raw_count));
@@ -258,6 +258,12 @@ static int lcec_el6900_init(int comp_id, lcec_slave_t *slave) {
       // find slave
       index = p->value.u32;
       fsoe_slave = lcec_slave_by_index(master, index);
+      if (fsoe_slave != NULL && fsoe_slave->sync_unit != slave->sync_unit) {
+        // copy_fsoe_data() copies within one Sync Unit's process data
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: FSoE slave %s must be in the same syncUnit\n", master->name, slave->name,
+            fsoe_slave->name);
+        return -EINVAL;
+      }
       fsoe_data->fsoe_slave = fsoe_slave;
       fsoe_slave->fsoe_slave_offset = &fsoe_data->fsoe_slave_cmd_os;
       fsoe_slave->fsoe_master_offset = &fsoe_data->fsoe_master_cmd_os;
@@ -295,9 +301,8 @@ static int lcec_el6900_init(int comp_id, lcec_slave_t *slave) {
 }
 
 void lcec_el6900_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el6900_data_t *hal_data = (lcec_el6900_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_el6900_fsoe_t *fsoe_data;
   int i, crc_idx;
   lcec_el6900_fsoe_io_t *io;
@@ -329,9 +334,8 @@ void lcec_el6900_read(lcec_slave_t *slave, long period) {
 }
 
 void lcec_el6900_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el6900_data_t *hal_data = (lcec_el6900_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_el6900_fsoe_io_t *io;
   int i;
 
@@ -601,9 +601,8 @@ static int lcec_el7041_init(int comp_id, lcec_slave_t *s) {
 }
 
 static void lcec_el7041_read(lcec_slave_t *s, long period) {
-  lcec_master_t *m = s->master;
   lcec_el7041_data_t *hd = (lcec_el7041_data_t *)s->hal_data;
-  uint8_t *pd = m->process_data;
+  uint8_t *pd = s->sync_unit->process_data;
   int16_t raw_count, raw_latch, raw_delta;
 
   // wait for slave to be operational
@@ -723,9 +722,8 @@ static void lcec_el7041_read(lcec_slave_t *s, long period) {
 }
 
 static void lcec_el7041_write(lcec_slave_t *s, long period) {
-  lcec_master_t *m = s->master;
   lcec_el7041_data_t *hd = (lcec_el7041_data_t *)s->hal_data;
-  uint8_t *pd = m->process_data;
+  uint8_t *pd = s->sync_unit->process_data;
   double tmpval, tmpdc, raw_val;
   int enable_on_edge;
 
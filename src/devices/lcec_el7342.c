@@ -494,9 +494,8 @@ static int lcec_el7342_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el7342_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el7342_data_t *hal_data = (lcec_el7342_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_el7342_chan_t *chan;
   int16_t raw_count, raw_latch, raw_delta;
@@ -604,9 +603,8 @@ static void lcec_el7342_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_el7342_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el7342_data_t *hal_data = (lcec_el7342_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_el7342_chan_t *chan;
   double tmpval, tmpdc, raw_val;
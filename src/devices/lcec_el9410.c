@@ -68,7 +68,7 @@ static int lcec_el9410_init(int comp_id, lcec_slave_t *slave) {
 
 /// @brief Read values from the device.
 static void lcec_el9410_read(lcec_slave_t *slave, long period) {
-  uint8_t *pd = slave->master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_el9410_data_t *hal_data = (lcec_el9410_data_t *)slave->hal_data;
 
   // wait for slave to be operational
@@ -76,9 +76,8 @@ static int lcec_el95xx_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_el95xx_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_el95xx_data_t *hal_data = (lcec_el95xx_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
 
   // wait for slave to be operational
   if (!slave->state.operational) {
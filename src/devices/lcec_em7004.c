@@ -268,9 +268,8 @@ static int lcec_em7004_init(int comp_id, lcec_slave_t *slave) {
 }
 
 static void lcec_em7004_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_em7004_data_t *hal_data = (lcec_em7004_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_em7004_din_t *din;
   lcec_em7004_enc_t *enc;
   int i, s;
@@ -360,9 +359,8 @@ static void lcec_em7004_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_em7004_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_em7004_data_t *hal_data = (lcec_em7004_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_em7004_dout_t *dout;
   lcec_em7004_aout_t *aout;
   lcec_em7004_enc_t *enc;
@@ -171,7 +171,7 @@ static int lcec_ep9214_init(int comp_id, lcec_slave_t *slave) {
 
 /// @brief Read values from the device.
 static void lcec_ep9214_read(lcec_slave_t *slave, long period) {
-  uint8_t *pd = slave->master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_ep9214_data_t *hal_data = (lcec_ep9214_data_t *)slave->hal_data;
 
   // wait for slave to be operational
@@ -202,7 +202,7 @@ static void lcec_ep9214_read(lcec_slave_t *slave, long period) {
 
 /// @brief Write values to the device.
 static void lcec_ep9214_write(lcec_slave_t *slave, long period) {
-  uint8_t *pd = slave->master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   lcec_ep9214_data_t *hal_data = (lcec_ep9214_data_t *)slave->hal_data;
 
   // wait for slave to be operational
@@ -29,314 +29,433 @@ static lcec_typelist_t types[] = {
 };
 ADD_TYPES(types)
 
-void lcec_generic_read(lcec_slave_t *slave, long period);
-void lcec_generic_write(lcec_slave_t *slave, long period);
+/// @brief Set up the cyclic record and HAL pins for one generic pin.
+///
+/// @return 0 on success, 1 if the pin can't be exported and is skipped, <0 on error.
+static int lcec_generic_init_pin(lcec_slave_t *slave, const lcec_generic_pin_t *conf, lcec_generic_hal_pin_t *pin) {
+  lcec_master_t *master = slave->master;
+  hal_bit_t **bits;
+  int j;
+  int err;
+
+  switch (conf->type) {
+    case HAL_BIT:
+      if (conf->bitLength == 0) {
+        rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unable to export pin %s.%s.%s.%s: invalid process data bitlen!\n", LCEC_MODULE_NAME,
+            master->name, slave->name, conf->name);
+        return 1;
+      }
+      break;
+
+    case HAL_S32:
+    case HAL_U32:
+      // check data size
+      if (conf->bitLength > 32) {
+        rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unable to export pin %s.%s.%s.%s: invalid process data bitlen!\n", LCEC_MODULE_NAME,
+            master->name, slave->name, conf->name);
+        return 1;
+      }
+      break;
+
+    case HAL_FLOAT:
+      // check data size
+      if ((conf->bitLength > 32) && (conf->subType != lcecPdoEntTypeFloatDoubleIeee)) {
+        rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unable to export pin %s.%s.%s.%s: invalid process data bitlen!\n", LCEC_MODULE_NAME,
+            master->name, slave->name, conf->name);
+        return 1;
+      }
+      break;
+
+    default:
+      rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unsupported pin type %d!\n", conf->type);
+      return 1;
+  }
+
+  pin->type = conf->type;
+  pin->subType = conf->subType;
+  pin->floatScale = conf->floatScale;
+  pin->floatOffset = conf->floatOffset;
+  pin->bitOffset = conf->bitOffset;
+  pin->bitLength = conf->bitLength;
+
+  // PDO mapping
+  if ((err = lcec_pdo_init(slave, conf->pdo_idx, conf->pdo_sidx, &pin->pdo_os, &pin->pdo_bp)) != 0) {
+    return err;
+  }
+
+  if (conf->type != HAL_BIT || conf->bitLength == 1) {
+    // single pin
+    return lcec_pin_newf(conf->type, conf->dir, &pin->pin, "%s.%s.%s.%s", LCEC_MODULE_NAME, master->name, slave->name, conf->name);
+  }
 
-hal_s32_t lcec_generic_read_s32(uint8_t *pd, lcec_generic_pin_t *hal_data);
-hal_u32_t lcec_generic_read_u32(uint8_t *pd, lcec_generic_pin_t *hal_data);
-void lcec_generic_write_s32(uint8_t *pd, lcec_generic_pin_t *hal_data, hal_s32_t sval);
-void lcec_generic_write_u32(uint8_t *pd, lcec_generic_pin_t *hal_data, hal_u32_t uval);
+  // bit pin array
+  pin->bitCount = (conf->bitLength < LCEC_CONF_GENERIC_MAX_SUBPINS) ? conf->bitLength : LCEC_CONF_GENERIC_MAX_SUBPINS;
+  bits = LCEC_HAL_ALLOCATE_ARRAY(hal_bit_t *, pin->bitCount);
+  pin->pin = bits;
+  for (j = 0; j < pin->bitCount; j++) {
+    err = lcec_pin_newf(
+        HAL_BIT, conf->dir, (void **)&bits[j], "%s.%s.%s.%s-%d", LCEC_MODULE_NAME, master->name, slave->name, conf->name, j);
+    if (err != 0) {
+      return err;
+    }
+  }
+  return 0;
+}
 
 /// @brief Initialize a generic device.
 ///
 /// Not static because it's called directly from `lcec_main`, unlike
-/// "normal" devices.
+/// "normal" devices.  On entry `slave->hal_data` holds the
+/// `lcec_generic_pin_t` array from the config; it's replaced by the
+/// `lcec_generic_data_t` used at runtime.
 int lcec_generic_init(int comp_id, lcec_slave_t *slave) {
-  lcec_master_t *master = slave->master;
-  lcec_generic_pin_t *hal_data = (lcec_generic_pin_t *)slave->hal_data;
-  int i, j;
+  lcec_generic_pin_t *conf = (lcec_generic_pin_t *)slave->hal_data;
+  lcec_generic_data_t *hal_data;
+  lcec_generic_hal_pin_t *pin;
+  hal_pin_dir_t dir;
+  int i, pass;
   int err;
 
   // initialize callbacks
   slave->proc_read = lcec_generic_read;
   slave->proc_write = lcec_generic_write;
-
-  // initialize pins
-  for (i = 0; i < slave->generic_pdo_entry_count; i++, hal_data++) {
-    // PDO mapping
-    lcec_pdo_init(slave, hal_data->pdo_idx, hal_data->pdo_sidx, &hal_data->pdo_os, &hal_data->pdo_bp);
-
-    switch (hal_data->type) {
-      case HAL_BIT:
-        if (hal_data->bitLength == 1) {
-          // single bit pin
-          err = lcec_pin_newf(
-              hal_data->type, hal_data->dir, &hal_data->pin[0], "%s.%s.%s.%s", LCEC_MODULE_NAME, master->name, slave->name, hal_data->name);
-          if (err != 0) {
-            return err;
-          }
-        } else {
-          // bit pin array
-          for (j = 0; j < LCEC_CONF_GENERIC_MAX_SUBPINS && j < hal_data->bitLength; j++) {
-            err = lcec_pin_newf(hal_data->type, hal_data->dir, &hal_data->pin[j], "%s.%s.%s.%s-%d", LCEC_MODULE_NAME, master->name,
-                slave->name, hal_data->name, j);
-            if (err != 0) {
-              return err;
-            }
-          }
-        }
-        break;
-
-      case HAL_S32:
-      case HAL_U32:
-        // check data size
-        if (hal_data->bitLength > 32) {
-          rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unable to export pin %s.%s.%s.%s: invalid process data bitlen!\n", LCEC_MODULE_NAME,
-              master->name, slave->name, hal_data->name);
-          continue;
-        }
-
-        // export pin
-        err = lcec_pin_newf(
-            hal_data->type, hal_data->dir, &hal_data->pin[0], "%s.%s.%s.%s", LCEC_MODULE_NAME, master->name, slave->name, hal_data->name);
-        if (err != 0) {
-          return err;
-        }
-        break;
-
-      case HAL_FLOAT:
-        // check data size
-        if ((hal_data->bitLength > 32) && (hal_data->subType != lcecPdoEntTypeFloatDoubleIeee)) {
-          rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unable to export pin %s.%s.%s.%s: invalid process data bitlen!\n", LCEC_MODULE_NAME,
-              master->name, slave->name, hal_data->name);
-          continue;
-        }
-
-        // export pin
-        err = lcec_pin_newf(
-            hal_data->type, hal_data->dir, &hal_data->pin[0], "%s.%s.%s.%s", LCEC_MODULE_NAME, master->name, slave->name, hal_data->name);
-        if (err != 0) {
-          return err;
-        }
-        break;
-
-      default:
-        rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "unsupported pin type %d!\n", hal_data->type);
+  slave->proc_post_reg = lcec_generic_post_reg;
+
+  hal_data = (lcec_generic_data_t *)lcec_hal_malloc(
+      sizeof(lcec_generic_data_t) + sizeof(lcec_generic_hal_pin_t) * slave->generic_pdo_entry_count, __FILE__, __func__, __LINE__);
+  slave->hal_data = hal_data;
+
+  // initialize pins, the ones read from the device first
+  pin = hal_data->pins;
+  for (pass = 0; pass < 2; pass++) {
+    dir = (pass == 0) ? HAL_OUT : HAL_IN;
+    for (i = 0; i < slave->generic_pdo_entry_count; i++) {
+      if (conf[i].dir != dir) {
+        continue;
+      }
+
+      err = lcec_generic_init_pin(slave, &conf[i], pin);
+      if (err < 0) {
+        free(conf);
+        return err;
+      }
+      if (err > 0) {
+        continue;
+      }
+
+      if (dir == HAL_OUT) {
+        hal_data->read_count++;
+      } else {
+        hal_data->write_count++;
+      }
+      pin++;
     }
   }
 
+  free(conf);
   return 0;
 }
 
-/// @brief Read from a generic device.
-void lcec_generic_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
-  lcec_generic_pin_t *hal_data = (lcec_generic_pin_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
-  int i, j, offset;
-  hal_float_t fval;
-
-  // read data
-  for (i = 0; i < slave->generic_pdo_entry_count; i++, hal_data++) {
-    // skip wrong direction and uninitialized pins
-    if (hal_data->dir != HAL_OUT || hal_data->pin[0] == NULL) {
-      continue;
-    }
+// Access routines.  `lcec_generic_post_reg()` picks one per pin, so the
+// cyclic loops make one indirect call per pin and no type decisions.
+// Fields that don't start on a byte or aren't 8, 16 or 32 bits wide
+// are cut out of one 64-bit load with a shift and a mask; only fields
+// within the last 7 bytes of the process data are assembled bytewise.
+// Bit arrays move the whole field the same way and scatter it to, or
+// gather it from, the bit pins.
 
-    switch (hal_data->type) {
-      case HAL_BIT:
-        offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-        for (j = 0; j < LCEC_CONF_GENERIC_MAX_SUBPINS && hal_data->pin[j] != NULL; j++, offset++) {
-          *((hal_bit_t *)hal_data->pin[j]) = EC_READ_BIT(&pd[offset >> 3], offset & 0x07);
-        }
-        break;
-
-      case HAL_S32:
-        *((hal_s32_t *)hal_data->pin[0]) = lcec_generic_read_s32(pd, hal_data);
-        break;
-
-      case HAL_U32:
-        *((hal_u32_t *)hal_data->pin[0]) = lcec_generic_read_u32(pd, hal_data);
-        break;
-
-      case HAL_FLOAT:
-        if (hal_data->subType == lcecPdoEntTypeFloatUnsigned) {
-          fval = lcec_generic_read_u32(pd, hal_data);
-        } else if (hal_data->subType == lcecPdoEntTypeFloatIeee) {
-          fval = EC_READ_REAL(&pd[hal_data->pdo_os]);
-        } else if (hal_data->subType == lcecPdoEntTypeFloatDoubleIeee) {
-          fval = EC_READ_LREAL(&pd[hal_data->pdo_os]);
-        } else {
-          fval = lcec_generic_read_s32(pd, hal_data);
-        }
-
-        fval *= hal_data->floatScale;
-        fval += hal_data->floatOffset;
-        *((hal_float_t *)hal_data->pin[0]) = fval;
-        break;
-
-      default:
-        continue;
-    }
+/// @brief Width of the field moved by `lcec_generic_get()` and `lcec_generic_put()`, at most 32 bits.
+static inline int lcec_generic_len(const lcec_generic_hal_pin_t *pin) { return (pin->bitLength < 32) ? pin->bitLength : 32; }
+
+/// @brief Load the bytes holding a field that ends near the end of the process data.
+static inline uint64_t lcec_generic_load_tail(const lcec_generic_hal_pin_t *pin, const uint8_t *pd) {
+  int n = (pin->shift + lcec_generic_len(pin) + 7) >> 3;
+  uint64_t raw = 0;
+
+  for (int i = 0; i < n; i++) {
+    raw |= (uint64_t)pd[pin->byte + i] << (i * 8);
   }
+  return raw;
 }
 
-/// @brief Write to a generic device.
-void lcec_generic_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
-  lcec_generic_pin_t *hal_data = (lcec_generic_pin_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
-  int i, j, offset;
-  hal_float_t fval;
-
-  // write data
-  for (i = 0; i < slave->generic_pdo_entry_count; i++, hal_data++) {
-    // skip wrong direction and uninitialized pins
-    if (hal_data->dir != HAL_IN || hal_data->pin[0] == NULL) {
-      continue;
-    }
+/// @brief Read a field, zero-extended.
+static inline uint32_t lcec_generic_get(const lcec_generic_hal_pin_t *pin, const uint8_t *pd) {
+  uint64_t raw = pin->wide ? EC_READ_U64(&pd[pin->byte]) : lcec_generic_load_tail(pin, pd);
+  return (uint32_t)(raw >> pin->shift) & pin->mask;
+}
 
-    switch (hal_data->type) {
-      case HAL_BIT:
-        offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-        for (j = 0; j < LCEC_CONF_GENERIC_MAX_SUBPINS && hal_data->pin[j] != NULL; j++, offset++) {
-          EC_WRITE_BIT(&pd[offset >> 3], offset & 0x07, *((hal_bit_t *)hal_data->pin[j]));
-        }
-        break;
-
-      case HAL_S32:
-        lcec_generic_write_s32(pd, hal_data, *((hal_s32_t *)hal_data->pin[0]));
-        break;
-
-      case HAL_U32:
-        lcec_generic_write_u32(pd, hal_data, *((hal_u32_t *)hal_data->pin[0]));
-        break;
-
-      case HAL_FLOAT:
-        fval = *((hal_float_t *)hal_data->pin[0]);
-        fval += hal_data->floatOffset;
-        fval *= hal_data->floatScale;
-
-        if (hal_data->subType == lcecPdoEntTypeFloatUnsigned) {
-          lcec_generic_write_u32(pd, hal_data, (hal_u32_t)fval);
-        } else if (hal_data->subType == lcecPdoEntTypeFloatIeee) {
-          EC_WRITE_REAL(&pd[hal_data->pdo_os], fval);
-        } else if (hal_data->subType == lcecPdoEntTypeFloatDoubleIeee) {
-          EC_WRITE_LREAL(&pd[hal_data->pdo_os], fval);
-        } else {
-          lcec_generic_write_s32(pd, hal_data, (hal_s32_t)fval);
-        }
-        break;
-
-      default:
-        continue;
-    }
-  }
+/// @brief Sign-extend a field read with `lcec_generic_get()`.
+static inline int32_t lcec_generic_sign(const lcec_generic_hal_pin_t *pin, uint32_t uval) {
+  return (int32_t)(uval << pin->sign_shift) >> pin->sign_shift;
 }
 
-/// @brief Read a possibly-misaligned signed integer.
-hal_s32_t lcec_generic_read_s32(uint8_t *pd, lcec_generic_pin_t *hal_data) {
-  int i, offset;
-  hal_s32_t sval;
+/// @brief Write a field, leaving the bits around it alone.
+static inline void lcec_generic_put(const lcec_generic_hal_pin_t *pin, uint8_t *pd, uint32_t uval) {
+  uint64_t mask = (uint64_t)pin->mask << pin->shift;
+  uint64_t val = ((uint64_t)uval << pin->shift) & mask;
+  int n;
 
-  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
-    switch (hal_data->bitLength) {
-      case 8:
-        return EC_READ_S8(&pd[hal_data->pdo_os]);
-      case 16:
-        return EC_READ_S16(&pd[hal_data->pdo_os]);
-      case 32:
-        return EC_READ_S32(&pd[hal_data->pdo_os]);
-    }
+  if (pin->wide) {
+    EC_WRITE_U64(&pd[pin->byte], (EC_READ_U64(&pd[pin->byte]) & ~mask) | val);
+    return;
   }
 
-  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-  for (sval = 0, i = 0; i < hal_data->bitLength; i++, offset++) {
-    if (EC_READ_BIT(&pd[offset >> 3], offset & 0x07)) {
-      sval |= (1 << i);
-    }
+  n = (pin->shift + lcec_generic_len(pin) + 7) >> 3;
+  for (int i = 0; i < n; i++) {
+    uint8_t m = mask >> (i * 8);
+    pd[pin->byte + i] = (pd[pin->byte + i] & ~m) | (uint8_t)(val >> (i * 8));
   }
+}
 
-  // sign-extend shorter length integers
-  switch (hal_data->bitLength) {
-    case 8:
-      return (int8_t)sval;
-    case 16:
-      return (int16_t)sval;
-  }
+static inline uint32_t lcec_generic_clamp_u(const lcec_generic_hal_pin_t *pin, hal_u32_t uval) {
+  return (uval > pin->umax) ? pin->umax : uval;
+}
 
+static inline int32_t lcec_generic_clamp_s(const lcec_generic_hal_pin_t *pin, hal_s32_t sval) {
+  if (sval > pin->smax) return pin->smax;
+  if (sval < pin->smin) return pin->smin;
   return sval;
 }
 
-/// @brief Read a possibly-misaligned unsigned integer.
-hal_u32_t lcec_generic_read_u32(uint8_t *pd, lcec_generic_pin_t *hal_data) {
-  int i, offset;
-  hal_u32_t uval;
+static void lcec_generic_read_bit(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_bit_t *)pin->pin) = EC_READ_BIT(&pd[pin->byte], pin->shift);
+}
 
-  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
-    switch (hal_data->bitLength) {
-      case 8:
-        return EC_READ_U8(&pd[hal_data->pdo_os]);
-      case 16:
-        return EC_READ_U16(&pd[hal_data->pdo_os]);
-      case 32:
-        return EC_READ_U32(&pd[hal_data->pdo_os]);
-    }
+static void lcec_generic_read_bits(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  hal_bit_t **bits = (hal_bit_t **)pin->pin;
+  uint32_t uval = lcec_generic_get(pin, pd);
+
+  for (int j = 0; j < pin->bitCount; j++, uval >>= 1) {
+    *(bits[j]) = uval & 1;
   }
+}
 
-  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-  for (uval = 0, i = 0; i < hal_data->bitLength; i++, offset++) {
-    if (EC_READ_BIT(&pd[offset >> 3], offset & 0x07)) {
-      uval |= (1 << i);
-    }
+static void lcec_generic_read_u8(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_u32_t *)pin->pin) = EC_READ_U8(&pd[pin->byte]); }
+static void lcec_generic_read_u16(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_u32_t *)pin->pin) = EC_READ_U16(&pd[pin->byte]); }
+static void lcec_generic_read_u32(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_u32_t *)pin->pin) = EC_READ_U32(&pd[pin->byte]); }
+static void lcec_generic_read_s8(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_s32_t *)pin->pin) = EC_READ_S8(&pd[pin->byte]); }
+static void lcec_generic_read_s16(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_s32_t *)pin->pin) = EC_READ_S16(&pd[pin->byte]); }
+static void lcec_generic_read_s32(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_s32_t *)pin->pin) = EC_READ_S32(&pd[pin->byte]); }
+
+static void lcec_generic_read_field_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_u32_t *)pin->pin) = (uint32_t)(EC_READ_U64(&pd[pin->byte]) >> pin->shift) & pin->mask;
+}
+
+static void lcec_generic_read_field_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  uint32_t uval = (uint32_t)(EC_READ_U64(&pd[pin->byte]) >> pin->shift) & pin->mask;
+  *((hal_s32_t *)pin->pin) = lcec_generic_sign(pin, uval);
+}
+
+static void lcec_generic_read_tail_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) { *((hal_u32_t *)pin->pin) = lcec_generic_get(pin, pd); }
+
+static void lcec_generic_read_tail_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_s32_t *)pin->pin) = lcec_generic_sign(pin, lcec_generic_get(pin, pd));
+}
+
+static void lcec_generic_read_real(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_float_t *)pin->pin) = EC_READ_REAL(&pd[pin->pdo_os]) * pin->floatScale + pin->floatOffset;
+}
+
+static void lcec_generic_read_lreal(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_float_t *)pin->pin) = EC_READ_LREAL(&pd[pin->pdo_os]) * pin->floatScale + pin->floatOffset;
+}
+
+static void lcec_generic_read_float_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_float_t *)pin->pin) = (hal_float_t)lcec_generic_get(pin, pd) * pin->floatScale + pin->floatOffset;
+}
+
+static void lcec_generic_read_float_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  *((hal_float_t *)pin->pin) = (hal_float_t)lcec_generic_sign(pin, lcec_generic_get(pin, pd)) * pin->floatScale + pin->floatOffset;
+}
+
+static void lcec_generic_write_bit(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_BIT(&pd[pin->byte], pin->shift, *((hal_bit_t *)pin->pin));
+}
+
+static void lcec_generic_write_bits(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  hal_bit_t **bits = (hal_bit_t **)pin->pin;
+  uint32_t uval = 0;
+
+  for (int j = 0; j < pin->bitCount; j++) {
+    uval |= (uint32_t)(*(bits[j]) != 0) << j;
   }
-  return uval;
-}
-
-/// @brief Write a possibly-misaligned signed integer.
-void lcec_generic_write_s32(uint8_t *pd, lcec_generic_pin_t *hal_data, hal_s32_t sval) {
-  int i, offset;
-
-  hal_s32_t lim = ((1LL << hal_data->bitLength) >> 1) - 1LL;
-  if (sval > lim) sval = lim;
-  lim = ~lim;
-  if (sval < lim) sval = lim;
-
-  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
-    switch (hal_data->bitLength) {
-      case 8:
-        EC_WRITE_S8(&pd[hal_data->pdo_os], sval);
-        return;
-      case 16:
-        EC_WRITE_S16(&pd[hal_data->pdo_os], sval);
-        return;
-      case 32:
-        EC_WRITE_S32(&pd[hal_data->pdo_os], sval);
-        return;
-    }
+  lcec_generic_put(pin, pd, uval);
+}
+
+static void lcec_generic_write_u8(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_U8(&pd[pin->byte], lcec_generic_clamp_u(pin, *((hal_u32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_u16(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_U16(&pd[pin->byte], lcec_generic_clamp_u(pin, *((hal_u32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_u32(lcec_generic_hal_pin_t *pin, uint8_t *pd) { EC_WRITE_U32(&pd[pin->byte], *((hal_u32_t *)pin->pin)); }
+
+static void lcec_generic_write_s8(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_S8(&pd[pin->byte], lcec_generic_clamp_s(pin, *((hal_s32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_s16(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_S16(&pd[pin->byte], lcec_generic_clamp_s(pin, *((hal_s32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_s32(lcec_generic_hal_pin_t *pin, uint8_t *pd) { EC_WRITE_S32(&pd[pin->byte], *((hal_s32_t *)pin->pin)); }
+
+static void lcec_generic_write_field_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  uint64_t mask = (uint64_t)pin->mask << pin->shift;
+  uint64_t val = (uint64_t)lcec_generic_clamp_u(pin, *((hal_u32_t *)pin->pin)) << pin->shift;
+  EC_WRITE_U64(&pd[pin->byte], (EC_READ_U64(&pd[pin->byte]) & ~mask) | val);
+}
+
+static void lcec_generic_write_field_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  uint64_t mask = (uint64_t)pin->mask << pin->shift;
+  uint64_t val = ((uint64_t)(uint32_t)lcec_generic_clamp_s(pin, *((hal_s32_t *)pin->pin)) << pin->shift) & mask;
+  EC_WRITE_U64(&pd[pin->byte], (EC_READ_U64(&pd[pin->byte]) & ~mask) | val);
+}
+
+static void lcec_generic_write_tail_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  lcec_generic_put(pin, pd, lcec_generic_clamp_u(pin, *((hal_u32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_packed(lcec_generic_hal_pin_t *pin, uint8_t *pd) { lcec_generic_put(pin, pd, *((hal_u32_t *)pin->pin)); }
+
+static void lcec_generic_write_tail_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  lcec_generic_put(pin, pd, lcec_generic_clamp_s(pin, *((hal_s32_t *)pin->pin)));
+}
+
+static void lcec_generic_write_real(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_REAL(&pd[pin->pdo_os], (*((hal_float_t *)pin->pin) + pin->floatOffset) * pin->floatScale);
+}
+
+static void lcec_generic_write_lreal(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  EC_WRITE_LREAL(&pd[pin->pdo_os], (*((hal_float_t *)pin->pin) + pin->floatOffset) * pin->floatScale);
+}
+
+static void lcec_generic_write_float_u(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  hal_float_t fval = (*((hal_float_t *)pin->pin) + pin->floatOffset) * pin->floatScale;
+  lcec_generic_put(pin, pd, lcec_generic_clamp_u(pin, (hal_u32_t)fval));
+}
+
+static void lcec_generic_write_float_s(lcec_generic_hal_pin_t *pin, uint8_t *pd) {
+  hal_float_t fval = (*((hal_float_t *)pin->pin) + pin->floatOffset) * pin->floatScale;
+  lcec_generic_put(pin, pd, lcec_generic_clamp_s(pin, (hal_s32_t)fval));
+}
+
+/// @brief Pick the access routine for a pin read from the device.
+static lcec_generic_op_t lcec_generic_read_op(const lcec_generic_hal_pin_t *pin, int aligned) {
+  switch (pin->type) {
+    case HAL_BIT:
+      return (pin->bitCount != 0) ? lcec_generic_read_bits : lcec_generic_read_bit;
+
+    case HAL_S32:
+      if (aligned) {
+        return (pin->bitLength == 8) ? lcec_generic_read_s8 : (pin->bitLength == 16) ? lcec_generic_read_s16 : lcec_generic_read_s32;
+      }
+      return pin->wide ? lcec_generic_read_field_s : lcec_generic_read_tail_s;
+
+    case HAL_U32:
+      if (aligned) {
+        return (pin->bitLength == 8) ? lcec_generic_read_u8 : (pin->bitLength == 16) ? lcec_generic_read_u16 : lcec_generic_read_u32;
+      }
+      return pin->wide ? lcec_generic_read_field_u : lcec_generic_read_tail_u;
+
+    case HAL_FLOAT:
+      switch (pin->subType) {
+        case lcecPdoEntTypeFloatIeee:
+          return lcec_generic_read_real;
+        case lcecPdoEntTypeFloatDoubleIeee:
+          return lcec_generic_read_lreal;
+        case lcecPdoEntTypeFloatUnsigned:
+          return lcec_generic_read_float_u;
+        default:
+          return lcec_generic_read_float_s;
+      }
+  }
+  return NULL;
+}
+
+/// @brief Pick the access routine for a pin written to the device.
+static lcec_generic_op_t lcec_generic_write_op(const lcec_generic_hal_pin_t *pin, int aligned) {
+  switch (pin->type) {
+    case HAL_BIT:
+      return (pin->bitCount != 0) ? lcec_generic_write_bits : lcec_generic_write_bit;
+
+    case HAL_S32:
+      if (aligned) {
+        return (pin->bitLength == 8) ? lcec_generic_write_s8 : (pin->bitLength == 16) ? lcec_generic_write_s16 : lcec_generic_write_s32;
+      }
+      return pin->wide ? lcec_generic_write_field_s : lcec_generic_write_tail_s;
+
+    case HAL_U32:
+      if (pin->subType == lcecPdoEntTypeBitPacked && !aligned) {
+        return lcec_generic_write_packed;
+      }
+      if (aligned) {
+        return (pin->bitLength == 8) ? lcec_generic_write_u8 : (pin->bitLength == 16) ? lcec_generic_write_u16 : lcec_generic_write_u32;
+      }
+      return pin->wide ? lcec_generic_write_field_u : lcec_generic_write_tail_u;
+
+    case HAL_FLOAT:
+      switch (pin->subType) {
+        case lcecPdoEntTypeFloatIeee:
+          return lcec_generic_write_real;
+        case lcecPdoEntTypeFloatDoubleIeee:
+          return lcec_generic_write_lreal;
+        case lcecPdoEntTypeFloatUnsigned:
+          return lcec_generic_write_float_u;
+        default:
+          return lcec_generic_write_float_s;
+      }
   }
+  return NULL;
+}
 
-  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-  for (i = 0; i < hal_data->bitLength; i++, offset++) {
-    EC_WRITE_BIT(&pd[offset >> 3], offset & 0x07, sval & 1);
-    sval >>= 1;
+/// @brief Set up the access plan of every pin, once the PDO offsets are known.
+int lcec_generic_post_reg(lcec_slave_t *slave) {
+  lcec_generic_data_t *hal_data = (lcec_generic_data_t *)slave->hal_data;
+  lcec_generic_hal_pin_t *pin = hal_data->pins;
+  unsigned int bit;
+  int i, len, aligned;
+
+  for (i = 0; i < hal_data->read_count + hal_data->write_count; i++, pin++) {
+    len = lcec_generic_len(pin);
+    bit = ((pin->pdo_os << 3) | (pin->pdo_bp & 0x07)) + pin->bitOffset;
+    pin->byte = bit >> 3;
+    pin->shift = bit & 0x07;
+    pin->wide = (pin->byte + 8 <= (unsigned int)slave->sync_unit->process_data_len);
+    pin->mask = (len == 32) ? 0xffffffff : (1u << len) - 1;
+    // packed bitfields drop the bits that don't fit instead of clamping
+    pin->umax = (pin->subType == lcecPdoEntTypeBitPacked) ? 0xffffffff : pin->mask;
+    pin->smax = pin->mask >> 1;
+    pin->smin = ~pin->smax;
+    pin->sign_shift = (len > 0) ? 32 - len : 0;
+    aligned = (pin->shift == 0) && (len == 8 || len == 16 || len == 32);
+
+    pin->op = (i < hal_data->read_count) ? lcec_generic_read_op(pin, aligned) : lcec_generic_write_op(pin, aligned);
   }
+
+  return 0;
 }
 
-/// @brief Write a possibly-misaligned unsigned integer.
-void lcec_generic_write_u32(uint8_t *pd, lcec_generic_pin_t *hal_data, hal_u32_t uval) {
-  int i, offset;
-
-  hal_u32_t lim = (1LL << hal_data->bitLength) - 1LL;
-  if (uval > lim) uval = lim;
-
-  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
-    switch (hal_data->bitLength) {
-      case 8:
-        EC_WRITE_U8(&pd[hal_data->pdo_os], uval);
-        return;
-      case 16:
-        EC_WRITE_U16(&pd[hal_data->pdo_os], uval);
-        return;
-      case 32:
-        EC_WRITE_U32(&pd[hal_data->pdo_os], uval);
-        return;
-    }
+/// @brief Read from a generic device.
+void lcec_generic_read(lcec_slave_t *slave, long period) {
+  lcec_generic_data_t *hal_data = (lcec_generic_data_t *)slave->hal_data;
+  lcec_generic_hal_pin_t *pin = hal_data->pins;
+  uint8_t *pd = slave->sync_unit->process_data;
+
+  for (int i = 0; i < hal_data->read_count; i++, pin++) {
+    pin->op(pin, pd);
   }
+}
+
+/// @brief Write to a generic device.
+void lcec_generic_write(lcec_slave_t *slave, long period) {
+  lcec_generic_data_t *hal_data = (lcec_generic_data_t *)slave->hal_data;
+  lcec_generic_hal_pin_t *pin = hal_data->pins + hal_data->read_count;
+  uint8_t *pd = slave->sync_unit->process_data;
 
-  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
-  for (i = 0; i < hal_data->bitLength; i++, offset++) {
-    EC_WRITE_BIT(&pd[offset >> 3], offset & 0x07, uval & 1);
-    uval >>= 1;
+  for (int i = 0; i < hal_data->write_count; i++, pin++) {
+    pin->op(pin, pd);
   }
 }
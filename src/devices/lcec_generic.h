@@ -25,6 +25,11 @@
 #include "../lcec.h"
 #include "../lcec_conf.h"
 
+/// @brief Init-time description of one generic pin, from the XML config.
+///
+/// Filled in by `lcec_parse_config()` in ordinary heap memory.
+/// `lcec_generic_init()` turns it into `lcec_generic_hal_pin_t`
+/// records and frees it.
 typedef struct {
   char name[LCEC_CONF_STR_MAXLEN];
   hal_type_t type;
@@ -34,13 +39,56 @@ typedef struct {
   uint8_t bitOffset;
   uint8_t bitLength;
   hal_pin_dir_t dir;
-  void *pin[LCEC_CONF_GENERIC_MAX_SUBPINS];
   uint16_t pdo_idx;
   uint8_t pdo_sidx;
-  unsigned int pdo_os;
-  unsigned int pdo_bp;
 } lcec_generic_pin_t;
 
+typedef struct lcec_generic_hal_pin lcec_generic_hal_pin_t;
+
+/// @brief Access routine for one generic pin: copies between the pin and the process data.
+typedef void (*lcec_generic_op_t)(lcec_generic_hal_pin_t *pin, uint8_t *pd);
+
+/// @brief Cyclic state of one generic pin, in HAL memory.
+///
+/// Only what `lcec_generic_read()` and `lcec_generic_write()` need, so
+/// the records pack tightly.  The fields from `op` to `sign_shift` are
+/// the pin's access plan, set up by `lcec_generic_post_reg()` once the
+/// PDO offsets are known.
+struct lcec_generic_hal_pin {
+  lcec_generic_op_t op;     ///< Access routine for this pin's type and layout.
+  void *pin;                ///< The pin, or for bit arrays a `hal_bit_t *[bitCount]` array of pins.
+  hal_float_t floatScale;   ///< Float pins only.
+  hal_float_t floatOffset;  ///< Float pins only.
+  unsigned int pdo_os;      ///< Byte offset of the PDO entry in the process data.
+  unsigned int pdo_bp;      ///< Bit position of the PDO entry.
+  unsigned int byte;        ///< Process data byte holding the field's first bit.
+  uint32_t mask;            ///< `bitLength` one bits.
+  uint32_t umax;            ///< Largest unsigned value that fits the field.
+  int32_t smin;             ///< Smallest signed value that fits the field.
+  int32_t smax;             ///< Largest signed value that fits the field.
+  uint8_t type;             ///< `hal_type_t`.
+  uint8_t subType;          ///< `LCEC_PDOENT_TYPE_T`.
+  uint8_t bitOffset;        ///< Offset of a complex entry's field within the PDO entry.
+  uint8_t bitLength;
+  uint8_t bitCount;    ///< Number of bit pins in a bit array, else 0.
+  uint8_t shift;       ///< Bit within `byte` where the field starts.
+  uint8_t wide;        ///< The 8 bytes from `byte` are all inside the process data.
+  uint8_t sign_shift;  ///< `32 - bitLength`, for sign-extending a field.
+};
+
+/// @brief Generic slave HAL data.
+///
+/// Pins read from the device (`HAL_OUT`) come first, then the ones
+/// written to it, so neither cyclic loop has to check the direction.
+typedef struct {
+  int read_count;                ///< Number of `HAL_OUT` pins, at the start of `pins`.
+  int write_count;               ///< Number of `HAL_IN` pins, following them.
+  lcec_generic_hal_pin_t pins[];
+} lcec_generic_data_t;
+
 int lcec_generic_init(int comp_id, struct lcec_slave *slave);
+void lcec_generic_read(lcec_slave_t *slave, long period);
+void lcec_generic_write(lcec_slave_t *slave, long period);
+int lcec_generic_post_reg(lcec_slave_t *slave);
 
 #endif
@@ -135,6 +135,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types2closed, 2, modparams_perchannel_closed, mo
 
 static void lcec_leadshine_stepper_read(lcec_slave_t *slave, long period);
 static void lcec_leadshine_stepper_write(lcec_slave_t *slave, long period);
+static int lcec_leadshine_stepper_post_reg(lcec_slave_t *slave);
 
 typedef struct {
   lcec_class_cia402_channels_t *cia402;
@@ -210,6 +211,7 @@ static int lcec_leadshine_stepper_init(int comp_id, lcec_slave_t *slave) {
   // initialize read/write
   slave->proc_read = lcec_leadshine_stepper_read;
   slave->proc_write = lcec_leadshine_stepper_write;
+  slave->proc_post_reg = lcec_leadshine_stepper_post_reg;
 
   lcec_class_cia402_options_t *options = lcec_cia402_options();
   // XXXX: set which options this device supports.  This controls
@@ -350,7 +352,7 @@ static void lcec_leadshine_stepper_read(lcec_slave_t *slave, long period) {
 
   // XXXX: If you need to read device-specific PDOs and set pins, then you should do this here.
   //
-  // uint8_t *pd = slave->master->process_data;
+  // uint8_t *pd = slave->sync_unit->process_data;
   // *(hal_data->alarm_code) = EC_READ_U16(&pd[hal_data->alarm_code_os]);
 
   lcec_cia402_read_all(slave, hal_data->cia402);
@@ -370,3 +372,11 @@ static void lcec_leadshine_stepper_write(lcec_slave_t *slave, long period) {
 
   lcec_cia402_write_all(slave, hal_data->cia402);
 }
+
+static int lcec_leadshine_stepper_post_reg(lcec_slave_t *slave) {
+  lcec_leadshine_stepper_data_t *hal_data = (lcec_leadshine_stepper_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  lcec_din_plan(slave, hal_data->din);
+  return 0;
+}
@@ -61,6 +61,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types, 4, modparams_perchannel, modparams_base,
 
 static void lcec_lichuan_read(lcec_slave_t *slave, long period);
 static void lcec_lichuan_write(lcec_slave_t *slave, long period);
+static int lcec_lichuan_post_reg(lcec_slave_t *slave);
 
 typedef struct {
   lcec_class_cia402_channels_t *cia402;
@@ -73,6 +74,7 @@ static int lcec_lichuan_init(int comp_id, lcec_slave_t *slave) {
 
   slave->proc_read = lcec_lichuan_read;
   slave->proc_write = lcec_lichuan_write;
+  slave->proc_post_reg = lcec_lichuan_post_reg;
 
   hal_data = LCEC_HAL_ALLOCATE(lcec_lichuan_data_t);
   slave->hal_data = hal_data;
@@ -161,3 +163,10 @@ static void lcec_lichuan_write(lcec_slave_t *slave, long period) {
 
   lcec_cia402_write_all(slave, hal_data->cia402);
 }
+
+static int lcec_lichuan_post_reg(lcec_slave_t *slave) {
+  lcec_lichuan_data_t *hal_data = (lcec_lichuan_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  return 0;
+}
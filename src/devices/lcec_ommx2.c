@@ -71,6 +71,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types, 1, modparams_perchannel, modparams_base,
 
 static void lcec_ommx2_read(lcec_slave_t *slave, long period);
 static void lcec_ommx2_write(lcec_slave_t *slave, long period);
+static int lcec_ommx2_post_reg(lcec_slave_t *slave);
 
 typedef struct {
   lcec_class_cia402_channels_t *cia402;
@@ -130,6 +131,7 @@ static int lcec_ommx2_init(int comp_id, lcec_slave_t *slave) {
   // initialize read/write
   slave->proc_read = lcec_ommx2_read;
   slave->proc_write = lcec_ommx2_write;
+  slave->proc_post_reg = lcec_ommx2_post_reg;
 
   lcec_class_cia402_options_t *options = lcec_cia402_options();
   // XXXX: set which options this device supports.  This controls
@@ -215,7 +217,7 @@ static void lcec_ommx2_read(lcec_slave_t *slave, long period) {
 
   // XXXX: If you need to read device-specific PDOs and set pins, then you should do this here.
   //
-  // uint8_t *pd = slave->master->process_data;
+  // uint8_t *pd = slave->sync_unit->process_data;
   // *(hal_data->alarm_code) = EC_READ_U16(&pd[hal_data->alarm_code_os]);
 
   lcec_cia402_read_all(slave, hal_data->cia402);
@@ -238,3 +240,13 @@ static void lcec_ommx2_write(lcec_slave_t *slave, long period) {
   // XXXX: uncomment for digital out pins:
   //  lcec_dout_write_all(slave, hal_data->dout);
 }
+
+static int lcec_ommx2_post_reg(lcec_slave_t *slave) {
+  lcec_ommx2_data_t *hal_data = (lcec_ommx2_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  // XXXX: uncomment for digital in and out pins:
+  //  lcec_din_plan(slave, hal_data->din);
+  //  lcec_dout_plan(slave, hal_data->dout);
+  return 0;
+}
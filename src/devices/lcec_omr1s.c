@@ -279,9 +279,8 @@ static void lcec_omr1s_check_scales(lcec_omr1s_data_t *hal_data) {
 }
 
 static void lcec_omr1s_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_omr1s_data_t *hal_data = (lcec_omr1s_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint16_t status;
   uint32_t din;
 
@@ -344,9 +343,8 @@ static void lcec_omr1s_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_omr1s_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_omr1s_data_t *hal_data = (lcec_omr1s_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int enable_edge;
   uint16_t control;
 
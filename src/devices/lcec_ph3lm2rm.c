@@ -269,9 +269,8 @@ static int lcec_ph3lm2rm_rm_init(lcec_slave_t *slave, int ios, lcec_ph3lm2rm_rm_
 }
 
 static void lcec_ph3lm2rm_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_ph3lm2rm_data_t *hal_data = (lcec_ph3lm2rm_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_ph3lm2rm_rm_data_t *rm;
   lcec_ph3lm2rm_lm_data_t *lm;
@@ -314,9 +313,8 @@ static void lcec_ph3lm2rm_enc_read(uint8_t *pd, lcec_ph3lm2rm_enc_data_t *ch) {
 }
 
 static void lcec_ph3lm2rm_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_ph3lm2rm_data_t *hal_data = (lcec_ph3lm2rm_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   int i;
   lcec_ph3lm2rm_rm_data_t *rm;
   lcec_ph3lm2rm_lm_data_t *lm;
@@ -168,6 +168,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types, 1, modparams_perchannel, modparams_base,
 
 static void lcec_rtdrv_read(lcec_slave_t *slave, long period);
 static void lcec_rtdrv_write(lcec_slave_t *slave, long period);
+static int lcec_rtdrv_post_reg(lcec_slave_t *slave);
 
 typedef struct {
   lcec_class_cia402_channels_t *cia402;
@@ -265,6 +266,7 @@ static int lcec_rtdrv_init(int comp_id, lcec_slave_t *slave) {
   // initialize read/write
   slave->proc_read = lcec_rtdrv_read;
   slave->proc_write = lcec_rtdrv_write;
+  slave->proc_post_reg = lcec_rtdrv_post_reg;
 
   // Apply default Distributed Clock settings if it's not already set.
   if (slave->dc_conf == NULL) {
@@ -365,3 +367,10 @@ static void lcec_rtdrv_write(lcec_slave_t *slave, long period) {
 
   lcec_cia402_write_all(slave, hal_data->cia402);
 }
+
+static int lcec_rtdrv_post_reg(lcec_slave_t *slave) {
+  lcec_rtdrv_data_t *hal_data = (lcec_rtdrv_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  return 0;
+}
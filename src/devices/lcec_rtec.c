@@ -161,6 +161,7 @@ ADD_TYPES_WITH_CIA402_MODPARAMS(types_closed_x2, 2, modparams_perchannel, modpar
 
 static void lcec_rtec_read(lcec_slave_t *slave, long period);
 static void lcec_rtec_write(lcec_slave_t *slave, long period);
+static int lcec_rtec_post_reg(lcec_slave_t *slave);
 
 static const lcec_lookuptable_int_t rtec_outputfunc[] = {
     {"custom", 0},
@@ -471,6 +472,7 @@ static int lcec_rtec_init(int comp_id, lcec_slave_t *slave) {
   // initialize read/write
   slave->proc_read = lcec_rtec_read;
   slave->proc_write = lcec_rtec_write;
+  slave->proc_post_reg = lcec_rtec_post_reg;
 
   // Apply default Distributed Clock settings if it's not already set.
   if (slave->dc_conf == NULL) {
@@ -575,7 +577,7 @@ static int lcec_rtec_init(int comp_id, lcec_slave_t *slave) {
 
 static void lcec_rtec_read(lcec_slave_t *slave, long period) {
   lcec_rtec_data_t *hal_data = (lcec_rtec_data_t *)slave->hal_data;
-  uint8_t *pd = slave->master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
 
   // wait for slave to be operational
   if (!slave->state.operational) {
@@ -600,3 +602,10 @@ static void lcec_rtec_write(lcec_slave_t *slave, long period) {
 
   lcec_cia402_write_all(slave, hal_data->cia402);
 }
+
+static int lcec_rtec_post_reg(lcec_slave_t *slave) {
+  lcec_rtec_data_t *hal_data = (lcec_rtec_data_t *)slave->hal_data;
+
+  lcec_cia402_plan_all(slave, hal_data->cia402);
+  return 0;
+}
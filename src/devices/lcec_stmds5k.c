@@ -413,9 +413,8 @@ static void lcec_stmds5k_check_scales(lcec_stmds5k_data_t *hal_data) {
 }
 
 static void lcec_stmds5k_read(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_stmds5k_data_t *hal_data = (lcec_stmds5k_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint8_t dev_state;
   uint16_t speed_state;
   int16_t speed_raw, torque_raw;
@@ -477,9 +476,8 @@ static void lcec_stmds5k_read(lcec_slave_t *slave, long period) {
 }
 
 static void lcec_stmds5k_write(lcec_slave_t *slave, long period) {
-  lcec_master_t *master = slave->master;
   lcec_stmds5k_data_t *hal_data = (lcec_stmds5k_data_t *)slave->hal_data;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   uint8_t dev_ctrl;
   double speed_raw, torque_raw;
 
@@ -29,7 +29,10 @@ extern "C" {
 #include "ecrt.h"
 #include "hal.h"
 #include "lcec_conf.h"
+#include "lcec_pll.h"
 #include "lcec_rtapi.h"
+#include "lcec_recorder.h"
+#include "lcec_trace.h"
 #include "rtapi_ctype.h"
 #include "rtapi_math.h"
 #include "rtapi_string.h"
@@ -70,13 +73,31 @@ extern "C" {
 #define LCEC_LICHUAN_VID    0x00000a79
 #define LCEC_RTELLIGENT_VID 0x00000a88
 
-// State update period (ns)
+// State update period (ns), default for the state-poll-period param
 #define LCEC_STATE_UPDATE_PERIOD 1000000000LL
 
 // Consecutive missing DC sync monitor datagrams tolerated before the
 // dc-sync pins are invalidated (see lcec_read_master)
 #define LCEC_DC_SYNC_MISS_MAX 10
 
+// Cycles a per-slave 0x092C register read may stay busy before the
+// round-robin moves on to the next slave, and consecutive DC polls
+// skipped for a busy master lock before dc-sync-converged is cleared
+// (see lcec_poll_dc_diff)
+#define LCEC_DC_DIFF_TIMEOUT 1000
+
+// Longest wait for the master lock in receive/send, as a fraction of
+// the period, before the exchange is skipped (see lcec_master_lock_rt)
+#define LCEC_LOCK_WAIT_DIVIDER 4
+
+// Cycles measured by sync0-tune, as a power of 2 (see lcec_sync0_tune)
+#define LCEC_SYNC0_TUNE_SHIFT  10
+#define LCEC_SYNC0_TUNE_CYCLES (1 << LCEC_SYNC0_TUNE_SHIFT)
+
+// Longest divider window, in master cycles, that automatic Sync Unit
+// phase spreading balances exactly (see lcec_sync_unit_spread_phases)
+#define LCEC_SYNC_UNIT_PHASE_WINDOW 1024
+
 // IDN builder
 #define LCEC_IDN_TYPE_P 0x8000
 #define LCEC_IDN_TYPE_S 0x0000
@@ -89,10 +110,7 @@ extern "C" {
 
 #define LCEC_FSOE_SIZE(ch_count, data_len) (LCEC_FSOE_CMD_LEN + ch_count * (data_len + LCEC_FSOE_CRC_LEN) + LCEC_FSOE_CONNID_LEN)
 
-#define LCEC_MAX_PDO_REG_COUNT   256  ///< The maximum number of calls to lcec_pdo_init() for a single driver.
-#define LCEC_MAX_PDO_ENTRY_COUNT 128  ///< The maximum number of PDO entries in a PDO in a sync.
-#define LCEC_MAX_PDO_INFO_COUNT  16   ///< The maximum number of PDOs in a sync.
-#define LCEC_MAX_SYNC_COUNT      4    ///< The maximum number of syncs.
+#define LCEC_PDO_REG_INITIAL_COUNT 32   ///< Initial room for lcec_pdo_init() calls per slave; grows as needed.
 
 // Memory allocation macros.  These differ from malloc in a couple
 // substantial ways.  First, they check for NULL and call exit(1), so
@@ -123,11 +141,13 @@ extern "C" {
 
 typedef struct lcec_master lcec_master_t;
 typedef struct lcec_slave lcec_slave_t;
+typedef struct lcec_syncs lcec_syncs_t;
 
 typedef int (*lcec_slave_preinit_t)(lcec_slave_t *slave);
 typedef int (*lcec_slave_init_t)(int comp_id, lcec_slave_t *slave);
 typedef void (*lcec_slave_cleanup_t)(lcec_slave_t *slave);
 typedef void (*lcec_slave_rw_t)(lcec_slave_t *slave, long period);
+typedef int (*lcec_slave_post_reg_t)(lcec_slave_t *slave);
 
 typedef enum {
   MODPARAM_TYPE_BIT,    ///< Modparam value is a single bit.
@@ -176,6 +196,123 @@ typedef struct {
   int data_channels;    ///< Number of data channels.
 } LCEC_CONF_FSOE_T;
 
+// RT execution-time statistics (see lcec_timing.c)
+#define LCEC_TIMING_BUCKETS 12  ///< log2 histogram buckets: <1 us, 1-2 us, ..., 512 us-1 ms, >=1 ms
+
+/// @brief Sections timed per master.
+typedef enum {
+  LCEC_TIMING_READ,             ///< Whole `lcec.<m>.read` funct.
+  LCEC_TIMING_RECEIVE,          ///< Lock + `ecrt_master_receive()`.
+  LCEC_TIMING_PROCESS,          ///< Domain processing and master state.
+  LCEC_TIMING_STATE,            ///< Master pin updates and slave state polling.
+  LCEC_TIMING_READ_CALLBACKS,   ///< Driver `proc_read` callbacks.
+  LCEC_TIMING_WRITE,            ///< Whole `lcec.<m>.write` funct.
+  LCEC_TIMING_WRITE_CALLBACKS,  ///< Driver `proc_write` callbacks.
+  LCEC_TIMING_SEND,             ///< Lock, domain queueing, DC datagrams and `ecrt_master_send()`.
+  LCEC_TIMING_MASTER_COUNT
+} lcec_timing_master_section_t;
+
+/// @brief Sections timed globally.
+typedef enum {
+  LCEC_TIMING_READ_ALL,   ///< Whole `lcec.read-all` funct.
+  LCEC_TIMING_WRITE_ALL,  ///< Whole `lcec.write-all` funct.
+  LCEC_TIMING_GLOBAL_COUNT
+} lcec_timing_global_section_t;
+
+/// @brief Execution-time statistics for one timed section.
+typedef struct {
+  hal_u32_t *min;                        ///< Output: shortest run since reset (ns).
+  hal_u32_t *max;                        ///< Output: longest run since reset (ns).
+  hal_u32_t *mean;                       ///< Output: mean run time since reset (ns).
+  hal_u32_t *hist[LCEC_TIMING_BUCKETS];  ///< Output: number of runs per log2 bucket.
+  uint64_t sum;                          ///< Internal: total run time since reset (ns).
+  uint32_t count;                        ///< Internal: number of runs since reset.
+} lcec_timing_stat_t;
+
+/// @brief Execution-time statistics for a set of sections.
+typedef struct {
+  hal_bit_t enable;            ///< Param: take timestamps (default off).
+  hal_bit_t *reset;            ///< IO: set to 1 to clear all stats; self-clears.
+  int active;                  ///< Internal: `enable` latched at the start of the outermost funct.
+  int depth;                   ///< Internal: timed functs currently running, e.g. `receive` inside `read`.
+  int stat_count;              ///< Number of entries in `stats`.
+  lcec_timing_stat_t stats[];  ///< One entry per section.
+} lcec_timing_t;
+
+/// @brief Process-image flight recorder of one master, see `lcec_recorder.h`.
+typedef struct {
+  hal_bit_t *frozen;          ///< Output: recording stopped on a trigger.
+  hal_u32_t *reason;          ///< Output: `LCEC_RECORDER_TRIGGER_*` that froze it.
+  hal_bit_t *trigger;         ///< Input: a rising edge fires a trigger.
+  hal_bit_t *rearm;           ///< IO: set to 1 to clear and restart recording; self-clears.
+  hal_bit_t trigger_wkc;      ///< Param: trigger when `wkc-state` leaves complete (default on).
+  hal_bit_t trigger_oper;     ///< Param: trigger when a slave leaves OP (default on).
+  hal_u32_t post_cycles;      ///< Param: cycles to keep recording after a trigger (default 0).
+  lcec_recorder_shm_t *shm;   ///< Internal: shared header.
+  uint8_t *frames;            ///< Internal: first frame in `shm`.
+  int shmem_id;               ///< Internal: shared memory id.
+  int trigger_last;           ///< Internal: `trigger` in the previous cycle.
+  uint32_t pending;           ///< Internal: trigger waiting for `post_remaining` cycles.
+  uint32_t post_remaining;    ///< Internal: cycles left before freezing.
+} lcec_recorder_t;
+
+#define LCEC_SDO_PRIO_HIGH   0  ///< SDO scheduler priority: writes that change how the machine moves, e.g. limits.
+#define LCEC_SDO_PRIO_NORMAL 1  ///< SDO scheduler priority: ordinary parameter writes.
+#define LCEC_SDO_PRIO_LOW    2  ///< SDO scheduler priority: bulk or cosmetic writes.
+#define LCEC_SDO_PRIO_COUNT  3
+
+#define LCEC_SDO_IDLE    0  ///< `lcec_sdo_entry_t.status`: never written.
+#define LCEC_SDO_QUEUED  1  ///< `lcec_sdo_entry_t.status`: waiting for a free slot.
+#define LCEC_SDO_BUSY    2  ///< `lcec_sdo_entry_t.status`: write in flight.
+#define LCEC_SDO_DONE    3  ///< `lcec_sdo_entry_t.status`: last write succeeded.
+#define LCEC_SDO_ABORTED 4  ///< `lcec_sdo_entry_t.status`: last write was aborted by the slave or timed out.
+
+/// @brief The SDO request calls used by the SDO scheduler.
+///
+/// `lcec_sdo_ecrt_backend` outside of tests.
+typedef struct {
+  ec_request_state_t (*state)(ec_sdo_request_t *req);  ///< Like `ecrt_sdo_request_state()`.
+  uint8_t *(*data)(ec_sdo_request_t *req);             ///< Like `ecrt_sdo_request_data()`.
+  void (*write)(ec_sdo_request_t *req);                ///< Like `ecrt_sdo_request_write()`.
+} lcec_sdo_backend_t;
+
+/// @brief One object written through the SDO scheduler.
+typedef struct lcec_sdo_entry {
+  struct lcec_sdo_entry *next;  ///< Internal: next entry in the same queue or in the in-flight list.
+  struct lcec_sdo_entry *link;  ///< Internal: next registered entry.
+  ec_sdo_request_t *request;    ///< Request, created before activation.
+  int slave_index;              ///< Slave position, for reporting.
+  uint16_t index;               ///< Object index.
+  uint8_t subindex;             ///< Object subindex.
+  uint8_t size;                 ///< Object size in bytes: 1, 2 or 4.
+  int prio;                     ///< `LCEC_SDO_PRIO_*`.
+  int status;                   ///< `LCEC_SDO_*`.
+  int pending;                  ///< Internal: a new value arrived while a write was in flight.
+  uint32_t dirty;               ///< Internal: writes since the scheduler last looked, shared with the writer.
+  uint32_t value;               ///< Latest value passed to `lcec_sdo_sched_write()`, shared with the writer.
+  uint32_t sent;                ///< Value of the write in flight, or of the last one.
+} lcec_sdo_entry_t;
+
+/// @brief Per-master queue of runtime SDO writes, see `lcec_sdo_sched.c`.
+typedef struct {
+  hal_u32_t max_in_flight;                       ///< Param: writes in flight at once (default 4).
+  hal_u32_t *queued;                             ///< Output: writes waiting for a slot.
+  hal_u32_t *in_flight;                          ///< Output: writes in flight.
+  hal_u32_t *completed;                          ///< Output: writes completed.
+  hal_u32_t *aborted;                            ///< Output: writes aborted.
+  hal_u32_t *coalesced;                          ///< Output: writes replaced by a newer value before they started.
+  hal_s32_t *last_abort_slave;                   ///< Output: slave position of the last aborted write, or -1.
+  hal_u32_t *last_abort_object;                  ///< Output: index << 8 | subindex of the last aborted write.
+  const lcec_sdo_backend_t *backend;             ///< Internal: request calls.
+  lcec_master_t *master;                         ///< Internal: the master, for tracing.
+  lcec_sdo_entry_t *entries;                     ///< Internal: all registered entries.
+  lcec_sdo_entry_t *head[LCEC_SDO_PRIO_COUNT];  ///< Internal: first queued entry per priority.
+  lcec_sdo_entry_t *tail[LCEC_SDO_PRIO_COUNT];  ///< Internal: last queued entry per priority.
+  lcec_sdo_entry_t *busy;                        ///< Internal: entries with a write in flight.
+  uint32_t queued_count;                         ///< Internal: entries in all queues.
+  uint32_t busy_count;                           ///< Internal: entries in `busy`.
+} lcec_sdo_sched_t;
+
 typedef struct lcec_master_data {
   hal_u32_t *slaves_responding;
   hal_bit_t *state_init;
@@ -191,13 +328,26 @@ typedef struct lcec_master_data {
   hal_u32_t pll_max_err;
   hal_u32_t *pll_reset_cnt;
   hal_u32_t dc_phase_max_err;
-  hal_s32_t *app_phase;         // Our execution phase in local cycle (ns, real-time)
-  hal_bit_t *dc_phased;         // PLL lock status indicator
-  hal_s32_t *phase_jitter_out;  // Output: measured app_phase jitter amplitude (ns)
-  hal_s32_t *drift_mode;        // Input: 0=simple, 1=manual
-  hal_s32_t *pll_drift;         // Input: debug offset added to PLL correction (ns)
-  hal_s32_t *pll_final;         // Output: final PLL correction value sent to rtapi (ns)
-  int32_t auto_drift_delay;     // Internal: auto-drift delay counter
+  hal_s32_t *app_phase;          // Our execution phase in local cycle (ns, real-time)
+  hal_bit_t *dc_phased;          // PLL lock status indicator
+  hal_s32_t *phase_jitter_out;   // Output: measured app_phase jitter amplitude (ns)
+  hal_s32_t *phase_jitter_p50;   // Output: median cycle-to-cycle app_phase change (ns)
+  hal_s32_t *phase_jitter_p99;   // Output: 99th percentile of the same (ns)
+  hal_s32_t *phase_jitter_p999;  // Output: 99.9th percentile of the same (ns)
+  hal_bit_t *phase_recalibrate;  // IO: set to 1 to re-derive the app_phase target now; self-clears
+  hal_bit_t phase_retarget;      // Param: re-derive the app_phase target as the jitter changes
+  hal_s32_t *drift_mode;         // Input: 0=simple, 1=manual
+  hal_s32_t *pll_drift;          // Input: debug offset added to PLL correction (ns)
+  hal_s32_t *pll_final;          // Output: final PLL correction value sent to rtapi (ns)
+  hal_u32_t pll_controller;      // Param: LCEC_PLL_BANG_BANG (default) or LCEC_PLL_PI
+  hal_float_t pll_kp;            // Param: PI proportional gain (ns out per ns error)
+  hal_float_t pll_ki;            // Param: PI integral gain, per cycle
+  hal_u32_t pll_max_out;         // Param: PI output and integrator limit (ns)
+  hal_float_t *pll_integrator;   // Output: PI integrator state (ns)
+  hal_float_t *pll_lock_time;    // Output: time from activation or the last PLL reset until dc-phased (s)
+  hal_bit_t *sync0_tune;         // IO: set to 1 to measure the send phase and compute safe sync0Shift values; self-clears
+  hal_u32_t sync0_margin;        // Param: margin added to the computed sync0Shift (ns)
+  hal_s32_t *sync0_send_phase;   // Output: latest app_phase at which the frame left during the last measurement (ns)
 #endif
   // Domain working counter monitoring
   hal_u32_t *wkc;             // Output: current domain working counter
@@ -213,14 +363,24 @@ typedef struct lcec_master_data {
   hal_u32_t dc_sync_max;         // Param: convergence threshold (ns)
   hal_bit_t dc_sync_monitor;     // Param: enable the per-cycle monitor datagram (default on)
   int dc_sync_miss_cnt;          // Internal: consecutive cycles without a monitor response
-  // Phase calibration for sync_to_ref_clock=false mode
-  int32_t phase_measure_cnt;  // Internal: measurement cycle counter
-  int32_t phase_min;          // Internal: minimum app_phase during measurement
-  int32_t phase_max;          // Internal: maximum app_phase during measurement
-  int32_t phase_last;         // Internal: last app_phase value (for boundary detection)
-  int32_t phase_jitter;       // Internal: calculated jitter amplitude
-  int32_t phase_target;       // Internal: target app_phase position
-  int32_t phase_calibrated;   // Internal: 0=measuring, 1=calibrated
+  int dc_skip_cnt;               // Internal: consecutive DC polls skipped because the master lock was busy
+  // Per-slave DC system time difference (register requests for 0x092C, round-robin)
+  hal_s32_t *dc_worst_slave;   // Output: index of the slave with the largest |dc-time-diff| in the last sweep, -1 if none
+  hal_u32_t *dc_worst_diff;    // Output: that slave's |dc-time-diff| (ns)
+  hal_bit_t dc_slave_monitor;  // Param: read every DC slave's 0x092C in turn, one per cycle (default on)
+  // Process data scheduling
+  hal_u32_t *queued_bytes;  // Output: process data bytes of the Sync Units queued this cycle
+  // Slave state polling
+  hal_u32_t state_poll_period;  // Param: time for one round-robin sweep over all slaves (ns)
+  hal_u32_t state_poll_batch;   // Param: slaves polled per cycle; 0 = spread evenly over state_poll_period
+  // Non-operational slaves
+  hal_u32_t *slaves_skipped;  // Output: slaves whose read/write functions are skipped
+  hal_bit_t skip_non_op;      // Param: skip read/write functions of slaves that are not operational (default on)
+  hal_bit_t safe_outputs;     // Param: clear the outputs of skipped slaves
+  // Master lock contention in the cyclic path
+  hal_u32_t *lock_wait_cnt;   // Output: times receive/send had to wait for the master lock
+  hal_u32_t *lock_wait_max;   // Output: longest of those waits (ns)
+  hal_u32_t *lock_defer_cnt;  // Output: optional work items (state polls, DC monitor) deferred because the lock was busy
 } lcec_master_data_t;
 
 typedef struct lcec_slave_state {
@@ -230,6 +390,9 @@ typedef struct lcec_slave_state {
   hal_bit_t *state_preop;   ///< Is the device in state `PREOP`?  Equivalant to the `.slave-state-preop` HAL pin.
   hal_bit_t *state_safeop;  ///< Is the device in state `SAFEOP`?  Equivalant to the `.slave-state-safeop` HAL pin.
   hal_bit_t *state_op;      ///< Is the device in state `OP`?  Equivalant to the `.slave-state-op` HAL pin.
+  hal_s32_t *dc_time_diff;  ///< DC system time difference (0x092C), signed ns.  Only for slaves with DC configured.
+  hal_s32_t *sync0_shift_safe;  ///< Smallest safe `sync0Shift` from the last `sync0-tune` measurement.  Only with DC.
+  hal_s32_t *sync0_latency;     ///< Input-to-actuation latency at `sync0_shift_safe` (ns).  Only with DC.
 } lcec_slave_state_t;
 
 typedef struct lcec_pdo_entry_reg {
@@ -238,13 +401,27 @@ typedef struct lcec_pdo_entry_reg {
   ec_pdo_entry_reg_t *pdo_entry_regs;
 } lcec_pdo_entry_reg_t;
 
+/// @brief One entry in a Sync Unit's flattened cyclic dispatch table.
+///
+/// Built once at startup from the slave list, so the RT read/write path
+/// walks a contiguous array instead of chasing `lcec_slave_t` pointers.
+typedef struct {
+  lcec_slave_rw_t proc_read;   ///< Copy of `slave->proc_read`, may be NULL.
+  lcec_slave_rw_t proc_write;  ///< Copy of `slave->proc_write`, may be NULL.
+  lcec_slave_t *slave;         ///< Slave passed to the callbacks.
+  unsigned int safe_offset;    ///< First byte of the slave's registered outputs in the process data.
+  unsigned int safe_len;       ///< Bytes to clear for the safe output pattern; 0 if the outputs are unknown.
+} lcec_dispatch_t;
+
 typedef struct lcec_sync_unit {
   struct lcec_sync_unit *prev;
   struct lcec_sync_unit *next;
+  lcec_master_t *master;
   char name[LCEC_CONF_STR_MAXLEN];
   uint32_t cycle_time;
   unsigned int cycle_divider;
   unsigned int cycle_counter;
+  int cycle_phase;  ///< Master cycle within the divider window of the first exchange; LCEC_CONF_SYNC_UNIT_PHASE_AUTO until spread.
   int pdo_entry_count;
   lcec_pdo_entry_reg_t *regs;
   ec_domain_t *domain;
@@ -253,6 +430,15 @@ typedef struct lcec_sync_unit {
   int queued;
   int process;
   int write;
+  int own_functs;             ///< Callbacks run from the Sync Unit's own read/write functs instead of the master's.
+  unsigned long mutex;        ///< Held by the master from queueing until the frame is received, if `own_functs`.
+  int in_flight;              ///< The master holds `mutex`.
+  int dispatch_count;         ///< Number of entries in `dispatch`.
+  lcec_dispatch_t *dispatch;  ///< Callbacks of every slave in this Sync Unit that has a read or write function.
+  uint32_t *oper_mask;        ///< Bit per `dispatch` entry: slave was operational when last polled.
+  uint32_t *read_mask;        ///< Bit per `dispatch` entry: call `proc_read`.
+  uint32_t *write_mask;       ///< Bit per `dispatch` entry: call `proc_write`.
+  int safe_outputs;           ///< Copy of the master's `safe-outputs` param.
 } lcec_sync_unit_t;
 
 typedef struct lcec_master {
@@ -264,14 +450,29 @@ typedef struct lcec_master {
   unsigned long mutex;              ///< Mutex for locking operations.
   ec_pdo_entry_reg_t *pdo_entry_regs;
   ec_domain_t *domain;
-  uint8_t *process_data;
-  int process_data_len;
   lcec_sync_unit_t *first_sync_unit;
   lcec_sync_unit_t *last_sync_unit;
   int sync_units_started;
   lcec_slave_t *first_slave;
   lcec_slave_t *last_slave;
+  lcec_slave_t *first_dc_slave;     ///< First slave with a 0x092C register request, see `lcec_slave_t.dc_next`.
+  lcec_slave_t *last_dc_slave;
+  lcec_slave_t *dc_diff_slave;      ///< Slave whose 0x092C read was started last, or NULL.
+  int dc_diff_pending;              ///< That read has not completed yet.
+  int dc_diff_wait;                 ///< Cycles spent waiting for it.
+  uint32_t dc_diff_worst;           ///< Largest |dc-time-diff| so far in this sweep.
+  int dc_diff_worst_index;          ///< Slave index of `dc_diff_worst`, or -1.
+  int slave_count;                  ///< Number of slaves in the slave list.
+  lcec_slave_t *state_poll_next;    ///< Next slave for round-robin state polling.
+  int slaves_skipped;               ///< Slaves whose callbacks are skipped because they are not operational.
+  int dc_sync_queued;               ///< A DC synchrony monitor datagram is waiting to be processed.
   lcec_master_data_t *hal_data;
+  lcec_timing_t *timing;            ///< RT execution-time statistics.
+  lcec_trace_ring_t *trace;         ///< RT event trace, or NULL.
+  int recorder_cycles;              ///< Cycles kept by the flight recorder; 0 if disabled.
+  lcec_recorder_t *recorder;        ///< Flight recorder, or NULL.
+  lcec_sdo_sched_t *sdo_sched;      ///< Runtime SDO write scheduler.
+  int trace_shmem_id;
   uint64_t app_time_base;
   uint32_t app_time_period;
   long period_last;
@@ -286,9 +487,11 @@ typedef struct lcec_master {
   int forgot_warned;    // One-shot guard for the "user forgot initf lcec.activate" warning in lcec_write_master
 #ifdef RTAPI_TASK_PLL_SUPPORT
   uint64_t dc_ref;
-  uint64_t dc_ref_time;  // DC reference time (epoch) - set on first app_time call
-  uint32_t app_time_last;
-  int dc_time_valid_last;  // Previous cycle's dc_time_valid (for detecting consecutive valid reads)
+  lcec_pll_t pll;  // Servo thread PLL controller
+  int sync0_tune_cnt;          // Cycles measured so far for sync0-tune
+  int32_t sync0_send_max;      // Latest send phase seen by sync0-tune
+  long long sync0_send_sum;    // Sum of the send phases seen by sync0-tune
+  uint32_t sync0_bytes_max;    // Most process data queued in one cycle during sync0-tune
 #endif
 } lcec_master_t;
 
@@ -337,6 +540,7 @@ typedef struct lcec_slave {
   lcec_slave_t *next;                         ///< Previous slave
   lcec_master_t *master;                      ///< Master for this slave
   lcec_sync_unit_t *sync_unit;                ///< Process-data Sync Unit containing this slave.
+  int dispatch_index;                         ///< Entry in `sync_unit->dispatch`, or -1.
   int index;                                  ///< Index of this slave.
   char name[LCEC_CONF_STR_MAXLEN];            ///< Slave name.
   char sync_unit_name[LCEC_CONF_STR_MAXLEN];  ///< Configured Sync Unit name.
@@ -347,12 +551,15 @@ typedef struct lcec_slave {
   ec_slave_config_t *config;                  ///< Configuration data.
   ec_slave_config_state_t state;              ///< Slave state.
   lcec_slave_dc_t *dc_conf;                   ///< Distributed Clock configuration.
+  ec_reg_request_t *dc_diff_req;              ///< Register request reading 0x092C, or NULL.
+  lcec_slave_t *dc_next;                      ///< Next slave with `dc_diff_req`.
   lcec_slave_watchdog_t *wd_conf;             ///< Watchdog configuration.
   lcec_slave_preinit_t proc_preinit;          ///< Callback for pre-init, if any.
   lcec_slave_init_t proc_init;                ///< Callback for initializing device.
   lcec_slave_cleanup_t proc_cleanup;          ///< Calback for cleaning up the device.
   lcec_slave_rw_t proc_read;                  ///< Callback for reading from the device.
   lcec_slave_rw_t proc_write;                 ///< Callback for writing to the device.
+  lcec_slave_post_reg_t proc_post_reg;        ///< Callback once the PDO offsets are filled in, if any.
   lcec_slave_state_t *hal_state_data;         ///< HAL state data.
   void *hal_data;                             ///< HAL data, device driver specific.
   int generic_pdo_entry_count;                ///< The number of generic PDO entries.
@@ -368,6 +575,7 @@ typedef struct lcec_slave {
   unsigned int *fsoe_master_offset;           ///< FSoE master offset.
   uint64_t flags;                             ///< Flags, as defined by the driver itself.
   lcec_pdo_entry_reg_t *regs;
+  lcec_syncs_t *syncs;  ///< Layout passed to `lcec_syncs_init()`, compacted after `proc_init`.
 } lcec_slave_t;
 
 /// @brief HAL pin description.
@@ -387,19 +595,28 @@ typedef struct {
 } lcec_paramdesc_t;
 
 /// @brief Sync manager configuration.
-typedef struct {
-  lcec_slave_t *slave;                            ///< For debugging messages
-  int sync_count;                                 ///< Number of syncs.
-  ec_sync_info_t *curr_sync;                      ///< Current sync.
-  ec_sync_info_t syncs[LCEC_MAX_SYNC_COUNT + 1];  ///< Sync definitions.
-
-  int pdo_info_count;                                    ///< Number of PDO infos.
-  ec_pdo_info_t *curr_pdo_info;                          ///< Current PDO info.
-  ec_pdo_info_t pdo_infos[LCEC_MAX_PDO_INFO_COUNT + 1];  ///< PDO info definitions.
-
-  int pdo_entry_count;                                            ///< Total number of PDO entries for slave.
-  ec_pdo_entry_info_t *curr_pdo_entry;                            ///< Current PDO entry.
-  ec_pdo_entry_info_t pdo_entries[LCEC_MAX_PDO_ENTRY_COUNT + 1];  ///< PDO entry definitions.
+///
+/// The `lcec_syncs_add_*` calls build the layout in scratch arrays that
+/// grow on demand.  Once `proc_init` returns, `lcec_syncs_compact()`
+/// moves it into one exactly-sized block and frees the scratch arrays.
+/// `syncs` always points at the current layout, so drivers keep setting
+/// `slave->sync_info = &syncs->syncs[0]`.
+typedef struct lcec_syncs {
+  lcec_slave_t *slave;        ///< For debugging messages
+  int sync_count;             ///< Number of syncs.
+  int sync_max;               ///< Room in `syncs`, including the terminator.
+  ec_sync_info_t *curr_sync;  ///< Current sync.
+  ec_sync_info_t *syncs;      ///< Sync definitions.
+
+  int pdo_info_count;            ///< Number of PDO infos.
+  int pdo_info_max;              ///< Room in `pdo_infos`.
+  ec_pdo_info_t *curr_pdo_info;  ///< Current PDO info.
+  ec_pdo_info_t *pdo_infos;      ///< PDO info definitions.
+
+  int pdo_entry_count;                  ///< Total number of PDO entries for slave.
+  int pdo_entry_max;                    ///< Room in `pdo_entries`.
+  ec_pdo_entry_info_t *curr_pdo_entry;  ///< Current PDO entry.
+  ec_pdo_entry_info_t *pdo_entries;     ///< PDO entry definitions.
 
   int autoflow;         ///< If true, then adding new PDO entries will automatically start a new PDO at `pdo_entry_limit`
   int pdo_entry_limit;  ///< Device limit on the number of PDO entries per PDO
@@ -409,6 +626,8 @@ typedef struct {
   int error;  ///< Sticky overflow flag: set nonzero when any `lcec_syncs_add_*` call could not fit.
               ///< Drivers that build a layout from configuration (e.g. modular couplers) can make all
               ///< the add calls and then check this once, instead of the return value of every call.
+  int compacted;  ///< The layout has been moved into its final block; no more adds.
+  size_t size;    ///< Bytes in the final block, once compacted.
 } lcec_syncs_t;
 
 /// @brief Lookup table mapping string to int
@@ -454,16 +673,15 @@ void lcec_syncs_init(lcec_slave_t *slave, lcec_syncs_t *syncs) __attribute__((no
 void lcec_syncs_enable_autoflow(lcec_slave_t *slave, lcec_syncs_t *syncs, int pdo_limit, int pdo_entry_limit, int pdo_increment);
 /// @brief Append a sync manager / PDO / PDO entry to a `lcec_syncs_t` layout.
 ///
-/// Each returns 0 on success and -1 when the corresponding fixed buffer
-/// (`LCEC_MAX_SYNC_COUNT` / `LCEC_MAX_PDO_INFO_COUNT` / `LCEC_MAX_PDO_ENTRY_COUNT`)
-/// is full, in which case nothing is added.  The failure is also recorded
-/// stickily in `syncs->error`, so a driver that builds a variable-sized layout
-/// in a loop may ignore the individual return values and check `syncs->error`
-/// once after building.  Callers that ignore both (the common static case, which
-/// cannot overflow) keep their previous behavior.
+/// Each returns 0 on success and -1 when the entry can't be added: the
+/// autoflow `pdo_limit` is reached, or the layout was already compacted.
+/// The failure is also recorded stickily in `syncs->error`, so a driver
+/// that builds a variable-sized layout in a loop may ignore the
+/// individual return values and check `syncs->error` once after building.
 int lcec_syncs_add_sync(lcec_syncs_t *syncs, ec_direction_t dir, ec_watchdog_mode_t watchdog_mode);
 int lcec_syncs_add_pdo_info(lcec_syncs_t *syncs, uint16_t index);
 int lcec_syncs_add_pdo_entry(lcec_syncs_t *syncs, uint16_t index, uint8_t subindex, uint8_t bit_length);
+ec_sync_info_t *lcec_syncs_compact(lcec_syncs_t *syncs) __attribute__((nonnull));
 
 const lcec_typelist_t *lcec_findslavetype(const char *name) __attribute__((nonnull));
 void lcec_addtype(lcec_typelist_t *type, const char *sourcefile) __attribute__((nonnull));
@@ -483,8 +701,119 @@ lcec_pdo_entry_reg_t *lcec_allocate_pdo_entry_reg(int size);
 int lcec_pdo_init(lcec_slave_t *slave, uint16_t idx, uint16_t sidx, unsigned int *os, unsigned int *bp);
 int lcec_pdo_entry_reg_len(lcec_pdo_entry_reg_t *reg);
 int lcec_append_pdo_entry_reg(lcec_pdo_entry_reg_t *dest, lcec_pdo_entry_reg_t *src);
+void lcec_free_pdo_entry_reg(lcec_pdo_entry_reg_t *reg);
+
+int lcec_sync_unit_build_dispatch(lcec_master_t *master, lcec_sync_unit_t *sync_unit) __attribute__((nonnull));
+int lcec_sync_unit_spread_phases(lcec_master_t *master) __attribute__((nonnull));
+int lcec_sync_unit_set_oper(lcec_sync_unit_t *sync_unit, int index, int oper) __attribute__((nonnull));
+void lcec_sync_unit_read(lcec_master_t *master, lcec_sync_unit_t *sync_unit) __attribute__((nonnull));
+void lcec_sync_unit_write(lcec_master_t *master, lcec_sync_unit_t *sync_unit) __attribute__((nonnull));
+
+lcec_timing_t *lcec_timing_init(const char *pfx, const char *const *section_names, int section_count);
+void lcec_timing_add(lcec_timing_t *timing, int section, long long ns);
+void lcec_timing_reset(lcec_timing_t *timing);
+
+lcec_recorder_t *lcec_recorder_init(lcec_master_t *master, const char *pfx, int cycles) __attribute__((nonnull));
+void lcec_recorder_free(lcec_recorder_t *rec) __attribute__((nonnull));
+uint8_t *lcec_recorder_begin(lcec_recorder_t *rec) __attribute__((nonnull));
+void lcec_recorder_end(lcec_recorder_t *rec, uint32_t fresh, uint32_t wkc, int wkc_state) __attribute__((nonnull));
+void lcec_recorder_trigger(lcec_recorder_t *rec, int reason) __attribute__((nonnull));
+
+extern const lcec_sdo_backend_t lcec_sdo_ecrt_backend;
+lcec_sdo_sched_t *lcec_sdo_sched_init(lcec_master_t *master, const char *pfx) __attribute__((nonnull));
+lcec_sdo_entry_t *lcec_sdo_sched_add_request(
+    lcec_sdo_sched_t *sched, ec_sdo_request_t *request, int slave_index, uint16_t index, uint8_t subindex, size_t size, int prio);
+lcec_sdo_entry_t *lcec_sdo_sched_add(lcec_slave_t *slave, uint16_t index, uint8_t subindex, size_t size, int prio) __attribute__((nonnull));
+void lcec_sdo_sched_write(lcec_sdo_entry_t *entry, uint32_t value) __attribute__((nonnull));
+void lcec_sdo_sched_run(lcec_sdo_sched_t *sched) __attribute__((nonnull));
+
+/// @brief Start timing an exported funct.
+///
+/// The outermost funct, e.g. `read` but not the `receive` and `inputs`
+/// it calls, applies a pending reset and latches `timing->enable` for
+/// the whole cycle.  Returns the start timestamp (0 when disabled).
+/// Every call must be matched by `lcec_timing_end()`.
+static inline long long lcec_timing_begin(lcec_timing_t *timing) {
+  if (timing->depth++ == 0) {
+    if (*(timing->reset)) {
+      lcec_timing_reset(timing);
+    }
+    timing->active = timing->enable;
+  }
+  return timing->active ? rtapi_get_time() : 0;
+}
+
+/// @brief Account the time since `*mark` to `section` and move `*mark` to now.
+static inline void lcec_timing_mark(lcec_timing_t *timing, int section, long long *mark) {
+  if (timing->active) {
+    long long now = rtapi_get_time();
+    lcec_timing_add(timing, section, now - *mark);
+    *mark = now;
+  }
+}
+
+/// @brief Account the time since `start` to `section` and end the funct.
+static inline void lcec_timing_end(lcec_timing_t *timing, int section, long long start) {
+  if (timing->active) {
+    lcec_timing_add(timing, section, rtapi_get_time() - start);
+  }
+  timing->depth--;
+}
+
+/// @brief Append an event to a master's trace ring.
+///
+/// Only call this from the master's own thread (or during init): the
+/// ring has a single writer and no lock.
+static inline void lcec_trace_event(lcec_trace_ring_t *ring, int type, int slave, uint32_t a, uint32_t b) {
+  lcec_trace_event_t *ev;
+  uint32_t head;
+
+  if (ring == NULL) {
+    return;
+  }
+  head = ring->head;
+  ev = &ring->events[head & (LCEC_TRACE_SIZE - 1)];
+  ev->time = rtapi_get_time();
+  ev->type = type;
+  ev->slave = slave;
+  ev->a = a;
+  ev->b = b;
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/// @brief Load up to 8 bytes of process data from byte `os` as one little-endian word.
+///
+/// Uses a single 64-bit load when all 8 bytes are inside the `len`
+/// bytes of process data; bytes past the end read as 0.
+static inline uint64_t lcec_pd_read_window(const uint8_t *pd, unsigned int os, unsigned int len) {
+  uint64_t raw = 0;
+
+  if (os + 8 <= len) {
+    return EC_READ_U64(&pd[os]);
+  }
+  for (unsigned int i = 0; os + i < len; i++) {
+    raw |= (uint64_t)pd[os + i] << (i * 8);
+  }
+  return raw;
+}
+
+/// @brief Replace the `mask` bits of the word at byte `os` with `val`.
+///
+/// The counterpart of `lcec_pd_read_window()`; bits outside `mask`
+/// and bytes past the end of the process data are left alone.
+static inline void lcec_pd_write_window(uint8_t *pd, unsigned int os, unsigned int len, uint64_t mask, uint64_t val) {
+  if (os + 8 <= len) {
+    EC_WRITE_U64(&pd[os], (EC_READ_U64(&pd[os]) & ~mask) | (val & mask));
+    return;
+  }
+  for (unsigned int i = 0; os + i < len; i++) {
+    uint8_t m = mask >> (i * 8);
+    pd[os + i] = (pd[os + i] & ~m) | ((uint8_t)(val >> (i * 8)) & m);
+  }
+}
 
 void *lcec_hal_malloc(size_t size, const char *file, const char *func, int line);
 void *lcec_malloc(size_t size, const char *file, const char *func, int line);
+size_t lcec_hal_malloc_total(void);
 
 #endif
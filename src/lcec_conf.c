@@ -299,6 +299,17 @@ static void parseMasterAttrs(LCEC_CONF_XML_INST_T *inst, int next, const char **
       continue;  // TODO: A general function that can handle four states: yes, no, not given, wrong. Recognize yes/on/true/1/enabled as true
     }
 
+    // parse recorderCycles
+    if (strcmp(name, "recorderCycles") == 0) {
+      p->recorderCycles = atoi(val);
+      if (p->recorderCycles < 0) {
+        fprintf(stderr, "%s: ERROR: recorderCycles=%s invalid, must be 0 or positive\n", modname, val);
+        XML_StopParser(inst->parser, 0);
+        return;
+      }
+      continue;
+    }
+
     // handle error
     fprintf(stderr, "%s: ERROR: Invalid master attribute %s\n", modname, name);
     XML_StopParser(inst->parser, 0);
@@ -449,6 +460,27 @@ static void parseSlaveAttrs(LCEC_CONF_XML_INST_T *inst, int next, const char **a
       continue;
     }
 
+    if (strcmp(name, "syncUnitPhase") == 0) {
+      if (strcasecmp(val, "auto") == 0) {
+        p->syncUnitPhase = LCEC_CONF_SYNC_UNIT_PHASE_AUTO;
+        continue;
+      }
+      char *end;
+      long phase = strtol(val, &end, 10);
+      if (*val == 0 || *end != 0 || phase < 0) {
+        fprintf(stderr, "%s: ERROR: Invalid syncUnitPhase %s\n", modname, val);
+        XML_StopParser(inst->parser, 0);
+        return;
+      }
+      p->syncUnitPhase = phase;
+      continue;
+    }
+
+    if (strcmp(name, "syncUnitFuncts") == 0) {
+      p->syncUnitFuncts = (strcasecmp(val, "true") == 0);
+      continue;
+    }
+
     if (strcmp(name, "vid") == 0) {
       p->vid = strtol(val, NULL, 16);
       continue;
@@ -494,6 +526,13 @@ static void parseSlaveAttrs(LCEC_CONF_XML_INST_T *inst, int next, const char **a
     return;
   }
 
+  if (p->syncUnitPhase >= 0 && (uint32_t)p->syncUnitPhase >= p->syncUnitCycle / state->currMaster->appTimePeriod) {
+    fprintf(stderr, "%s: ERROR: Slave %s syncUnitPhase %d must be less than the syncUnitCycle divider %u\n", modname, p->name,
+        p->syncUnitPhase, p->syncUnitCycle / state->currMaster->appTimePeriod);
+    XML_StopParser(inst->parser, 0);
+    return;
+  }
+
   // type is required
   if (!valid) {
     fprintf(stderr, "%s: ERROR: Slave type is invalid\n", modname);
@@ -1040,6 +1079,11 @@ static void parsePdoEntryAttrs(LCEC_CONF_XML_INST_T *inst, int next, const char
         p->halType = HAL_BIT;
         continue;
       }
+      if (strcasecmp(val, "bit-packed") == 0) {
+        p->subType = lcecPdoEntTypeBitPacked;
+        p->halType = HAL_U32;
+        continue;
+      }
       if (strcasecmp(val, "s32") == 0) {
         p->subType = lcecPdoEntTypeSimple;
         p->halType = HAL_S32;
@@ -1192,6 +1236,11 @@ static void parseComplexEntryAttrs(LCEC_CONF_XML_INST_T *inst, int next, const c
         p->halType = HAL_BIT;
         continue;
       }
+      if (strcasecmp(val, "bit-packed") == 0) {
+        p->subType = lcecPdoEntTypeBitPacked;
+        p->halType = HAL_U32;
+        continue;
+      }
       if (strcasecmp(val, "s32") == 0) {
         p->subType = lcecPdoEntTypeSimple;
         p->halType = HAL_S32;
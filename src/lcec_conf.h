@@ -32,6 +32,7 @@
 #define LCEC_CONF_STR_MAXLEN 48
 
 #define LCEC_CONF_SDO_COMPLETE_SUBIDX -1
+#define LCEC_CONF_SYNC_UNIT_PHASE_AUTO -1
 #define LCEC_CONF_GENERIC_MAX_SUBPINS 32
 #define LCEC_CONF_GENERIC_MAX_BITLEN  255
 
@@ -61,6 +62,7 @@ typedef enum {
   lcecPdoEntTypeComplex,
   lcecPdoEntTypeFloatIeee,
   lcecPdoEntTypeFloatDoubleIeee,
+  lcecPdoEntTypeBitPacked,
 } LCEC_PDOENT_TYPE_T;
 
 typedef struct {
@@ -75,6 +77,7 @@ typedef struct {
   int refClockSyncCycles;
   int syncToRefClock;
   int refClockSlaveIdx;
+  int recorderCycles;
   char name[LCEC_CONF_STR_MAXLEN];
 } LCEC_CONF_MASTER_T;
 
@@ -93,6 +96,8 @@ typedef struct {
   size_t idnConfigLength;
   unsigned int modParamCount;
   uint32_t syncUnitCycle;
+  int syncUnitPhase;
+  int syncUnitFuncts;
   char syncUnit[LCEC_CONF_STR_MAXLEN];
   char name[LCEC_CONF_STR_MAXLEN];
 } LCEC_CONF_SLAVE_T;
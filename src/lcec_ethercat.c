@@ -40,9 +40,11 @@ lcec_slave_t *lcec_slave_by_index(lcec_master_t *master, int index) {
 }
 
 /// @brief Copy FSoE (Safety over EtherCAT / FailSafe over EtherCAT) data between slaves and masters.
+///
+/// The FSoE master (EL6900, EL1918) must be in the same Sync Unit as
+/// the slave, so both sets of offsets are in the slave's process data.
 void copy_fsoe_data(lcec_slave_t *slave, unsigned int slave_offset, unsigned int master_offset) {
-  lcec_master_t *master = slave->master;
-  uint8_t *pd = master->process_data;
+  uint8_t *pd = slave->sync_unit->process_data;
   const LCEC_CONF_FSOE_T *fsoeConf = slave->fsoeConf;
 
   if (fsoeConf == NULL) {
@@ -58,10 +60,84 @@ void copy_fsoe_data(lcec_slave_t *slave, unsigned int slave_offset, unsigned int
   }
 }
 
+#define LCEC_SYNCS_INITIAL_SYNCS   5   ///< Initial room for syncs, including the terminator.
+#define LCEC_SYNCS_INITIAL_PDOS    4   ///< Initial room for PDO infos.
+#define LCEC_SYNCS_INITIAL_ENTRIES 16  ///< Initial room for PDO entries.
+
 /// @brief Initialize syncs to 0.
+///
+/// `syncs` must stay valid until `proc_init` returns; the layout is
+/// compacted then.
 void lcec_syncs_init(lcec_slave_t *slave, lcec_syncs_t *syncs) {
   memset(syncs, 0, sizeof(lcec_syncs_t));
   syncs->slave = slave;
+  syncs->sync_max = LCEC_SYNCS_INITIAL_SYNCS;
+  syncs->syncs = LCEC_ALLOCATE_ARRAY(ec_sync_info_t, syncs->sync_max);
+  syncs->syncs[0].index = 0xff;
+  syncs->pdo_info_max = LCEC_SYNCS_INITIAL_PDOS;
+  syncs->pdo_infos = LCEC_ALLOCATE_ARRAY(ec_pdo_info_t, syncs->pdo_info_max);
+  syncs->pdo_entry_max = LCEC_SYNCS_INITIAL_ENTRIES;
+  syncs->pdo_entries = LCEC_ALLOCATE_ARRAY(ec_pdo_entry_info_t, syncs->pdo_entry_max);
+  slave->syncs = syncs;
+}
+
+/// @brief Double the room for syncs.
+static void lcec_syncs_grow_syncs(lcec_syncs_t *syncs) {
+  ec_sync_info_t *n = LCEC_ALLOCATE_ARRAY(ec_sync_info_t, syncs->sync_max * 2);
+
+  memcpy(n, syncs->syncs, sizeof(ec_sync_info_t) * syncs->sync_max);
+  if (syncs->curr_sync != NULL) {
+    syncs->curr_sync = n + (syncs->curr_sync - syncs->syncs);
+  }
+  free(syncs->syncs);
+  syncs->syncs = n;
+  syncs->sync_max *= 2;
+}
+
+/// @brief Double the room for PDO infos, and move the syncs' pointers along.
+static void lcec_syncs_grow_pdo_infos(lcec_syncs_t *syncs) {
+  ec_pdo_info_t *n = LCEC_ALLOCATE_ARRAY(ec_pdo_info_t, syncs->pdo_info_max * 2);
+
+  memcpy(n, syncs->pdo_infos, sizeof(ec_pdo_info_t) * syncs->pdo_info_max);
+  for (int i = 0; i < syncs->sync_max; i++) {
+    if (syncs->syncs[i].pdos != NULL) {
+      syncs->syncs[i].pdos = n + (syncs->syncs[i].pdos - syncs->pdo_infos);
+    }
+  }
+  if (syncs->curr_pdo_info != NULL) {
+    syncs->curr_pdo_info = n + (syncs->curr_pdo_info - syncs->pdo_infos);
+  }
+  free(syncs->pdo_infos);
+  syncs->pdo_infos = n;
+  syncs->pdo_info_max *= 2;
+}
+
+/// @brief Double the room for PDO entries, and move the PDO infos' pointers along.
+static void lcec_syncs_grow_pdo_entries(lcec_syncs_t *syncs) {
+  ec_pdo_entry_info_t *n = LCEC_ALLOCATE_ARRAY(ec_pdo_entry_info_t, syncs->pdo_entry_max * 2);
+
+  memcpy(n, syncs->pdo_entries, sizeof(ec_pdo_entry_info_t) * syncs->pdo_entry_max);
+  for (int i = 0; i < syncs->pdo_info_max; i++) {
+    if (syncs->pdo_infos[i].entries != NULL) {
+      syncs->pdo_infos[i].entries = n + (syncs->pdo_infos[i].entries - syncs->pdo_entries);
+    }
+  }
+  if (syncs->curr_pdo_entry != NULL) {
+    syncs->curr_pdo_entry = n + (syncs->curr_pdo_entry - syncs->pdo_entries);
+  }
+  free(syncs->pdo_entries);
+  syncs->pdo_entries = n;
+  syncs->pdo_entry_max *= 2;
+}
+
+static int lcec_syncs_check_open(lcec_syncs_t *syncs, const char *func) {
+  if (syncs->compacted) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "%s: slave %s.%s layout is already compacted, not adding more.  Expect failure.\n", func,
+        syncs->slave->master->name, syncs->slave->name);
+    syncs->error = 1;
+    return -1;
+  }
+  return 0;
 }
 
 /// @brief Enable autoflow, when the number of PDO entries per PDO are
@@ -79,15 +155,13 @@ void lcec_syncs_enable_autoflow(lcec_slave_t *slave, lcec_syncs_t *syncs, int pd
 
 /// @brief Add a new EtherCAT sync manager configuration.
 int lcec_syncs_add_sync(lcec_syncs_t *syncs, ec_direction_t dir, ec_watchdog_mode_t watchdog_mode) {
-  // Reject before touching the buffer: the last slot is reserved for the 0xff
-  // terminator written below.
-  if (syncs->sync_count >= LCEC_MAX_SYNC_COUNT) {
-    rtapi_print_msg(RTAPI_MSG_ERR,
-        LCEC_MSG_PFX "lcec_syncs_add_sync: WARNING: sync full for slave %s.%s, not adding more.  Expect failure.\n",
-        syncs->slave->master->name, syncs->slave->name);
-    syncs->error = 1;
+  if (lcec_syncs_check_open(syncs, __func__) != 0) {
     return -1;
   }
+  // the last slot is reserved for the 0xff terminator written below
+  if (syncs->sync_count + 1 >= syncs->sync_max) {
+    lcec_syncs_grow_syncs(syncs);
+  }
 
   syncs->curr_sync = &syncs->syncs[syncs->sync_count];
 
@@ -102,15 +176,12 @@ int lcec_syncs_add_sync(lcec_syncs_t *syncs, ec_direction_t dir, ec_watchdog_mod
 
 /// @brief Add a new PDO to an existing sync manager.
 int lcec_syncs_add_pdo_info(lcec_syncs_t *syncs, uint16_t index) {
-  // Reject before writing so we never index past the buffer.  `>` (not `>=`)
-  // keeps the pre-existing usable capacity; only the out-of-bounds write is removed.
-  if (syncs->pdo_info_count > LCEC_MAX_PDO_INFO_COUNT) {
-    rtapi_print_msg(RTAPI_MSG_ERR,
-        LCEC_MSG_PFX "lcec_syncs_add_pdo_info: WARNING: pdo_info full for slave %s.%s, not adding more.  Expect failure.\n",
-        syncs->slave->master->name, syncs->slave->name);
-    syncs->error = 1;
+  if (lcec_syncs_check_open(syncs, __func__) != 0) {
     return -1;
   }
+  if (syncs->pdo_info_count >= syncs->pdo_info_max) {
+    lcec_syncs_grow_pdo_infos(syncs);
+  }
 
   syncs->curr_pdo_info = &syncs->pdo_infos[syncs->pdo_info_count];
 
@@ -141,15 +212,12 @@ int lcec_syncs_add_pdo_info(lcec_syncs_t *syncs, uint16_t index) {
 /// out one PDO and open up another one, if we've hit the
 /// pdo_entry_limit specified in `lcec_syncs_enable_autoflow`.
 int lcec_syncs_add_pdo_entry(lcec_syncs_t *syncs, uint16_t index, uint8_t subindex, uint8_t bit_length) {
-  // Reject before writing so we never index past the buffer.  `>` (not `>=`)
-  // keeps the pre-existing usable capacity; only the out-of-bounds write is removed.
-  if (syncs->pdo_entry_count > LCEC_MAX_PDO_ENTRY_COUNT) {
-    rtapi_print_msg(RTAPI_MSG_ERR,
-        LCEC_MSG_PFX "lcec_syncs_add_pdo_entry: WARNING: pdo_entries full for slave %s.%s, not adding more.  Expect failure.\n",
-        syncs->slave->master->name, syncs->slave->name);
-    syncs->error = 1;
+  if (lcec_syncs_check_open(syncs, __func__) != 0) {
     return -1;
   }
+  if (syncs->pdo_entry_count >= syncs->pdo_entry_max) {
+    lcec_syncs_grow_pdo_entries(syncs);
+  }
 
   syncs->curr_pdo_entry = &syncs->pdo_entries[syncs->pdo_entry_count];
 
@@ -159,7 +227,7 @@ int lcec_syncs_add_pdo_entry(lcec_syncs_t *syncs, uint16_t index, uint8_t subind
   (syncs->curr_pdo_info->n_entries)++;
   if (syncs->autoflow && (syncs->curr_pdo_info->n_entries >= syncs->pdo_entry_limit)) {
     // Open up a new PDO, because this one is full.  On overflow this sets
-    // syncs->error; the entry below still lands in a valid slot (guarded above).
+    // syncs->error; the entry below still lands in a valid slot.
     lcec_syncs_add_pdo_info(syncs, syncs->curr_pdo_info->index + syncs->pdo_increment);
     syncs->curr_pdo_entry = &syncs->pdo_entries[syncs->pdo_entry_count];
   }
@@ -172,6 +240,79 @@ int lcec_syncs_add_pdo_entry(lcec_syncs_t *syncs, uint16_t index, uint8_t subind
   return 0;
 }
 
+/// @brief Move a layout into one exactly-sized block of HAL memory.
+///
+/// Syncs, PDO infos and PDO entries are laid out back to back, the
+/// pointers between them are rebased, and the scratch arrays are freed.
+/// Called from `rtapi_app_main()` after the slave's `proc_init`;
+/// calling it again is a no-op.
+///
+/// @return The compacted `syncs->syncs`, for `slave->sync_info`.
+ec_sync_info_t *lcec_syncs_compact(lcec_syncs_t *syncs) {
+  ec_sync_info_t *new_syncs;
+  ec_pdo_info_t *new_infos;
+  ec_pdo_entry_info_t *new_entries;
+  int infos = syncs->pdo_info_count;
+  int entries = syncs->pdo_entry_count;
+  size_t syncs_size, infos_size, entries_size;
+  char *block;
+
+  if (syncs->compacted) {
+    return syncs->syncs;
+  }
+
+  // a PDO rejected by the autoflow limit is still referenced by its sync
+  if (syncs->curr_pdo_info != NULL && syncs->curr_pdo_info - syncs->pdo_infos >= infos) {
+    infos = syncs->curr_pdo_info - syncs->pdo_infos + 1;
+  }
+
+  syncs_size = sizeof(ec_sync_info_t) * (syncs->sync_count + 1);
+  infos_size = sizeof(ec_pdo_info_t) * infos;
+  entries_size = sizeof(ec_pdo_entry_info_t) * entries;
+  block = (char *)lcec_hal_malloc(syncs_size + infos_size + entries_size, __FILE__, __func__, __LINE__);
+  new_syncs = (ec_sync_info_t *)block;
+  new_infos = (ec_pdo_info_t *)(block + syncs_size);
+  new_entries = (ec_pdo_entry_info_t *)(block + syncs_size + infos_size);
+
+  memcpy(new_syncs, syncs->syncs, syncs_size);
+  new_syncs[syncs->sync_count].index = 0xff;
+  for (int i = 0; i < syncs->sync_count; i++) {
+    if (new_syncs[i].pdos != NULL) {
+      new_syncs[i].pdos = new_infos + (new_syncs[i].pdos - syncs->pdo_infos);
+    }
+  }
+  memcpy(new_infos, syncs->pdo_infos, infos_size);
+  for (int i = 0; i < infos; i++) {
+    if (new_infos[i].entries != NULL) {
+      new_infos[i].entries = new_entries + (new_infos[i].entries - syncs->pdo_entries);
+    }
+  }
+  memcpy(new_entries, syncs->pdo_entries, entries_size);
+
+  if (syncs->curr_sync != NULL) {
+    syncs->curr_sync = new_syncs + (syncs->curr_sync - syncs->syncs);
+  }
+  if (syncs->curr_pdo_info != NULL) {
+    syncs->curr_pdo_info = new_infos + (syncs->curr_pdo_info - syncs->pdo_infos);
+  }
+  if (syncs->curr_pdo_entry != NULL) {
+    syncs->curr_pdo_entry = new_entries + (syncs->curr_pdo_entry - syncs->pdo_entries);
+  }
+  free(syncs->syncs);
+  free(syncs->pdo_infos);
+  free(syncs->pdo_entries);
+
+  syncs->syncs = new_syncs;
+  syncs->sync_max = syncs->sync_count + 1;
+  syncs->pdo_infos = new_infos;
+  syncs->pdo_info_max = infos;
+  syncs->pdo_entries = new_entries;
+  syncs->pdo_entry_max = entries;
+  syncs->size = syncs_size + infos_size + entries_size;
+  syncs->compacted = 1;
+  return new_syncs;
+}
+
 /// @brief Read an SDO configuration from a slave device.
 int lcec_read_sdo(lcec_slave_t *slave, uint16_t index, uint8_t subindex, uint8_t *target, size_t size) {
   lcec_master_t *master = slave->master;
@@ -182,6 +323,7 @@ int lcec_read_sdo(lcec_slave_t *slave, uint16_t index, uint8_t subindex, uint8_t
   if ((err = ecrt_master_sdo_upload(master->master, slave->index, index, subindex, target, size, &result_size, &abort_code))) {
     rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: Failed to execute SDO upload (0x%04x:0x%02x, error %d, abort_code %08x)\n",
         master->name, slave->name, index, subindex, err, abort_code);
+    lcec_trace_event(master->trace, LCEC_TRACE_SDO_UPLOAD_FAIL, slave->index, (uint32_t)index << 8 | subindex, abort_code);
     return -1;
   }
 
@@ -378,6 +520,7 @@ int lcec_write_sdo(lcec_slave_t *slave, uint16_t index, uint8_t subindex, uint8_
     rtapi_print_msg(RTAPI_MSG_ERR,
         LCEC_MSG_PFX "slave %s.%s: Failed to execute SDO download (0x%04x:0x%02x, size %d, byte0=%d, error %d, abort_code %08x)\n",
         master->name, slave->name, index, subindex, (int)size, (int)value[0], err, abort_code);
+    lcec_trace_event(master->trace, LCEC_TRACE_SDO_DOWNLOAD_FAIL, slave->index, (uint32_t)index << 8 | subindex, abort_code);
     return -1;
   }
 
@@ -622,19 +765,57 @@ LCEC_CONF_MODPARAM_VAL_T *lcec_modparam_get(lcec_slave_t *slave, int id) {
 
 /// @brief Allocate a lcec_pdo_entry_reg struct.
 ///
-/// @param size The maximum number of entries to allocate room for.
+/// The entries live in ordinary heap memory, not HAL shared memory;
+/// they are only needed until `ecrt_domain_reg_pdo_entry_list()` has
+/// filled in the offsets, and are released with
+/// `lcec_free_pdo_entry_reg()` after that.
+///
+/// @param size The number of entries to allocate room for initially.
 /// @return  A lcec_pdo_entry_reg_t, or NULL if memory allocation failed.
 lcec_pdo_entry_reg_t *lcec_allocate_pdo_entry_reg(int size) {
-  lcec_pdo_entry_reg_t *reg = LCEC_HAL_ALLOCATE(lcec_pdo_entry_reg_t);
+  lcec_pdo_entry_reg_t *reg = LCEC_ALLOCATE(lcec_pdo_entry_reg_t);
   if (reg == NULL) return NULL;
 
   reg->max = size;
   reg->current = 0;
-  reg->pdo_entry_regs = LCEC_HAL_ALLOCATE_ARRAY(ec_pdo_entry_reg_t, size);
+  reg->pdo_entry_regs = LCEC_ALLOCATE_ARRAY(ec_pdo_entry_reg_t, size);
 
   return reg;
 }
 
+/// @brief Free a lcec_pdo_entry_reg struct and its entries.
+void lcec_free_pdo_entry_reg(lcec_pdo_entry_reg_t *reg) {
+  if (reg == NULL) return;
+
+  free(reg->pdo_entry_regs);
+  free(reg);
+}
+
+/// @brief Make room for at least `count` entries.
+///
+/// Doubles the array, keeping one zeroed entry spare so the array stays
+/// terminated for `ecrt_domain_reg_pdo_entry_list()`.
+static int lcec_grow_pdo_entry_reg(lcec_pdo_entry_reg_t *reg, int count) {
+  ec_pdo_entry_reg_t *regs;
+  int max = (reg->max > 0) ? reg->max : LCEC_PDO_REG_INITIAL_COUNT;
+
+  while (max < count + 1) {
+    max *= 2;
+  }
+  if (max == reg->max) {
+    return 0;
+  }
+
+  regs = realloc(reg->pdo_entry_regs, sizeof(ec_pdo_entry_reg_t) * max);
+  if (regs == NULL) {
+    return -1;
+  }
+  memset(&regs[reg->max], 0, sizeof(ec_pdo_entry_reg_t) * (max - reg->max));
+  reg->pdo_entry_regs = regs;
+  reg->max = max;
+  return 0;
+}
+
 /// @brief Register a new PDO entry.
 ///
 /// This replaces the old LCEC_PDO_INIT() macro.  It has error
@@ -650,12 +831,17 @@ lcec_pdo_entry_reg_t *lcec_allocate_pdo_entry_reg(int size) {
 /// type, or it may be NULL for 8-bit or larger types.  Attempting to use NULL with a boolean will trigger an error at runtime.
 /// @return 0 for succeess, <0 for failure.
 int lcec_pdo_init(lcec_slave_t *slave, uint16_t idx, uint16_t sidx, unsigned int *os, unsigned int *bp) {
-  if (slave->regs->current >= slave->regs->max) {
+  if (slave->regs == NULL) {
     // We specifically want to log this, because most users don't
     // bother checking the return value, and this is an init bug.
     rtapi_print_msg(RTAPI_MSG_ERR,
-        LCEC_MSG_PFX "lcec_pdo_init() failed for slave %s:%s; lcec_pdo_entry_reg_t is full, with %d of %d entries used\n",
-        slave->master->name, slave->name, slave->regs->current, slave->regs->max);
+        LCEC_MSG_PFX "lcec_pdo_init() failed for slave %s:%s; PDO entries can only be registered from proc_init\n", slave->master->name,
+        slave->name);
+    return -1;
+  }
+  if (lcec_grow_pdo_entry_reg(slave->regs, slave->regs->current + 1) != 0) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "lcec_pdo_init() failed for slave %s:%s; out of memory with %d entries used\n",
+        slave->master->name, slave->name, slave->regs->current);
     return -1;
   }
 
@@ -692,3 +878,273 @@ int lcec_append_pdo_entry_reg(lcec_pdo_entry_reg_t *dest, lcec_pdo_entry_reg_t *
   }
   return 0;
 }
+
+/// @brief Find the bytes of the process data that hold a slave's outputs.
+///
+/// Walks the output Sync Managers in `slave->sync_info` and covers every
+/// entry the driver registered.  Slaves without `sync_info` have no
+/// known outputs.
+static void lcec_slave_output_range(lcec_slave_t *slave, unsigned int *offset, unsigned int *len) {
+  const ec_sync_info_t *sync;
+  unsigned int start = 0, end = 0;
+  int found = 0;
+
+  *offset = 0;
+  *len = 0;
+  if (slave->sync_info == NULL || slave->regs == NULL) {
+    return;
+  }
+
+  for (sync = slave->sync_info; sync->index != 0xff; sync++) {
+    if (sync->dir != EC_DIR_OUTPUT) {
+      continue;
+    }
+    for (unsigned int p = 0; p < sync->n_pdos; p++) {
+      const ec_pdo_info_t *pdo = &sync->pdos[p];
+      for (unsigned int e = 0; e < pdo->n_entries; e++) {
+        const ec_pdo_entry_info_t *entry = &pdo->entries[e];
+        for (int r = 0; r < slave->regs->current; r++) {
+          const ec_pdo_entry_reg_t *reg = &slave->regs->pdo_entry_regs[r];
+          if (reg->index == entry->index && reg->subindex == entry->subindex && reg->offset != NULL) {
+            unsigned int bit = (reg->bit_position != NULL) ? *(reg->bit_position) : 0;
+            unsigned int entry_end = *(reg->offset) + (bit + entry->bit_length + 7) / 8;
+            if (!found || *(reg->offset) < start) {
+              start = *(reg->offset);
+            }
+            if (!found || entry_end > end) {
+              end = entry_end;
+            }
+            found = 1;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (found) {
+    *offset = start;
+    *len = end - start;
+  }
+}
+
+/// @brief Build the cyclic dispatch table for a Sync Unit.
+///
+/// Collects the read/write callbacks of every slave in `sync_unit`
+/// into one contiguous array, in slave list order.  Slaves without
+/// either callback are left out.  This must run after every slave's
+/// `proc_init` and after PDO registration, and before the master is
+/// activated; it allocates, so it must not be called from the RT
+/// thread.
+///
+/// @return 0 on success.
+int lcec_sync_unit_build_dispatch(lcec_master_t *master, lcec_sync_unit_t *sync_unit) {
+  lcec_slave_t *slave;
+  lcec_dispatch_t *d;
+  int count = 0;
+  int words;
+
+  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+    if (slave->sync_unit == sync_unit) {
+      slave->dispatch_index = -1;
+      if (slave->proc_read != NULL || slave->proc_write != NULL) {
+        count++;
+      }
+    }
+  }
+
+  sync_unit->dispatch_count = count;
+  sync_unit->dispatch = NULL;
+  if (count == 0) {
+    return 0;
+  }
+
+  d = sync_unit->dispatch = LCEC_ALLOCATE_ARRAY(lcec_dispatch_t, count);
+  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+    if (slave->sync_unit == sync_unit && (slave->proc_read != NULL || slave->proc_write != NULL)) {
+      slave->dispatch_index = d - sync_unit->dispatch;
+      d->proc_read = slave->proc_read;
+      d->proc_write = slave->proc_write;
+      d->slave = slave;
+      lcec_slave_output_range(slave, &d->safe_offset, &d->safe_len);
+      d++;
+    }
+  }
+
+  // Every slave counts as operational until its state is first polled.
+  words = (count + 31) / 32;
+  sync_unit->oper_mask = LCEC_ALLOCATE_ARRAY(uint32_t, words * 3);
+  sync_unit->read_mask = sync_unit->oper_mask + words;
+  sync_unit->write_mask = sync_unit->read_mask + words;
+  memset(sync_unit->oper_mask, 0xff, sizeof(uint32_t) * words * 3);
+
+  return 0;
+}
+
+/// @brief Record whether the slave at `index` in the dispatch table is
+/// operational.
+///
+/// A slave that is not operational has its read and write functions
+/// called once more, so drivers can react to losing OP, and is then
+/// skipped until it is operational again.
+///
+/// Called from the master's thread, while the read and write functions
+/// may clear bits of the same words from a Sync Unit's own thread, so
+/// the masks are only changed with atomic read-modify-writes.
+///
+/// @return +1 if the slave just stopped being operational, -1 if it
+/// just became operational, 0 otherwise.
+int lcec_sync_unit_set_oper(lcec_sync_unit_t *sync_unit, int index, int oper) {
+  uint32_t bit = 1u << (index & 31);
+  int word = index >> 5;
+  int was_oper = (sync_unit->oper_mask[word] & bit) != 0;
+
+  if (oper) {
+    __atomic_fetch_or(&sync_unit->oper_mask[word], bit, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&sync_unit->read_mask[word], bit, __ATOMIC_RELAXED);
+    __atomic_fetch_or(&sync_unit->write_mask[word], bit, __ATOMIC_RELAXED);
+  } else {
+    __atomic_fetch_and(&sync_unit->oper_mask[word], ~bit, __ATOMIC_RELAXED);
+  }
+
+  return was_oper - (oper != 0);
+}
+
+/// @brief Call the read callback of every slave in a Sync Unit.
+///
+/// Drivers find their process data through `slave->sync_unit`, so this
+/// touches nothing outside the Sync Unit and may run in any thread that
+/// owns it.
+void lcec_sync_unit_read(lcec_master_t *master, lcec_sync_unit_t *sync_unit) {
+  const lcec_dispatch_t *d = sync_unit->dispatch;
+  long period = sync_unit->cycle_time;
+
+  for (int i = 0; i < sync_unit->dispatch_count; i++, d++) {
+    uint32_t bit = 1u << (i & 31);
+    if (!(sync_unit->read_mask[i >> 5] & bit)) {
+      continue;
+    }
+    if (d->proc_read != NULL) {
+      d->proc_read(d->slave, period);
+    }
+    if (!(sync_unit->oper_mask[i >> 5] & bit)) {
+      __atomic_fetch_and(&sync_unit->read_mask[i >> 5], ~bit, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/// @brief Call the write callback of every slave in a Sync Unit.
+///
+/// Slaves that are skipped because they are not operational get their
+/// outputs cleared instead when `safe_outputs` is set.
+void lcec_sync_unit_write(lcec_master_t *master, lcec_sync_unit_t *sync_unit) {
+  const lcec_dispatch_t *d = sync_unit->dispatch;
+  long period = sync_unit->cycle_time;
+
+  for (int i = 0; i < sync_unit->dispatch_count; i++, d++) {
+    uint32_t bit = 1u << (i & 31);
+    if (!(sync_unit->write_mask[i >> 5] & bit)) {
+      if (sync_unit->safe_outputs && d->safe_len > 0) {
+        memset(&sync_unit->process_data[d->safe_offset], 0, d->safe_len);
+      }
+      continue;
+    }
+    if (d->proc_write != NULL) {
+      d->proc_write(d->slave, period);
+    }
+    if (!(sync_unit->oper_mask[i >> 5] & bit)) {
+      __atomic_fetch_and(&sync_unit->write_mask[i >> 5], ~bit, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+static unsigned int lcec_sync_unit_weight(const lcec_sync_unit_t *sync_unit) {
+  // Domain size is known once the PDO entries are registered; fall back
+  // to the entry count so empty or unsized domains still get spread.
+  return (sync_unit->process_data_len > 0) ? sync_unit->process_data_len : sync_unit->pdo_entry_count;
+}
+
+static unsigned int lcec_gcd(unsigned int a, unsigned int b) {
+  while (b != 0) {
+    unsigned int t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/// @brief Pick phases for Sync Units with `syncUnitPhase="auto"`.
+///
+/// Sync Units with a divider > 1 are only exchanged on one master cycle
+/// out of `cycle_divider`.  Left at phase 0 they all land on the same
+/// cycle, so that frame carries every slow domain while the others are
+/// nearly empty.  This assigns each automatic unit the phase that
+/// minimizes the largest per-cycle byte count over the divider window,
+/// placing the biggest units first.  Units with an explicit phase are
+/// accounted for but never moved.
+///
+/// Runs at startup, after PDO registration; it allocates.
+///
+/// @return 0 on success.
+int lcec_sync_unit_spread_phases(lcec_master_t *master) {
+  lcec_sync_unit_t *sync_unit, *next;
+  unsigned long *load;
+  unsigned int window = 1;
+  unsigned int cycle;
+
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    unsigned int divider = sync_unit->cycle_divider;
+    unsigned long lcm = (unsigned long)window / lcec_gcd(window, divider) * divider;
+    window = (lcm > LCEC_SYNC_UNIT_PHASE_WINDOW) ? LCEC_SYNC_UNIT_PHASE_WINDOW : lcm;
+  }
+
+  load = LCEC_ALLOCATE_ARRAY(unsigned long, window);
+
+  // fixed phases first
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->cycle_phase >= 0) {
+      for (cycle = sync_unit->cycle_phase; cycle < window; cycle += sync_unit->cycle_divider) {
+        load[cycle] += lcec_sync_unit_weight(sync_unit);
+      }
+    }
+  }
+
+  // then the automatic ones, largest first
+  for (;;) {
+    unsigned int phase, best_phase = 0;
+    unsigned long best_max = 0, best_sum = 0;
+
+    next = NULL;
+    for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+      if (sync_unit->cycle_phase < 0 && (next == NULL || lcec_sync_unit_weight(sync_unit) > lcec_sync_unit_weight(next))) {
+        next = sync_unit;
+      }
+    }
+    if (next == NULL) {
+      break;
+    }
+
+    for (phase = 0; phase < next->cycle_divider; phase++) {
+      unsigned long max = 0, sum = 0;
+      for (cycle = phase; cycle < window; cycle += next->cycle_divider) {
+        if (load[cycle] > max) {
+          max = load[cycle];
+        }
+        sum += load[cycle];
+      }
+      if (phase == 0 || max < best_max || (max == best_max && sum < best_sum)) {
+        best_max = max;
+        best_sum = sum;
+        best_phase = phase;
+      }
+    }
+
+    next->cycle_phase = best_phase;
+    for (cycle = best_phase; cycle < window; cycle += next->cycle_divider) {
+      load[cycle] += lcec_sync_unit_weight(next);
+    }
+  }
+
+  free(load);
+  return 0;
+}
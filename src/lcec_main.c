@@ -41,6 +41,10 @@ MODULE_DESCRIPTION("Driver for EtherCAT devices")
 #pragma weak hal_init_funct_to_thread
 extern int hal_init_funct_to_thread(const char *funct_name, const char *thread_name, int position);
 
+/// Size of a `lcec_syncs_t` with the fixed arrays it used to embed (4 syncs, 16 PDOs, 128 entries), for the startup report.
+#define LCEC_SYNCS_FIXED_SIZE \
+  (sizeof(lcec_syncs_t) + 5 * sizeof(ec_sync_info_t) + 17 * sizeof(ec_pdo_info_t) + 129 * sizeof(ec_pdo_entry_info_t))
+
 /* Set in rtapi_app_main from the weak-symbol probe. */
 static int initf_supported = 0;
 
@@ -65,9 +69,17 @@ static const lcec_pindesc_t master_pins[] = {
     {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, app_phase), "%s.app-phase"},
     {HAL_BIT, HAL_OUT, offsetof(lcec_master_data_t, dc_phased), "%s.dc-phased"},
     {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, phase_jitter_out), "%s.phase-jitter"},
+    {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, phase_jitter_p50), "%s.phase-jitter-p50"},
+    {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, phase_jitter_p99), "%s.phase-jitter-p99"},
+    {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, phase_jitter_p999), "%s.phase-jitter-p999"},
+    {HAL_BIT, HAL_IO, offsetof(lcec_master_data_t, phase_recalibrate), "%s.phase-recalibrate"},
     {HAL_S32, HAL_IN, offsetof(lcec_master_data_t, drift_mode), "%s.drift-mode"},
     {HAL_S32, HAL_IN, offsetof(lcec_master_data_t, pll_drift), "%s.pll-drift"},
     {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, pll_final), "%s.pll-final"},
+    {HAL_FLOAT, HAL_OUT, offsetof(lcec_master_data_t, pll_integrator), "%s.pll-integrator"},
+    {HAL_FLOAT, HAL_OUT, offsetof(lcec_master_data_t, pll_lock_time), "%s.pll-lock-time"},
+    {HAL_BIT, HAL_IO, offsetof(lcec_master_data_t, sync0_tune), "%s.sync0-tune"},
+    {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, sync0_send_phase), "%s.sync0-send-phase"},
 #endif
     {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, wkc), "%s.wkc"},
     {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, wkc_min), "%s.wkc-min"},
@@ -76,6 +88,13 @@ static const lcec_pindesc_t master_pins[] = {
     {HAL_BIT, HAL_IO, offsetof(lcec_master_data_t, wkc_reset), "%s.wkc-reset"},
     {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, dc_sync_diff), "%s.dc-sync-diff"},
     {HAL_BIT, HAL_OUT, offsetof(lcec_master_data_t, dc_sync_converged), "%s.dc-sync-converged"},
+    {HAL_S32, HAL_OUT, offsetof(lcec_master_data_t, dc_worst_slave), "%s.dc-worst-slave"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, dc_worst_diff), "%s.dc-worst-diff"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, queued_bytes), "%s.queued-bytes"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, slaves_skipped), "%s.slaves-skipped"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, lock_wait_cnt), "%s.lock-wait-count"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, lock_wait_max), "%s.lock-wait-max"},
+    {HAL_U32, HAL_OUT, offsetof(lcec_master_data_t, lock_defer_cnt), "%s.lock-defer-count"},
     {HAL_TYPE_UNSPECIFIED, HAL_DIR_UNSPECIFIED, -1, NULL},
 };
 
@@ -84,9 +103,20 @@ static const lcec_paramdesc_t master_params[] = {
 #ifdef RTAPI_TASK_PLL_SUPPORT
     {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, pll_step), "%s.pll-step"},
     {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, pll_max_err), "%s.pll-max-err"},
+    {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, pll_controller), "%s.pll-controller"},
+    {HAL_FLOAT, HAL_RW, offsetof(lcec_master_data_t, pll_kp), "%s.pll-kp"},
+    {HAL_FLOAT, HAL_RW, offsetof(lcec_master_data_t, pll_ki), "%s.pll-ki"},
+    {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, pll_max_out), "%s.pll-max-out"},
+    {HAL_BIT, HAL_RW, offsetof(lcec_master_data_t, phase_retarget), "%s.phase-retarget"},
+    {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, sync0_margin), "%s.sync0-margin"},
 #endif
     {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, dc_sync_max), "%s.dc-sync-max"},
     {HAL_BIT, HAL_RW, offsetof(lcec_master_data_t, dc_sync_monitor), "%s.dc-sync-monitor"},
+    {HAL_BIT, HAL_RW, offsetof(lcec_master_data_t, dc_slave_monitor), "%s.dc-slave-monitor"},
+    {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, state_poll_period), "%s.state-poll-period"},
+    {HAL_U32, HAL_RW, offsetof(lcec_master_data_t, state_poll_batch), "%s.state-poll-batch"},
+    {HAL_BIT, HAL_RW, offsetof(lcec_master_data_t, skip_non_op), "%s.skip-non-op"},
+    {HAL_BIT, HAL_RW, offsetof(lcec_master_data_t, safe_outputs), "%s.safe-outputs"},
     {HAL_TYPE_UNSPECIFIED},
 };
 
@@ -107,6 +137,14 @@ extern int lcec_comp_id;
 
 static lcec_master_data_t *global_hal_data;
 static ec_master_state_t global_ms;
+static lcec_timing_t *global_timing;
+
+/// @brief Pin names for the per-master timing sections (`lcec_timing_master_section_t`).
+static const char *const master_timing_sections[LCEC_TIMING_MASTER_COUNT] = {
+    "read", "receive", "process", "state", "read-callbacks", "write", "write-callbacks", "send"};
+
+/// @brief Pin names for the global timing sections (`lcec_timing_global_section_t`).
+static const char *const global_timing_sections[LCEC_TIMING_GLOBAL_COUNT] = {"read-all", "write-all"};
 
 int lcec_parse_config(void);
 void lcec_clear_config(void);
@@ -125,14 +163,28 @@ void lcec_read_all(void *arg, long period);
 void lcec_write_all(void *arg, long period);
 void lcec_read_master(void *arg, long period);
 void lcec_write_master(void *arg, long period);
+void lcec_receive_master(void *arg, long period);
+void lcec_inputs_master(void *arg, long period);
+void lcec_outputs_master(void *arg, long period);
+void lcec_send_master(void *arg, long period);
+void lcec_read_sync_unit(void *arg, long period);
+void lcec_write_sync_unit(void *arg, long period);
 static int lcec_activate_master(lcec_master_t *master);
 static void lcec_activate(void *arg, long period);
-static lcec_sync_unit_t *lcec_master_get_sync_unit(lcec_master_t *master, const char *name, uint32_t cycle_time);
+static lcec_sync_unit_t *lcec_master_get_sync_unit(
+    lcec_master_t *master, const char *name, uint32_t cycle_time, int phase, int own_functs);
 static int lcec_master_all_op(lcec_master_t *master);
+static void lcec_poll_slave_states(lcec_master_t *master, long period);
+static void lcec_poll_dc_diff(lcec_master_t *master);
+#ifdef RTAPI_TASK_PLL_SUPPORT
+static void lcec_sync0_tune(lcec_master_t *master, int32_t send_phase, uint32_t bytes);
+#endif
+static int lcec_master_lock_rt(lcec_master_t *master, long period);
 
 static void sigsegv_handler(int sig);
 
-static lcec_sync_unit_t *lcec_master_get_sync_unit(lcec_master_t *master, const char *name, uint32_t cycle_time) {
+static lcec_sync_unit_t *lcec_master_get_sync_unit(
+    lcec_master_t *master, const char *name, uint32_t cycle_time, int phase, int own_functs) {
   lcec_sync_unit_t *sync_unit;
 
   if (cycle_time == 0 || master->app_time_period == 0 || (cycle_time % master->app_time_period) != 0) {
@@ -148,15 +200,33 @@ static lcec_sync_unit_t *lcec_master_get_sync_unit(lcec_master_t *master, const
             sync_unit->cycle_time, cycle_time);
         return NULL;
       }
+      if (sync_unit->cycle_phase != phase) {
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s phase mismatch (%d != %d)\n", master->name, name,
+            sync_unit->cycle_phase, phase);
+        return NULL;
+      }
+      if (sync_unit->own_functs != own_functs) {
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s syncUnitFuncts mismatch\n", master->name, name);
+        return NULL;
+      }
       return sync_unit;
     }
   }
 
+  if (phase >= 0 && (uint32_t)phase >= cycle_time / master->app_time_period) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s phase %d is not less than its divider %u\n", master->name, name,
+        phase, cycle_time / master->app_time_period);
+    return NULL;
+  }
+
   sync_unit = LCEC_ALLOCATE(lcec_sync_unit_t);
+  sync_unit->master = master;
   strncpy(sync_unit->name, name, LCEC_CONF_STR_MAXLEN);
   sync_unit->name[LCEC_CONF_STR_MAXLEN - 1] = 0;
   sync_unit->cycle_time = cycle_time;
   sync_unit->cycle_divider = cycle_time / master->app_time_period;
+  sync_unit->cycle_phase = phase;
+  sync_unit->own_functs = own_functs;
   sync_unit->queued = 1;
   LCEC_LIST_APPEND(master->first_sync_unit, master->last_sync_unit, sync_unit);
 
@@ -174,6 +244,8 @@ int rtapi_app_main(void) {
   char name[HAL_NAME_LEN + 1];
   lcec_slave_sdoconf_t *sdo_config;
   lcec_slave_idnconf_t *idn_config;
+  size_t syncs_size;
+  int syncs_count;
 
 #ifndef __KERNEL
   struct sigaction handler;
@@ -212,6 +284,9 @@ int rtapi_app_main(void) {
   if ((global_hal_data = lcec_init_master_hal(LCEC_MODULE_NAME, 1)) == NULL) {
     goto fail2;
   }
+  if ((global_timing = lcec_timing_init(LCEC_MODULE_NAME, global_timing_sections, LCEC_TIMING_GLOBAL_COUNT)) == NULL) {
+    goto fail2;
+  }
 
   // initialize masters
   for (master = first_master; master != NULL; master = master->next) {
@@ -221,6 +296,19 @@ int rtapi_app_main(void) {
       goto fail2;
     }
 
+    // event trace for lcec_trace; set up first so it sees SDO errors during slave init
+    if ((master->trace = lcec_trace_init(master->index, lcec_comp_id, &master->trace_shmem_id)) == NULL) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "unable to create event trace for master %s\n", master->name);
+      goto fail2;
+    }
+
+    // runtime SDO writes; set up before the slaves, which register their objects with it
+    rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s", LCEC_MODULE_NAME, master->name);
+    if ((master->sdo_sched = lcec_sdo_sched_init(master, name)) == NULL) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "unable to create SDO scheduler for master %s\n", master->name);
+      goto fail2;
+    }
+
 #ifdef __KERNEL__
     // register callbacks
     ecrt_master_callbacks(master->master, lcec_request_lock, lcec_release_lock, master);
@@ -238,6 +326,8 @@ int rtapi_app_main(void) {
     }
 
     // initialize slaves
+    syncs_size = 0;
+    syncs_count = 0;
     for (slave = master->first_slave; slave != NULL; slave = slave->next) {
       // read slave config
 
@@ -278,7 +368,7 @@ int rtapi_app_main(void) {
         }
       }
 
-      slave->regs = lcec_allocate_pdo_entry_reg(LCEC_MAX_PDO_REG_COUNT);
+      slave->regs = lcec_allocate_pdo_entry_reg(LCEC_PDO_REG_INITIAL_COUNT);
       if (slave->regs == NULL) {
         rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failure allocating PDO entries for slave %s.%s\n", master->name, slave->name);
         goto fail2;
@@ -293,10 +383,23 @@ int rtapi_app_main(void) {
         }
       }
 
+      // move a lcec_syncs_t layout into its final, exactly-sized block
+      if (slave->syncs != NULL) {
+        if (slave->sync_info == slave->syncs->syncs) {
+          slave->sync_info = lcec_syncs_compact(slave->syncs);
+        } else {
+          lcec_syncs_compact(slave->syncs);
+        }
+        syncs_size += sizeof(lcec_syncs_t) + slave->syncs->size;
+        syncs_count++;
+      }
+
       // configure dc for this slave
       if (slave->dc_conf != NULL) {
+        // SYNC1 may instead mark the cycle after several SYNC0 pulses, as on oversampling terminals
         if (slave->sync_unit->cycle_divider > 1 && slave->dc_conf->sync0Cycle > 0 &&
-            slave->dc_conf->sync0Cycle != slave->sync_unit->cycle_time) {
+            slave->dc_conf->sync0Cycle != slave->sync_unit->cycle_time &&
+            slave->dc_conf->sync0Cycle + slave->dc_conf->sync1Cycle != slave->sync_unit->cycle_time) {
           rtapi_print_msg(RTAPI_MSG_WARN,
               LCEC_MSG_PFX
               "slave %s.%s syncUnit %s cycle=%u ns but DC sync0Cycle=%u ns; set dcConf sync0Cycle to the slave "
@@ -309,6 +412,20 @@ int rtapi_app_main(void) {
             LCEC_MSG_PFX "configuring DC for slave %s.%s: assignActivate=x%x sync0Cycle=%d sync0Shift=%d sync1Cycle=%d sync1Shift=%d\n",
             master->name, slave->name, slave->dc_conf->assignActivate, slave->dc_conf->sync0Cycle, slave->dc_conf->sync0Shift,
             slave->dc_conf->sync1Cycle, slave->dc_conf->sync1Shift);
+
+        // register request for the per-slave system time difference;
+        // the slave still works without it
+        if ((slave->dc_diff_req = ecrt_slave_config_create_reg_request(slave->config, 4)) == NULL) {
+          rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "slave %s.%s: no register request, dc-time-diff not available\n", master->name,
+              slave->name);
+        } else {
+          if (master->last_dc_slave != NULL) {
+            master->last_dc_slave->dc_next = slave;
+          } else {
+            master->first_dc_slave = slave;
+          }
+          master->last_dc_slave = slave;
+        }
       }
 
       // Configure the slave's watchdog times.
@@ -331,10 +448,32 @@ int rtapi_app_main(void) {
         rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failure to export slave pins for slave %s.%s\n", master->name, slave->name);
         goto fail2;
       }
+#ifdef RTAPI_TASK_PLL_SUPPORT
+      if (slave->dc_conf != NULL) {
+        if (lcec_pin_newf(HAL_S32, HAL_OUT, (void **)&slave->hal_state_data->sync0_shift_safe, "%s.%s.%s.sync0-shift-safe",
+                LCEC_MODULE_NAME, master->name, slave->name) != 0) {
+          goto fail2;
+        }
+        if (lcec_pin_newf(HAL_S32, HAL_OUT, (void **)&slave->hal_state_data->sync0_latency, "%s.%s.%s.sync0-latency",
+                LCEC_MODULE_NAME, master->name, slave->name) != 0) {
+          goto fail2;
+        }
+      }
+#endif
+      if (slave->dc_diff_req != NULL && lcec_pin_newf(HAL_S32, HAL_OUT, (void **)&slave->hal_state_data->dc_time_diff,
+                                            "%s.%s.%s.dc-time-diff", LCEC_MODULE_NAME, master->name, slave->name) != 0) {
+        goto fail2;
+      }
 
       slave->sync_unit->pdo_entry_count += lcec_pdo_entry_reg_len(slave->regs);
     }
 
+    if (syncs_count > 0) {
+      rtapi_print_msg(RTAPI_MSG_INFO,
+          LCEC_MSG_PFX "master %s: sync manager layouts of %d slaves use %lu bytes, %lu bytes less than fixed arrays\n", master->name,
+          syncs_count, (unsigned long)syncs_size, (unsigned long)(syncs_count * LCEC_SYNCS_FIXED_SIZE - syncs_size));
+    }
+
     // collect and register PDO entries separately for every Sync Unit/domain
     for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
       sync_unit->regs = lcec_allocate_pdo_entry_reg(sync_unit->pdo_entry_count + 1);
@@ -355,6 +494,38 @@ int rtapi_app_main(void) {
         rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s PDO entry registration failed\n", master->name, sync_unit->name);
         goto fail2;
       }
+      sync_unit->process_data_len = ecrt_domain_size(sync_unit->domain);
+
+      // flatten the slaves' read/write callbacks for the cyclic path
+      if (lcec_sync_unit_build_dispatch(master, sync_unit) != 0) {
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s dispatch table setup failed\n", master->name, sync_unit->name);
+        goto fail2;
+      }
+
+      // the offsets are filled in: the drivers can set up their cyclic
+      // access, and the registration lists aren't needed anymore
+      for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+        if (slave->sync_unit == sync_unit) {
+          if (slave->proc_post_reg != NULL && slave->proc_post_reg(slave) != 0) {
+            rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s slave %s post-registration setup failed\n", master->name, slave->name);
+            goto fail2;
+          }
+          lcec_free_pdo_entry_reg(slave->regs);
+          slave->regs = NULL;
+        }
+      }
+      lcec_free_pdo_entry_reg(sync_unit->regs);
+      sync_unit->regs = NULL;
+    }
+
+    // stagger slow Sync Units over their divider window
+    if (lcec_sync_unit_spread_phases(master) != 0) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit phase assignment failed\n", master->name);
+      goto fail2;
+    }
+    for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+      rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "master %s syncUnit %s divider=%u phase=%d size=%d\n", master->name, sync_unit->name,
+          sync_unit->cycle_divider, sync_unit->cycle_phase, sync_unit->process_data_len);
     }
 
     // init hal data
@@ -363,14 +534,29 @@ int rtapi_app_main(void) {
       rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failure to init hal pins for slave %s.%s\n", master->name, slave->name);
       goto fail2;
     }
+    if ((master->timing = lcec_timing_init(name, master_timing_sections, LCEC_TIMING_MASTER_COUNT)) == NULL) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failure to init timing pins for master %s\n", master->name);
+      goto fail2;
+    }
+    if (master->recorder_cycles > 0 && (master->recorder = lcec_recorder_init(master, name, master->recorder_cycles)) == NULL) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failure to init flight recorder for master %s\n", master->name);
+      goto fail2;
+    }
 
 #ifdef RTAPI_TASK_PLL_SUPPORT
     // set default PLL_STEP: use +/-0.1% of period
     master->hal_data->pll_step = master->app_time_period / 1000;
     // set default PLL_MAX_ERR: one period
     master->hal_data->pll_max_err = master->app_time_period;
-    // Initialize auto-drift delay counter (wait 100 cycles before applying)
-    master->hal_data->auto_drift_delay = 100;
+    master->pll.period = master->app_time_period;
+    master->pll.sync_to_ref_clock = master->sync_to_ref_clock;
+    // PI controller (pll-controller=1): closes 5% of the error per cycle,
+    // integrator time constant ~100 cycles, output limited to +/-0.5% of period
+    master->hal_data->pll_kp = 0.05;
+    master->hal_data->pll_ki = 0.0005;
+    master->hal_data->pll_max_out = master->app_time_period / 200;
+    // sync0-tune margin: 5% of period
+    master->hal_data->sync0_margin = master->app_time_period / 20;
 #endif
     // DC synchrony convergence threshold: 4% of period (10 us at 4 kHz);
     // app_time_period can be 0 here when the XML omits appTimePeriod.
@@ -378,6 +564,14 @@ int rtapi_app_main(void) {
     // Monitor on by default (one broadcast datagram per cycle); setp to 0
     // for zero overhead when the dc-sync pins are unused.
     master->hal_data->dc_sync_monitor = 1;
+    master->hal_data->dc_slave_monitor = 1;
+    *(master->hal_data->dc_worst_slave) = -1;
+    master->dc_diff_worst_index = -1;
+    // Poll every slave's state once per second, spread evenly over the
+    // cycles of that second.
+    master->hal_data->state_poll_period = LCEC_STATE_UPDATE_PERIOD;
+    // Don't run drivers on stale process data of slaves that left OP.
+    master->hal_data->skip_non_op = 1;
 
     // Activate master (only when initf is unavailable; otherwise lcec.activate
     // funct does it from RT context after the user's `initf lcec.activate <thread>`).
@@ -399,6 +593,44 @@ int rtapi_app_main(void) {
       rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s write funct export failed\n", master->name);
       goto fail2;
     }
+    // export split-phase functions: read = receive + inputs, write = outputs + send
+    rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.receive", LCEC_MODULE_NAME, master->name);
+    if (hal_export_funct(name, lcec_receive_master, master, 0, 0, lcec_comp_id) != 0) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s receive funct export failed\n", master->name);
+      goto fail2;
+    }
+    rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.inputs", LCEC_MODULE_NAME, master->name);
+    if (hal_export_funct(name, lcec_inputs_master, master, 0, 0, lcec_comp_id) != 0) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s inputs funct export failed\n", master->name);
+      goto fail2;
+    }
+    rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.outputs", LCEC_MODULE_NAME, master->name);
+    if (hal_export_funct(name, lcec_outputs_master, master, 0, 0, lcec_comp_id) != 0) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s outputs funct export failed\n", master->name);
+      goto fail2;
+    }
+    rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.send", LCEC_MODULE_NAME, master->name);
+    if (hal_export_funct(name, lcec_send_master, master, 0, 0, lcec_comp_id) != 0) {
+      rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s send funct export failed\n", master->name);
+      goto fail2;
+    }
+
+    // export read/write functions of Sync Units that run in their own thread
+    for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+      if (!sync_unit->own_functs) {
+        continue;
+      }
+      rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.%s.read", LCEC_MODULE_NAME, master->name, sync_unit->name);
+      if (hal_export_funct(name, lcec_read_sync_unit, sync_unit, 0, 0, lcec_comp_id) != 0) {
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s read funct export failed\n", master->name, sync_unit->name);
+        goto fail2;
+      }
+      rtapi_snprintf(name, HAL_NAME_LEN, "%s.%s.%s.write", LCEC_MODULE_NAME, master->name, sync_unit->name);
+      if (hal_export_funct(name, lcec_write_sync_unit, sync_unit, 0, 0, lcec_comp_id) != 0) {
+        rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s syncUnit %s write funct export failed\n", master->name, sync_unit->name);
+        goto fail2;
+      }
+    }
   }
 
   // export activate funct (initf path only): user is expected to register it
@@ -424,7 +656,8 @@ int rtapi_app_main(void) {
     goto fail2;
   }
 
-  rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "installed driver for %d slaves\n", slave_count);
+  rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "installed driver for %d slaves, %lu bytes of HAL memory used\n", slave_count,
+      (unsigned long)lcec_hal_malloc_total());
   hal_ready(lcec_comp_id);
   return 0;
 
@@ -559,6 +792,7 @@ int lcec_parse_config(void) {
         //   true: DC is clock source, servo thread syncs to DC via PLL
         // Note: legacy mode - negative refClockSyncCycles enables sync_to_ref_clock
         master->sync_to_ref_clock = master_conf->syncToRefClock;
+        master->recorder_cycles = master_conf->recorderCycles;
 
         // add master to list
         LCEC_LIST_APPEND(first_master, last_master, master);
@@ -608,13 +842,15 @@ int lcec_parse_config(void) {
         slave->sync_unit_cycle = slave_conf->syncUnitCycle;
         slave->master = master;
 
-        slave->sync_unit = lcec_master_get_sync_unit(master, slave->sync_unit_name, slave->sync_unit_cycle);
+        slave->sync_unit = lcec_master_get_sync_unit(
+            master, slave->sync_unit_name, slave->sync_unit_cycle, slave_conf->syncUnitPhase, slave_conf->syncUnitFuncts);
         if (slave->sync_unit == NULL) {
           goto fail2;
         }
 
         // add slave to list
         LCEC_LIST_APPEND(master->first_slave, master->last_slave, slave);
+        master->slave_count++;
 
         if (type != NULL) {
           // normal slave
@@ -639,12 +875,8 @@ int lcec_parse_config(void) {
           slave->generic_pdo_entry_count = slave_conf->pdoMappingCount;
           slave->proc_init = lcec_generic_init;
 
-          // alloc hal memory
-          if ((generic_hal_data = LCEC_HAL_ALLOCATE_ARRAY(lcec_generic_pin_t, slave_conf->pdoMappingCount)) == NULL) {
-            rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "hal_malloc() for slave %s.%s failed\n", master->name, slave_conf->name);
-            goto fail2;
-          }
-          memset(generic_hal_data, 0, sizeof(lcec_generic_pin_t) * slave_conf->pdoMappingCount);
+          // alloc pin descriptions; lcec_generic_init() moves them to hal memory
+          generic_hal_data = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, slave_conf->pdoMappingCount);
 
           // alloc pdo entry memory
           generic_pdo_entries = LCEC_ALLOCATE_ARRAY(ec_pdo_entry_info_t, slave_conf->pdoEntryCount);
@@ -1021,6 +1253,7 @@ fail0:
 void lcec_clear_config(void) {
   lcec_master_t *master, *prev_master;
   lcec_slave_t *slave, *prev_slave;
+  lcec_sync_unit_t *sync_unit;
 
   // iterate all masters
   master = last_master;
@@ -1036,14 +1269,27 @@ void lcec_clear_config(void) {
       if (slave->proc_cleanup != NULL) {
         slave->proc_cleanup(slave);
       }
+      lcec_free_pdo_entry_reg(slave->regs);
+      slave->regs = NULL;
 
       slave = prev_slave;
     }
 
+    for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+      lcec_free_pdo_entry_reg(sync_unit->regs);
+      sync_unit->regs = NULL;
+    }
+
     // release master
     if (master->master) {
       ecrt_release_master(master->master);
     }
+    if (master->trace != NULL) {
+      rtapi_shmem_delete(master->trace_shmem_id, lcec_comp_id);
+    }
+    if (master->recorder != NULL) {
+      lcec_recorder_free(master->recorder);
+    }
 
     master = prev_master;
   }
@@ -1133,6 +1379,7 @@ void lcec_update_slave_state_hal(lcec_slave_state_t *hal_data, ec_slave_config_s
 /// @brief Update all input pins across all masters and slaves.
 void lcec_read_all(void *arg, long period) {
   lcec_master_t *master;
+  long long start = lcec_timing_begin(global_timing);
 
   // initialize global state
   global_ms.slaves_responding = 0;
@@ -1146,16 +1393,60 @@ void lcec_read_all(void *arg, long period) {
 
   // update global state pins
   lcec_update_master_hal(global_hal_data, &global_ms);
+
+  lcec_timing_end(global_timing, LCEC_TIMING_READ_ALL, start);
 }
 
 /// @brief Update all output pins across all masters and slaves.
 void lcec_write_all(void *arg, long period) {
   lcec_master_t *master;
+  long long start = lcec_timing_begin(global_timing);
 
   // process slaves
   for (master = first_master; master != NULL; master = master->next) {
     lcec_write_master(master, period);
   }
+
+  lcec_timing_end(global_timing, LCEC_TIMING_WRITE_ALL, start);
+}
+
+/// @brief Update the input pins of a Sync Unit with `syncUnitFuncts`.
+///
+/// Runs in the Sync Unit's own, usually slower, thread.  The master's
+/// functs still exchange the frames; they own the process data while
+/// the Sync Unit's datagram is on the wire.  Never wait for them: if
+/// the datagram has not come back yet, keep last cycle's pins.
+void lcec_read_sync_unit(void *arg, long period) {
+  lcec_sync_unit_t *sync_unit = (lcec_sync_unit_t *)arg;
+
+  if (!sync_unit->master->activated) {
+    return;
+  }
+
+  if (rtapi_mutex_try(&sync_unit->mutex) != 0) {
+    return;
+  }
+  lcec_sync_unit_read(sync_unit->master, sync_unit);
+  rtapi_mutex_give(&sync_unit->mutex);
+}
+
+/// @brief Write the output pins of a Sync Unit with `syncUnitFuncts`.
+///
+/// The outputs are sent with the next frame the master's functs queue
+/// for this Sync Unit.  Like `lcec_read_sync_unit()`, skips the tick
+/// while the datagram is on the wire.
+void lcec_write_sync_unit(void *arg, long period) {
+  lcec_sync_unit_t *sync_unit = (lcec_sync_unit_t *)arg;
+
+  if (!sync_unit->master->activated) {
+    return;
+  }
+
+  if (rtapi_mutex_try(&sync_unit->mutex) != 0) {
+    return;
+  }
+  lcec_sync_unit_write(sync_unit->master, sync_unit);
+  rtapi_mutex_give(&sync_unit->mutex);
 }
 
 /// @brief HAL init funct (registered via halcmd `initf`) that activates every
@@ -1171,6 +1462,9 @@ static void lcec_activate(void *arg, long period) {
     if (!master->activated) {
       if (lcec_activate_master(master) == 0) {
         master->initf_activated = 1;
+#ifdef RTAPI_TASK_PLL_SUPPORT
+        master->pll.initf_activated = 1;
+#endif
       }
       // on activation failure, lcec_activate_master already logged; leaving
       // initf_activated unset means the BANG-BANG safety net will run if a
@@ -1199,7 +1493,6 @@ static int lcec_activate_master(lcec_master_t *master) {
   master->app_time_base = EC_TIMEVAL2NANO(tv);
 
 #ifdef RTAPI_TASK_PLL_SUPPORT
-  master->dc_time_valid_last = 0;
   master->dc_ref = 0;
   if (!master->sync_to_ref_clock) {
     long long rtapi_now = rtapi_get_time();
@@ -1224,13 +1517,14 @@ static int lcec_activate_master(lcec_master_t *master) {
   // This sets dc_ref_time in the kernel, which is needed for DC SYNC0 phase calculation
   ecrt_master_application_time(master->master, initial_app_time);
 #ifdef RTAPI_TASK_PLL_SUPPORT
-  master->dc_ref_time = initial_app_time;  // Record the same value we sent to kernel
+  lcec_pll_start(&master->pll, initial_app_time, rtapi_get_time());  // Record the same value we sent to kernel
 #endif
   rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "Initial app_time set to %llu\n", (unsigned long long)initial_app_time);
 
   // Activate master
   if (ecrt_master_activate(master->master)) {
     rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "failed to activate master %s\n", master->name);
+    lcec_trace_event(master->trace, LCEC_TRACE_ACTIVATE, -1, (uint32_t)-1, 0);
     return -1;
   }
 
@@ -1238,39 +1532,307 @@ static int lcec_activate_master(lcec_master_t *master) {
   for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
     sync_unit->process_data = ecrt_domain_data(sync_unit->domain);
     sync_unit->process_data_len = ecrt_domain_size(sync_unit->domain);
-    if (master->process_data == NULL) {
-      master->process_data = sync_unit->process_data;
-      master->process_data_len = sync_unit->process_data_len;
-    }
     rtapi_print_msg(RTAPI_MSG_DBG, LCEC_MSG_PFX "master %s syncUnit %s cycle=%u ns divider=%u process_data_len=%d\n", master->name,
         sync_unit->name, sync_unit->cycle_time, sync_unit->cycle_divider, sync_unit->process_data_len);
   }
 
   master->activated = 1;
+  lcec_trace_event(master->trace, LCEC_TRACE_ACTIVATE, -1, 0, 0);
   rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "Master %s activated successfully\n", master->name);
 
   return 0;
 }
 
+/// @brief Take the master lock from the cyclic path.
+///
+/// The EtherCAT master's own non-RT work (SDOs, EoE, ...) can hold the
+/// lock in the kernel build.  Work that must happen this cycle waits
+/// for it, but at most `period / LCEC_LOCK_WAIT_DIVIDER`; the wait is
+/// counted and timed, and callers skip optional work after waiting.
+///
+/// @return 0 if the lock was free, 1 if this had to wait for it, -1 if
+/// it gave up and the caller does not hold the lock.
+static int lcec_master_lock_rt(lcec_master_t *master, long period) {
+  lcec_master_data_t *hal_data = master->hal_data;
+  long long start, now;
+  hal_u32_t wait;
+  int ret = 1;
+
+  if (rtapi_mutex_try(&master->mutex) == 0) {
+    return 0;
+  }
+
+  start = rtapi_get_time();
+  while (rtapi_mutex_try(&master->mutex) != 0) {
+    now = rtapi_get_time();
+    if (now - start >= period / LCEC_LOCK_WAIT_DIVIDER) {
+      (*(hal_data->lock_defer_cnt))++;
+      ret = -1;
+      break;
+    }
+  }
+  wait = rtapi_get_time() - start;
+
+  (*(hal_data->lock_wait_cnt))++;
+  lcec_trace_event(master->trace, LCEC_TRACE_LOCK_WAIT, -1, wait, ret < 0);
+  if (wait > *(hal_data->lock_wait_max)) {
+    *(hal_data->lock_wait_max) = wait;
+  }
+  return ret;
+}
+
+/// @brief Count a DC poll skipped because the master lock was busy.
+///
+/// A skipped poll counts as a miss.  After `LCEC_DC_DIFF_TIMEOUT` in a
+/// row, `dc-sync-converged` is cleared, since nothing has been measured
+/// for that long.
+static void lcec_dc_poll_skipped(lcec_master_t *master) {
+  lcec_master_data_t *hal_data = master->hal_data;
+
+  (*(hal_data->lock_defer_cnt))++;
+  if (++hal_data->dc_skip_cnt >= LCEC_DC_DIFF_TIMEOUT) {
+    *(hal_data->dc_sync_converged) = 0;
+  }
+}
+
+/// @brief Poll the state of the next batch of slaves, round-robin.
+///
+/// Until the master first reaches OP every slave is polled every
+/// cycle.  After that, each cycle polls `state-poll-batch` slaves,
+/// continuing where the previous cycle stopped, so the cost of a
+/// full sweep is spread over many cycles instead of hitting one.
+/// With `state-poll-batch` = 0 the batch size is chosen so a full
+/// sweep takes about `state-poll-period`.  The master lock is taken
+/// once per batch, and the batch is deferred to the next cycle if the
+/// lock is busy.  The polled states also feed the Sync Units'
+/// operational bitmaps, which decide whose drivers are skipped.
+static void lcec_poll_slave_states(lcec_master_t *master, long period) {
+  lcec_master_data_t *hal_data = master->hal_data;
+  lcec_slave_t *first, *slave;
+  int batch, i;
+
+  if (master->first_slave == NULL) {
+    return;
+  }
+
+  if (!master->sync_units_started) {
+    batch = master->slave_count;
+  } else if (hal_data->state_poll_batch > 0) {
+    batch = hal_data->state_poll_batch;
+  } else {
+    long cycles = (hal_data->state_poll_period > period) ? hal_data->state_poll_period / period : 1;
+    batch = (master->slave_count + cycles - 1) / cycles;
+  }
+  if (batch > master->slave_count) {
+    batch = master->slave_count;
+  }
+
+  first = (master->state_poll_next != NULL) ? master->state_poll_next : master->first_slave;
+
+  // not worth waiting for: the same batch is polled next cycle
+  if (rtapi_mutex_try(&master->mutex) != 0) {
+    (*(hal_data->lock_defer_cnt))++;
+    return;
+  }
+  for (slave = first, i = 0; i < batch; i++) {
+    unsigned int al_state = slave->state.al_state;
+    unsigned int operational = slave->state.operational;
+    ecrt_slave_config_state(slave->config, &slave->state);
+    if (slave->state.al_state != al_state) {
+      lcec_trace_event(master->trace, LCEC_TRACE_SLAVE_STATE, slave->index, al_state, slave->state.al_state);
+    }
+    if (operational && !slave->state.operational && master->recorder != NULL && master->recorder->trigger_oper) {
+      lcec_recorder_trigger(master->recorder, LCEC_RECORDER_TRIGGER_OPER);
+    }
+    slave = (slave->next != NULL) ? slave->next : master->first_slave;
+  }
+  rtapi_mutex_give(&master->mutex);
+  master->state_poll_next = slave;
+
+  for (slave = first, i = 0; i < batch; i++) {
+    lcec_update_slave_state_hal(slave->hal_state_data, &slave->state);
+    if (slave->dispatch_index >= 0) {
+      master->slaves_skipped +=
+          lcec_sync_unit_set_oper(slave->sync_unit, slave->dispatch_index, slave->state.operational || !hal_data->skip_non_op);
+    }
+    slave = (slave->next != NULL) ? slave->next : master->first_slave;
+  }
+  *(hal_data->slaves_skipped) = master->slaves_skipped;
+}
+
+/// @brief Read the DC system time difference (0x092C) of the slaves, round-robin.
+///
+/// Every slave with DC configured has a register request, and only one
+/// of them is in flight at a time, so the extra bus load is one small
+/// datagram regardless of the number of slaves.  Each cycle checks the
+/// read in flight; once it has completed, the next online slave's read
+/// is started.  A read that stays busy for `LCEC_DC_DIFF_TIMEOUT` cycles,
+/// including cycles skipped because the master lock was busy, is
+/// abandoned.  `dc-worst-slave` and `dc-worst-diff` are updated after
+/// every sweep.
+static void lcec_poll_dc_diff(lcec_master_t *master) {
+  lcec_master_data_t *hal_data = master->hal_data;
+  lcec_slave_t *slave = master->dc_diff_slave;
+  lcec_slave_t *next;
+  int done = 0;
+  uint32_t raw = 0;
+
+  if (master->first_dc_slave == NULL || !hal_data->dc_slave_monitor || !master->sync_units_started) {
+    return;
+  }
+
+  // not worth waiting for: the read is checked again next cycle, and a
+  // skipped cycle counts towards the read's timeout
+  if (rtapi_mutex_try(&master->mutex) != 0) {
+    master->dc_diff_wait++;
+    lcec_dc_poll_skipped(master);
+    return;
+  }
+  hal_data->dc_skip_cnt = 0;
+  if (master->dc_diff_pending) {
+    ec_request_state_t state = ecrt_reg_request_state(slave->dc_diff_req);
+
+    if (state == EC_REQUEST_BUSY && ++master->dc_diff_wait < LCEC_DC_DIFF_TIMEOUT) {
+      rtapi_mutex_give(&master->mutex);
+      return;
+    }
+    if (state == EC_REQUEST_SUCCESS) {
+      raw = EC_READ_U32(ecrt_reg_request_data(slave->dc_diff_req));
+      done = 1;
+    }
+    master->dc_diff_pending = 0;
+  }
+
+  next = (slave != NULL && slave->dc_next != NULL) ? slave->dc_next : master->first_dc_slave;
+  // an offline slave's request would never complete
+  if (next->state.online && ecrt_reg_request_state(next->dc_diff_req) != EC_REQUEST_BUSY) {
+    ecrt_reg_request_read(next->dc_diff_req, 0x092C, 4);
+    master->dc_diff_pending = 1;
+    master->dc_diff_wait = 0;
+  }
+  master->dc_diff_slave = next;
+  rtapi_mutex_give(&master->mutex);
+
+  if (done) {
+    // bit 31 set: the slave's copy of the system time is behind
+    uint32_t diff = raw & 0x7fffffffu;
+
+    *(slave->hal_state_data->dc_time_diff) = (raw & 0x80000000u) ? -(int32_t)diff : (int32_t)diff;
+    if (master->dc_diff_worst_index < 0 || diff > master->dc_diff_worst) {
+      master->dc_diff_worst = diff;
+      master->dc_diff_worst_index = slave->index;
+    }
+  }
+  if (next == master->first_dc_slave && slave != NULL) {
+    *(hal_data->dc_worst_slave) = master->dc_diff_worst_index;
+    *(hal_data->dc_worst_diff) = master->dc_diff_worst;
+    master->dc_diff_worst = 0;
+    master->dc_diff_worst_index = -1;
+  }
+}
+
+#ifdef RTAPI_TASK_PLL_SUPPORT
+/// @brief Measure when frames leave, and compute the smallest safe `sync0Shift` per slave.
+///
+/// Runs while the `sync0-tune` pin is set, once all slaves are in OP.
+/// After `LCEC_SYNC0_TUNE_CYCLES` cycles it takes the latest send phase
+/// seen and the largest frame, adds the frame's time to each DC slave
+/// and `sync0-margin`, and logs the result next to the configured
+/// value.  The shift is only recommended: DC settings are written to
+/// the slaves when they are configured, so a new value goes into the
+/// XML and takes effect at the next start.
+static void lcec_sync0_tune(lcec_master_t *master, int32_t send_phase, uint32_t bytes) {
+  lcec_master_data_t *hal_data = master->hal_data;
+  lcec_slave_t *slave;
+  int32_t send_typ;
+
+  if (!master->sync_units_started) {
+    return;
+  }
+
+  if (master->sync0_tune_cnt == 0) {
+    master->sync0_send_max = send_phase;
+    master->sync0_send_sum = 0;
+    master->sync0_bytes_max = 0;
+  }
+  if (send_phase > master->sync0_send_max) {
+    master->sync0_send_max = send_phase;
+  }
+  if (bytes > master->sync0_bytes_max) {
+    master->sync0_bytes_max = bytes;
+  }
+  master->sync0_send_sum += send_phase;
+  if (++master->sync0_tune_cnt < LCEC_SYNC0_TUNE_CYCLES) {
+    return;
+  }
+
+  master->sync0_tune_cnt = 0;
+  *(hal_data->sync0_tune) = 0;
+  *(hal_data->sync0_send_phase) = master->sync0_send_max;
+  send_typ = (int32_t)(master->sync0_send_sum >> LCEC_SYNC0_TUNE_SHIFT);
+  rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "master %s sync0-tune: frames sent at %d ns typical, %d ns latest, %u bytes\n", master->name,
+      send_typ, master->sync0_send_max, master->sync0_bytes_max);
+
+  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+    int32_t safe, latency, configured;
+
+    if (slave->dc_conf == NULL) {
+      continue;
+    }
+    configured = slave->dc_conf->sync0Shift;
+    safe = lcec_sync0_safe_shift(master->sync0_send_max, master->sync0_bytes_max, slave->index, hal_data->sync0_margin);
+    latency = lcec_sync0_latency(master->app_time_period, safe, send_typ, master->sync0_bytes_max, slave->index);
+    *(slave->hal_state_data->sync0_shift_safe) = safe;
+    *(slave->hal_state_data->sync0_latency) = latency;
+
+    if (configured < safe - (int32_t)hal_data->sync0_margin) {
+      rtapi_print_msg(RTAPI_MSG_WARN,
+          LCEC_MSG_PFX "slave %s.%s: sync0Shift %d is too small, outputs can arrive after SYNC0; use %d (latency %d ns)\n",
+          master->name, slave->name, configured, safe, latency);
+    } else {
+      rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "slave %s.%s: sync0Shift %d, latency %d ns; smallest safe %d, latency %d ns\n",
+          master->name, slave->name, configured,
+          lcec_sync0_latency(master->app_time_period, configured, send_typ, master->sync0_bytes_max, slave->index), safe, latency);
+    }
+  }
+}
+#endif
+
 /// @brief Read all input pins on a master and its slaves.
+///
+/// Same as `receive` followed by `inputs`.
 void lcec_read_master(void *arg, long period) {
   lcec_master_t *master = (lcec_master_t *)arg;
-  lcec_slave_t *slave;
+  long long start = lcec_timing_begin(master->timing);
+
+  lcec_receive_master(master, period);
+  lcec_inputs_master(master, period);
+
+  lcec_timing_end(master->timing, LCEC_TIMING_READ, start);
+}
+
+/// @brief Receive the frames sent by the last `send` and update the
+/// master and slave state pins.
+void lcec_receive_master(void *arg, long period) {
+  lcec_master_t *master = (lcec_master_t *)arg;
   lcec_sync_unit_t *sync_unit;
   int check_states;
+  long long mark;
 
   // Master not yet activated: process_data is NULL until lcec_activate_master()
   // runs. On new (initf-capable) linuxcnc loaded with a legacy .hal that omits
-  // `initf lcec.activate <thread>`, lcec_write_master() inline-activates as a
+  // `initf lcec.activate <thread>`, lcec_outputs_master() inline-activates as a
   // fallback -- but read-all is conventionally addf'd *before* write-all, so
-  // without this bail the slave proc_read below dereferences the NULL
+  // without this bail the slave proc_read in inputs dereferences the NULL
   // process_data and SIGSEGVs the whole realtime before write-all ever runs.
-  // Skip this cycle; write_master activates the master and reads resume on the
+  // Skip this cycle; outputs activates the master and reads resume on the
   // next tick. This keeps `initf` optional and old configs crash-free.
   if (!master->activated) {
     return;
   }
 
+  mark = lcec_timing_begin(master->timing);
+
   // check period. If the XML omitted appTimePeriod, master->app_time_period
   // is 0 and the modulo at lcec_main.c:1258 would SIGFPE on the first cycle;
   // adopt the actual HAL servo period so the XML attribute is optional.
@@ -1295,24 +1857,50 @@ void lcec_read_master(void *arg, long period) {
     master->state_update_timer -= period;
   } else {
     check_states = 1;
-    master->state_update_timer = LCEC_STATE_UPDATE_PERIOD;
+    master->state_update_timer = master->hal_data->state_poll_period;
   }
 
   // receive process data & master state
   ec_domain_state_t domain_state;
   int all_domains_zero = 1;
   int all_domains_complete = 1;
-  uint32_t dc_sync_diff;
-  rtapi_mutex_get(&master->mutex);
+  uint32_t dc_sync_diff = 0xffffffffu;
+  int dc_sync_read;
+  uint8_t *rec_data;
+  uint32_t rec_fresh = 0;
+  int i;
+  int contended = lcec_master_lock_rt(master, period);
+  if (contended < 0) {
+    // the frames are still picked up next cycle; until then, no inputs
+    for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+      sync_unit->process = 0;
+    }
+    if (master->dc_sync_queued) {
+      lcec_dc_poll_skipped(master);
+    }
+    lcec_timing_end(master->timing, LCEC_TIMING_RECEIVE, mark);
+    return;
+  }
+  rec_data = (master->recorder != NULL) ? lcec_recorder_begin(master->recorder) : NULL;
   ecrt_master_receive(master->master);
+  lcec_timing_mark(master->timing, LCEC_TIMING_RECEIVE, &mark);
   domain_state.working_counter = 0;
-  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+  for (sync_unit = master->first_sync_unit, i = 0; sync_unit != NULL; sync_unit = sync_unit->next, i++) {
     ec_domain_state_t sync_unit_state;
 
     sync_unit->process = sync_unit->queued;
     if (sync_unit->process) {
       ecrt_domain_process(sync_unit->domain);
       sync_unit->queued = 0;
+      if (rec_data != NULL && i < LCEC_RECORDER_MAX_UNITS) {
+        memcpy(rec_data + master->recorder->shm->units[i].offset, sync_unit->process_data, sync_unit->process_data_len);
+        rec_fresh |= 1u << i;
+      }
+    }
+    // the frame is back, hand the process data to the Sync Unit's own functs
+    if (sync_unit->in_flight) {
+      sync_unit->in_flight = 0;
+      rtapi_mutex_give(&sync_unit->mutex);
     }
 
     // Aggregate the most recent state of every Sync Unit so the master WKC
@@ -1328,14 +1916,35 @@ void lcec_read_master(void *arg, long period) {
     }
   }
   domain_state.wc_state = all_domains_complete ? EC_WC_COMPLETE : (all_domains_zero ? EC_WC_ZERO : EC_WC_INCOMPLETE);
-  dc_sync_diff = master->hal_data->dc_sync_monitor ? ecrt_master_sync_monitor_process(master->master) : 0xffffffffu;
-  if (check_states) {
+  if (rec_data != NULL) {
+    lcec_recorder_end(master->recorder, rec_fresh, domain_state.working_counter, domain_state.wc_state);
+  }
+  // After waiting for the lock, only do what this cycle's data needs and
+  // leave the DC monitor and master state for a later cycle.
+  dc_sync_read = 0;
+  if (master->dc_sync_queued && contended) {
+    lcec_dc_poll_skipped(master);
+  } else if (master->dc_sync_queued) {
+    dc_sync_diff = ecrt_master_sync_monitor_process(master->master);
+    master->dc_sync_queued = 0;
+    master->hal_data->dc_skip_cnt = 0;
+    dc_sync_read = 1;
+  }
+  if (check_states && contended) {
+    master->state_update_timer = 0;
+    (*(master->hal_data->lock_defer_cnt))++;
+  } else if (check_states) {
+    unsigned int al_states = master->ms.al_states;
     ecrt_master_state(master->master, &master->ms);
+    if (master->ms.al_states != al_states) {
+      lcec_trace_event(master->trace, LCEC_TRACE_MASTER_STATE, -1, al_states, master->ms.al_states);
+    }
   }
   if (!master->sync_units_started && lcec_master_all_op(master)) {
     master->sync_units_started = 1;
   }
   rtapi_mutex_give(&master->mutex);
+  lcec_timing_mark(master->timing, LCEC_TIMING_PROCESS, &mark);
 
   // update state pins
   lcec_update_master_hal(master->hal_data, &master->ms);
@@ -1372,6 +1981,10 @@ void lcec_read_master(void *arg, long period) {
       // RT thread; the change counter pin + recorder are the log
       if (wkc_now != hd->wkc_last) {
         (*(hd->wkc_change_cnt))++;
+        lcec_trace_event(master->trace, LCEC_TRACE_WKC, -1, hd->wkc_last, wkc_now);
+      }
+      if (master->recorder != NULL && master->recorder->trigger_wkc && domain_state.wc_state != EC_WC_COMPLETE) {
+        lcec_recorder_trigger(master->recorder, LCEC_RECORDER_TRIGGER_WKC);
       }
     }
     hd->wkc_last = wkc_now;
@@ -1380,13 +1993,15 @@ void lcec_read_master(void *arg, long period) {
     // 0xffffffff means the monitor datagram was not received this cycle.
     // Tolerate a few consecutive misses (startup, single datagram timeouts),
     // then invalidate so a dead bus cannot keep showing stale-converged.
-    if (hd->dc_sync_monitor) {
+    if (dc_sync_read) {
       if (dc_sync_diff != 0xffffffffu) {
         hd->dc_sync_miss_cnt = 0;
         *(hd->dc_sync_diff) = dc_sync_diff;
         *(hd->dc_sync_converged) = (dc_sync_diff < hd->dc_sync_max);
       } else if (hd->dc_sync_miss_cnt < LCEC_DC_SYNC_MISS_MAX) {
+        // traced only up to the limit, so a dead bus can't flood the ring
         hd->dc_sync_miss_cnt++;
+        lcec_trace_event(master->trace, LCEC_TRACE_DC_SYNC_MISS, -1, hd->dc_sync_miss_cnt, 0);
       } else {
         *(hd->dc_sync_converged) = 0;
         *(hd->dc_sync_diff) = 0xffffffffu;
@@ -1399,46 +2014,63 @@ void lcec_read_master(void *arg, long period) {
   global_ms.al_states |= master->ms.al_states;
   global_ms.link_up = global_ms.link_up && master->ms.link_up;
 
-  // process slaves
-  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
-    // get slaves state
-    rtapi_mutex_get(&master->mutex);
-    if (check_states) {
-      ecrt_slave_config_state(slave->config, &slave->state);
-    }
-    rtapi_mutex_give(&master->mutex);
-    if (check_states) {
-      lcec_update_slave_state_hal(slave->hal_state_data, &slave->state);
-    }
+  // get slaves state
+  lcec_poll_slave_states(master, period);
+  lcec_poll_dc_diff(master);
+  lcec_timing_end(master->timing, LCEC_TIMING_STATE, mark);
+}
+
+/// @brief Call the read functions of the Sync Units received by the
+/// last `receive`, updating the slaves' input pins.
+void lcec_inputs_master(void *arg, long period) {
+  lcec_master_t *master = (lcec_master_t *)arg;
+  lcec_sync_unit_t *sync_unit;
+  long long start;
+
+  // see lcec_receive_master()
+  if (!master->activated) {
+    return;
+  }
+
+  start = lcec_timing_begin(master->timing);
 
-    // process read function
-    if (slave->sync_unit->process && slave->proc_read != NULL) {
-      master->process_data = slave->sync_unit->process_data;
-      master->process_data_len = slave->sync_unit->process_data_len;
-      slave->proc_read(slave, slave->sync_unit->cycle_time);
+  // process read functions of the Sync Units exchanged this cycle
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->process && !sync_unit->own_functs) {
+      lcec_sync_unit_read(master, sync_unit);
     }
   }
+
+  lcec_timing_end(master->timing, LCEC_TIMING_READ_CALLBACKS, start);
 }
 
 /// @brief Write all output pins on a master and its slaves.
+///
+/// Same as `outputs` followed by `send`.
 void lcec_write_master(void *arg, long period) {
   lcec_master_t *master = (lcec_master_t *)arg;
-  lcec_slave_t *slave;
+  long long start = lcec_timing_begin(master->timing);
+
+  lcec_outputs_master(master, period);
+  lcec_send_master(master, period);
+
+  lcec_timing_end(master->timing, LCEC_TIMING_WRITE, start);
+}
+
+/// @brief Pick the Sync Units to exchange this cycle and call their
+/// write functions, copying the slaves' output pins into process data.
+void lcec_outputs_master(void *arg, long period) {
+  lcec_master_t *master = (lcec_master_t *)arg;
   lcec_sync_unit_t *sync_unit;
   int force_cycle;
-  uint64_t app_time;
-  long long now;
-#ifdef RTAPI_TASK_PLL_SUPPORT
-  long long ref;
-  lcec_master_data_t *hal_data;
-#endif
+  long long start;
 
   // First cyclic tick observed master not yet activated. This means the user
   // did not register `lcec.activate` via initf (forgot the line in their .hal).
   // Fall back to inline activation so the machine still runs; warn loudly so
   // the user fixes their config. initf_activated stays 0, so the BANG-BANG
-  // safety net below will trim the dirty app_phase over the next few hundred
-  // cycles, just like the legacy path.
+  // safety net in lcec_send_master() will trim the dirty app_phase over the
+  // next few hundred cycles, just like the legacy path.
   if (!master->activated) {
     if (!master->forgot_warned) {
       master->forgot_warned = 1;
@@ -1454,13 +2086,17 @@ void lcec_write_master(void *arg, long period) {
     }
   }
 
+  start = lcec_timing_begin(master->timing);
+
   // Keep all domains cycling during startup. Once OP has been reached, run
-  // each Sync Unit at its configured integer divider.
+  // each Sync Unit at its configured integer divider, first exchanging it
+  // `cycle_phase` cycles in so slow units do not all share one frame.
   force_cycle = !master->sync_units_started;
   for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    sync_unit->safe_outputs = master->hal_data->safe_outputs;
     if (force_cycle) {
       sync_unit->write = 1;
-      sync_unit->cycle_counter = 0;
+      sync_unit->cycle_counter = sync_unit->cycle_phase;
     } else if (sync_unit->cycle_counter == 0) {
       sync_unit->write = 1;
       sync_unit->cycle_counter = sync_unit->cycle_divider - 1;
@@ -1470,28 +2106,77 @@ void lcec_write_master(void *arg, long period) {
     }
   }
 
-  // process slaves
-  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
-    if (slave->sync_unit->write && slave->proc_write != NULL) {
-      master->process_data = slave->sync_unit->process_data;
-      master->process_data_len = slave->sync_unit->process_data_len;
-      slave->proc_write(slave, slave->sync_unit->cycle_time);
+  // process write functions of the Sync Units queued this cycle
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->write && !sync_unit->own_functs) {
+      lcec_sync_unit_write(master, sync_unit);
     }
   }
 
+  // start the SDO writes queued by the write functions
+  lcec_sdo_sched_run(master->sdo_sched);
+
+  lcec_timing_end(master->timing, LCEC_TIMING_WRITE_CALLBACKS, start);
+}
+
+/// @brief Queue the Sync Units picked by `outputs`, do the Distributed
+/// Clock bookkeeping and send the frames.
+void lcec_send_master(void *arg, long period) {
+  lcec_master_t *master = (lcec_master_t *)arg;
+  lcec_sync_unit_t *sync_unit;
+  hal_u32_t queued_bytes;
+  int contended;
+  uint64_t app_time;
+  long long now;
+  long long mark;
+#ifdef RTAPI_TASK_PLL_SUPPORT
+  long long ref;
+  lcec_master_data_t *hal_data;
+  lcec_pll_t *pll;
+  int32_t pll_correction;
+  int calibrated;
+  int32_t target;
+#endif
+
+  // activation happens in lcec_outputs_master()
+  if (!master->activated) {
+    return;
+  }
+
+  mark = lcec_timing_begin(master->timing);
+
 #ifdef RTAPI_TASK_PLL_SUPPORT
   // get reference time
   ref = rtapi_task_pll_get_reference();
 #endif
 
   // send process data
-  rtapi_mutex_get(&master->mutex);
+  queued_bytes = 0;
+  contended = lcec_master_lock_rt(master, period);
   for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->write && contended < 0) {
+      // no frame this cycle; the outputs go with the next one
+      sync_unit->write = 0;
+      sync_unit->cycle_counter = 0;
+      continue;
+    }
+    if (sync_unit->write && sync_unit->own_functs && !sync_unit->in_flight) {
+      // Never wait for another thread here: if the Sync Unit's functs are
+      // running, retry next cycle.
+      if (rtapi_mutex_try(&sync_unit->mutex) != 0) {
+        sync_unit->write = 0;
+        sync_unit->cycle_counter = 0;
+        continue;
+      }
+      sync_unit->in_flight = 1;
+    }
     if (sync_unit->write) {
       ecrt_domain_queue(sync_unit->domain);
       sync_unit->queued = 1;
+      queued_bytes += sync_unit->process_data_len;
     }
   }
+  *(master->hal_data->queued_bytes) = queued_bytes;
 
   // update application time
   now = rtapi_get_time();
@@ -1509,6 +2194,19 @@ void lcec_write_master(void *arg, long period) {
   app_time = master->app_time_base + now;
 #endif
 
+#ifdef RTAPI_TASK_PLL_SUPPORT
+  uint32_t dc_time = 0;
+  int dc_time_valid = 0;
+#endif
+
+  // gave up on the lock: no frame this cycle, the PLL coasts on app_time
+  if (contended < 0) {
+    if (master->hal_data->dc_sync_monitor) {
+      lcec_dc_poll_skipped(master);
+    }
+    goto no_frame;
+  }
+
   ecrt_master_application_time(master->master, app_time);
 
   // Read DC reference clock time (must be before sync_slave_clocks which
@@ -1517,8 +2215,6 @@ void lcec_write_master(void *arg, long period) {
   // to stderr from this thread. R2M also has sync_to_ref_clock == 0, so
   // both terms are needed.
 #ifdef RTAPI_TASK_PLL_SUPPORT
-  uint32_t dc_time = 0;
-  int dc_time_valid = 0;
   if (master->sync_to_ref_clock || master->sync_ref_cycles) {
     dc_time_valid = (ecrt_master_reference_clock_time(master->master, &dc_time) == 0);
   }
@@ -1538,237 +2234,73 @@ void lcec_write_master(void *arg, long period) {
   ecrt_master_sync_slave_clocks(master->master);
 
   // queue DC synchrony monitor datagram (broadcast read of 0x092C),
-  // processed next cycle in lcec_read_master
-  if (master->hal_data->dc_sync_monitor) {
+  // processed next cycle in lcec_receive_master; skipped after waiting
+  // for the lock
+  if (master->hal_data->dc_sync_monitor && contended) {
+    lcec_dc_poll_skipped(master);
+  } else if (master->hal_data->dc_sync_monitor) {
     ecrt_master_sync_monitor_queue(master->master);
+    master->dc_sync_queued = 1;
   }
 
   // send domain data
   ecrt_master_send(master->master);
   rtapi_mutex_give(&master->mutex);
 
+no_frame:
+  lcec_timing_end(master->timing, LCEC_TIMING_SEND, mark);
+
 #ifdef RTAPI_TASK_PLL_SUPPORT
-  // BANG-BANG controller for master thread PLL sync
+  // master thread PLL sync, see lcec_pll.c
   // this part is done after ecrt_master_send() to reduce jitter
   hal_data = master->hal_data;
-  *(hal_data->pll_err) = 0;
-  *(hal_data->pll_out) = 0;
-  *(hal_data->dc_phased) = 0;
-
-  // Calculate app_phase: our execution position in local cycle
-  // This is relative to dc_ref_time (the time we set at activation)
-  // app_phase = (app_time - dc_ref_time) % period
-  // This represents where we are within the current cycle since activation
-  int32_t current_app_phase = (int32_t)((app_time - master->dc_ref_time) % master->app_time_period);
-  *(hal_data->app_phase) = current_app_phase;
-  int32_t app_period = (int32_t)master->app_time_period;
-
-  // When sync_to_ref_clock = false: adjust app_phase to a stable position using PLL
-  // This is needed because app_phase is random at startup
-  if (!master->sync_to_ref_clock) {
-#define PHASE_MEASURE_CYCLES 100
-
-    if (!hal_data->phase_calibrated) {
-      // Phase 1: Measure app_phase jitter over PHASE_MEASURE_CYCLES cycles
-      if (hal_data->phase_measure_cnt == 0) {
-        // First measurement - initialize
-        hal_data->phase_min = current_app_phase;
-        hal_data->phase_max = current_app_phase;
-        hal_data->phase_last = current_app_phase;
-        hal_data->phase_measure_cnt = 1;
-      } else if (hal_data->phase_measure_cnt < PHASE_MEASURE_CYCLES) {
-        // Detect boundary crossing: if difference > app_period/2, phase wrapped around
-        int32_t diff = current_app_phase - hal_data->phase_last;
-        int32_t adjusted_phase = current_app_phase;
-
-        // Unwrap: if phase jumped by more than half period, adjust for continuity
-        if (diff > app_period / 2) {
-          // Jumped from low to high (e.g., 10000 -> 990000), adjust down
-          adjusted_phase = current_app_phase - app_period;
-        } else if (diff < -app_period / 2) {
-          // Jumped from high to low (e.g., 990000 -> 10000), adjust up
-          adjusted_phase = current_app_phase + app_period;
-        }
-
-        // Update min/max with adjusted phase
-        if (adjusted_phase < hal_data->phase_min) {
-          hal_data->phase_min = adjusted_phase;
-        }
-        if (adjusted_phase > hal_data->phase_max) {
-          hal_data->phase_max = adjusted_phase;
-        }
-
-        hal_data->phase_last = current_app_phase;
-        hal_data->phase_measure_cnt++;
-      } else {
-        // Phase 2: Calculate jitter and target position
-        hal_data->phase_jitter = hal_data->phase_max - hal_data->phase_min;
-        *(hal_data->phase_jitter_out) = hal_data->phase_jitter;  // Output jitter for debugging
-
-        // Target position: jitter + jitter/2 = jitter * 1.5
-        int32_t target = hal_data->phase_jitter + hal_data->phase_jitter / 2;
-
-        // Limit target to app_period/8
-        int32_t max_target = app_period / 8;
-        if (target > max_target) {
-          target = max_target;
-        }
-
-        hal_data->phase_target = target;
-        hal_data->phase_calibrated = 1;
-
-        rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "Phase calibration complete: jitter=%d target=%d\n", hal_data->phase_jitter,
-            hal_data->phase_target);
-      }
-    } else if (!master->initf_activated) {
-      // Phase 3: Use PLL to move app_phase towards target.
-      // Only runs when activation was dirty (legacy load-time path or inline
-      // fallback after forgot-to-initf). With initf_activated=1 the master was
-      // activated cleanly in RT context, app_phase is born stable, and the
-      // BANG-BANG would only add noise -- skip it entirely.
-      // Calculate error: how far are we from target?
-      // Positive error (app_phase > target) means we need to speed up to reduce app_phase
-      // Negative error (app_phase < target) means we need to slow down to increase app_phase
-      int32_t phase_error = current_app_phase - hal_data->phase_target;
-
-      // Set pll_err for monitoring
-      //*(hal_data->pll_err) = raw_offset + drift;
-
-      // Check if locked (within 10% of jitter or 1% of app_period, whichever is larger)
-      int32_t lock_threshold = 0;  // hal_data->phase_jitter;
-      if (lock_threshold < app_period / 100) {
-        lock_threshold = app_period / 100;
-      }
-      if (abs(phase_error) < abs(hal_data->pll_step) * 3) {
-        *(hal_data->dc_phased) = 1;
-      } else if (abs(phase_error) > abs(hal_data->pll_step) * 20) {
-        *(hal_data->dc_phased) = 0;
-      }
-
-      // BANG-BANG control: small steps to move towards target
-      // Positive pll_out = slow down = app_phase increases
-      // Negative pll_out = speed up = app_phase decreases
-      if (*(hal_data->dc_phased)) {
-        *(hal_data->pll_out) = 0;
-      } else {
-        if (phase_error > 0) {
-          *(hal_data->pll_out) = -(hal_data->pll_step);  // Speed up to reduce app_phase
-        } else if (phase_error < 0) {
-          *(hal_data->pll_out) = hal_data->pll_step;  // Slow down to increase app_phase
-        }
-      }
-
-    } else {
-      // initf_activated: clean RT-context activation, app_phase is born stable.
-      // Force PLL outputs to safe values so rtapi_task_pll_get_reference does
-      // not see stale BANG-BANG state. Manual pll_drift pin still applies via
-      // pll_correction = pll_out + pll_drift further down.
-      *(hal_data->pll_out) = 0;
-      *(hal_data->dc_phased) = 1;
-    }
-  }
-
-  // the first read dc_time value seems to be invalid, so wait for two successive successful reads
-  if (dc_time_valid && master->dc_time_valid_last) {
-    // Raw offset between app_time and dc_time (this is what varies at each startup)
-    int32_t raw_offset = master->app_time_last - dc_time;
-
-    // Apply drift compensation based on drift-mode:
-    //   0 = simple: (app_period - app_phase) % app_period
-    //   1 = manual: use pll-drift pin value
-    //   other = same as 1 (manual)
-    int32_t drift = 0;
-    int32_t mode = *(hal_data->drift_mode);
-    if (master->sync_to_ref_clock) {
-      if (mode == 0) {
-        // Mode 0: simple - (app_period - app_phase) % app_period
-        int32_t calc_val = (app_period - current_app_phase) % app_period;
-        if (calc_val < 0) calc_val += app_period;
-        if (hal_data->auto_drift_delay > 0) {
-          hal_data->auto_drift_delay--;
-        } else {
-          drift = calc_val;
-        }
-      }
-    }
-    // Mode 1 or other: use manual pll-drift value
-
-    // Fold pll_err into (-period/2, period/2]. drift jumps a full period
-    // when app_phase crosses zero; raw_offset is physical and cannot
-    // follow. Two steps handle the startup cycle where the sum can exceed
-    // 1.5 periods in one pass (#501).
-    int32_t pll_err = raw_offset + drift;
-    if (pll_err > app_period / 2) {
-      pll_err -= app_period;
-    } else if (pll_err < -(app_period / 2)) {
-      pll_err += app_period;
-    }
-    if (pll_err > app_period / 2) {
-      pll_err -= app_period;
-    } else if (pll_err < -(app_period / 2)) {
-      pll_err += app_period;
-    }
-    *(hal_data->pll_err) = pll_err;
-
-    // PLL is considered phased if error is within 10% of period
-    int32_t lock_threshold = master->app_time_period / 10;
-    if (abs(*(hal_data->pll_err)) < lock_threshold) {
-      *(hal_data->dc_phased) = 1;
-    }
-
-    // Only run automatic PLL adjustment when sync_to_ref_clock is enabled
-    // When sync_to_ref_clock = false, master is the clock source, DC syncs to us
-    // When sync_to_ref_clock = true, DC is the clock source, we sync to DC
-    if (master->sync_to_ref_clock) {
-      // Watchdog on the physical offset, not the folded error: folded,
-      // |pll_err| <= period/2 could never reach the default threshold, and
-      // a whole-period displacement would go undetected. Remove only whole
-      // periods; the controller drives the remainder to zero.
-      if (abs(raw_offset) > hal_data->pll_max_err) {
-        int32_t resync_corr = raw_offset;
-        if (raw_offset >= app_period || raw_offset <= -app_period) {
-          // the division runs only on the cycle a resync fires
-          resync_corr = (raw_offset / app_period) * app_period;
-        }
-        // force resync of master time
-        master->dc_ref -= resync_corr;
-        // skip next control cycle to allow resync
-        dc_time_valid = 0;
-        // increment reset counter to document this event
-        (*(hal_data->pll_reset_cnt))++;
-        // Reset auto-drift delay on resync
-        if (*(hal_data->drift_mode) == 0) {
-          hal_data->auto_drift_delay = 100;
-        }
-      } else {
-        *(hal_data->pll_out) = (pll_err < 0) ? -(hal_data->pll_step) : (hal_data->pll_step);
-      }
-    }
-    // Note: When sync_to_ref_clock = false, pll_out is set in the phase calibration code above
+  pll = &master->pll;
+  pll->step = hal_data->pll_step;
+  pll->max_err = hal_data->pll_max_err;
+  pll->controller = hal_data->pll_controller;
+  pll->kp = hal_data->pll_kp;
+  pll->ki = hal_data->pll_ki;
+  pll->max_out = hal_data->pll_max_out;
+  pll->drift_mode = *(hal_data->drift_mode);
+  pll->drift = *(hal_data->pll_drift);
+  pll->retarget = hal_data->phase_retarget;
+  pll->recalibrate = *(hal_data->phase_recalibrate);
+  calibrated = pll->phase_calibrated;
+  target = pll->phase_target;
+
+  pll_correction = lcec_pll_update(pll, app_time, dc_time, dc_time_valid, now);
+
+  if (!master->sync_to_ref_clock && !calibrated && pll->phase_calibrated) {
+    rtapi_print_msg(
+        RTAPI_MSG_INFO, LCEC_MSG_PFX "Phase calibration complete: jitter=%d target=%d\n", pll->phase_jitter, pll->phase_target);
+  } else if (!master->sync_to_ref_clock && pll->phase_target != target) {
+    rtapi_print_msg(RTAPI_MSG_INFO, LCEC_MSG_PFX "Phase target moved: jitter=%d target=%d\n", pll->phase_jitter, pll->phase_target);
   }
-
-  // Apply PLL correction with debug offset
-  // pll_out is set by PLL controller (both sync_to_ref_clock modes now use PLL)
-  // pll_drift is user-provided offset for debugging
-  // Once phased, stop adjusting to maintain stability
-  int32_t pll_correction;
-  if (master->sync_to_ref_clock) {
-    // sync_to_ref_clock = true: always use PLL output for continuous sync
-    pll_correction = *(hal_data->pll_out) + *(hal_data->pll_drift);
-  } else {
-    // sync_to_ref_clock = false: stop adjusting once locked
-    if (*(hal_data->dc_phased)) {
-      pll_correction = *(hal_data->pll_drift);
-    } else {
-      pll_correction = *(hal_data->pll_out) + *(hal_data->pll_drift);
-    }
+  if (pll->resync != 0) {
+    // force resync of master time
+    master->dc_ref -= pll->resync;
+    lcec_trace_event(master->trace, LCEC_TRACE_PLL_RESET, -1, pll->raw_offset, pll->resync);
   }
 
+  *(hal_data->app_phase) = pll->app_phase;
+  *(hal_data->phase_jitter_out) = pll->phase_jitter;
+  *(hal_data->phase_jitter_p50) = pll->jitter_p50;
+  *(hal_data->phase_jitter_p99) = pll->jitter_p99;
+  *(hal_data->phase_jitter_p999) = pll->jitter_p999;
+  *(hal_data->phase_recalibrate) = pll->recalibrate;
+  *(hal_data->pll_err) = pll->err;
+  *(hal_data->pll_out) = pll->out;
+  *(hal_data->dc_phased) = pll->phased;
+  *(hal_data->pll_reset_cnt) = pll->reset_cnt;
   *(hal_data->pll_final) = pll_correction;
+  *(hal_data->pll_integrator) = pll->integrator;
+  *(hal_data->pll_lock_time) = pll->lock_time;
   rtapi_task_pll_set_correction(pll_correction);
 
-  master->app_time_last = (uint32_t)app_time;
-  master->dc_time_valid_last = dc_time_valid;
+  // the frame has left by now; measuring here errs on the late side
+  if (*(hal_data->sync0_tune)) {
+    lcec_sync0_tune(master, pll->app_phase + (int32_t)(rtapi_get_time() - now), queued_bytes);
+  }
 #endif
 }
 
@@ -23,6 +23,8 @@
 
 #include "lcec.h"
 
+static size_t hal_malloc_total = 0;
+
 void *lcec_hal_malloc(size_t size, const char *file, const char *func, int line) {
   void *result = hal_malloc(size);
   if (result == NULL) {
@@ -31,9 +33,15 @@ void *lcec_hal_malloc(size_t size, const char *file, const char *func, int line)
     exit(1);
   }
   memset(result, 0, size);
+  hal_malloc_total += size;
   return result;
 }
 
+/// @brief Bytes of HAL shared memory allocated through `lcec_hal_malloc()` so far.
+///
+/// Doesn't include the HAL's own pin and param bookkeeping.
+size_t lcec_hal_malloc_total(void) { return hal_malloc_total; }
+
 void *lcec_malloc(size_t size, const char *file, const char *func, int line) {
   void *result = malloc(size);
   if (result == NULL) {
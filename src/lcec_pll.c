@@ -0,0 +1,407 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Servo thread PLL controller, see `lcec_pll.h`.
+
+#include "lcec.h"
+
+#define PHASE_MEASURE_CYCLES 1000   // samples before the first R2M target is derived
+#define PHASE_STATS_CYCLES   1000   // samples between percentile updates
+#define PHASE_HIST_WINDOW    65536  // halve the histogram once it holds this many samples
+
+/// @brief PI phase controller, used instead of BANG-BANG with `pll-controller` = 1.
+///
+/// The output has the sign of `err`, like the BANG-BANG step.  Both the
+/// output and the integrator are limited to `pll-max-out`; while the
+/// output is limited the integrator only moves back towards zero
+/// (anti-windup), so a large startup error doesn't overshoot.
+///
+/// @return Correction in ns.
+static int32_t lcec_pll_pi(lcec_pll_t *pll, int32_t err) {
+  double max_out = pll->max_out;
+  double integ = pll->integrator;
+  double next = integ + pll->ki * err;
+  double out;
+
+  if (next > max_out) {
+    next = max_out;
+  } else if (next < -max_out) {
+    next = -max_out;
+  }
+
+  out = pll->kp * err + next;
+  if (out > max_out) {
+    out = max_out;
+    if (next > integ) {
+      next = integ;
+    }
+  } else if (out < -max_out) {
+    out = -max_out;
+    if (next < integ) {
+      next = integ;
+    }
+  }
+
+  pll->integrator = next;
+  return (int32_t)((out < 0) ? out - 0.5 : out + 0.5);
+}
+
+/// @brief Add this cycle's app_phase change to the jitter histogram.
+///
+/// The change is measured against `phase_last`, which already includes
+/// the period correction, so the controller's own steps don't count as
+/// jitter.
+static void lcec_pll_sample(lcec_pll_t *pll) {
+  int32_t app_period = pll->period;
+  int32_t diff = pll->app_phase - pll->phase_last;
+  uint32_t bucket;
+
+  // Unwrap: if phase jumped by more than half period, it crossed the boundary
+  if (diff > app_period / 2) {
+    diff -= app_period;
+  } else if (diff < -app_period / 2) {
+    diff += app_period;
+  }
+
+  bucket = abs(diff) / pll->hist_bucket_ns;
+  if (bucket >= LCEC_PLL_HIST_BUCKETS) {
+    bucket = LCEC_PLL_HIST_BUCKETS - 1;
+  }
+  pll->hist[bucket]++;
+  pll->hist_total++;
+  pll->hist_new++;
+}
+
+/// @brief Update the jitter percentiles from the histogram, then age it.
+///
+/// Each percentile is the upper edge of the bucket it falls in.  Halving
+/// all buckets once the histogram is full makes old samples fade out, so
+/// the percentiles follow changes in load.
+static void lcec_pll_percentiles(lcec_pll_t *pll) {
+  uint32_t r50 = (pll->hist_total + 1) / 2;
+  uint32_t r99 = pll->hist_total - pll->hist_total / 100;
+  uint32_t r999 = pll->hist_total - pll->hist_total / 1000;
+  uint32_t cum = 0;
+  int i;
+
+  pll->jitter_p50 = pll->jitter_p99 = pll->jitter_p999 = 0;
+  for (i = 0; i < LCEC_PLL_HIST_BUCKETS; i++) {
+    int32_t edge = (i + 1) * pll->hist_bucket_ns;
+
+    cum += pll->hist[i];
+    if (pll->jitter_p50 == 0 && cum >= r50) {
+      pll->jitter_p50 = edge;
+    }
+    if (pll->jitter_p99 == 0 && cum >= r99) {
+      pll->jitter_p99 = edge;
+    }
+    if (cum >= r999) {
+      pll->jitter_p999 = edge;
+      break;
+    }
+  }
+  pll->hist_new = 0;
+
+  if (pll->hist_total >= PHASE_HIST_WINDOW) {
+    pll->hist_total = 0;
+    for (i = 0; i < LCEC_PLL_HIST_BUCKETS; i++) {
+      pll->hist[i] /= 2;
+      pll->hist_total += pll->hist[i];
+    }
+  }
+}
+
+/// @brief Derive the R2M target app_phase from the p99 jitter.
+///
+/// Unless `force` is set, changes within a quarter of the current target
+/// (or within one bucket) are ignored, so the target doesn't follow the
+/// noise in the estimate.
+static void lcec_pll_retarget(lcec_pll_t *pll, int force) {
+  // Target position: p99 jitter * 1.5, limited to app_period/8
+  int32_t target = pll->jitter_p99 + pll->jitter_p99 / 2;
+  int32_t change;
+
+  if (target > pll->period / 8) {
+    target = pll->period / 8;
+  }
+  change = abs(target - pll->phase_target);
+  if (!force && (change <= pll->phase_target / 4 || change <= pll->hist_bucket_ns)) {
+    return;
+  }
+  pll->phase_jitter = pll->jitter_p99;
+  pll->phase_target = target;
+}
+
+/// @brief Track the app_phase jitter and keep the R2M target up to date.
+static void lcec_pll_jitter(lcec_pll_t *pll) {
+  if (pll->phase_last_valid) {
+    lcec_pll_sample(pll);
+  }
+
+  if (!pll->phase_calibrated) {
+    if (pll->hist_total >= PHASE_MEASURE_CYCLES) {
+      lcec_pll_percentiles(pll);
+      lcec_pll_retarget(pll, 1);
+      pll->phase_calibrated = 1;
+      pll->recalibrate = 0;
+    }
+  } else if (pll->hist_new >= PHASE_STATS_CYCLES || pll->recalibrate) {
+    lcec_pll_percentiles(pll);
+    if (pll->recalibrate || pll->retarget) {
+      lcec_pll_retarget(pll, pll->recalibrate);
+    }
+    pll->recalibrate = 0;
+  }
+}
+
+/// @brief Reset the controller at master activation.
+///
+/// @param pll The controller, with its config fields set.
+/// @param dc_ref_time The app time passed to `ecrt_master_application_time()` before activating.
+/// @param now Current time (ns), for `lock_time`.
+void lcec_pll_start(lcec_pll_t *pll, uint64_t dc_ref_time, long long now) {
+  pll->dc_ref_time = dc_ref_time;
+  pll->dc_time_valid_last = 0;
+  pll->lock_start = now;
+  pll->auto_drift_delay = 100;
+  pll->phase_last_valid = 0;
+  pll->hist_bucket_ns = pll->period / (4 * LCEC_PLL_HIST_BUCKETS);
+  if (pll->hist_bucket_ns == 0) {
+    pll->hist_bucket_ns = 1;
+  }
+}
+
+/// @brief Run one cycle of the controller.
+///
+/// Called after the frames were sent.  Besides the returned correction
+/// this updates the result fields.  When `resync` is non-zero, the
+/// caller must subtract it from the time base that `app_time` is
+/// derived from.
+///
+/// @param pll The controller.
+/// @param app_time The app time passed to `ecrt_master_application_time()` this cycle.
+/// @param dc_time Low 32 bits of the DC reference clock time.
+/// @param dc_time_valid `dc_time` was read successfully.
+/// @param now Current time (ns), for `lock_time`.
+/// @return The period correction (ns).
+int32_t lcec_pll_update(lcec_pll_t *pll, uint64_t app_time, uint32_t dc_time, int dc_time_valid, long long now) {
+  int32_t app_period = pll->period;
+
+  pll->err = 0;
+  pll->out = 0;
+  pll->phased = 0;
+  pll->resync = 0;
+
+  // Calculate app_phase: our execution position in local cycle
+  // This is relative to dc_ref_time (the time we set at activation)
+  // app_phase = (app_time - dc_ref_time) % period
+  // This represents where we are within the current cycle since activation
+  pll->app_phase = (int32_t)((app_time - pll->dc_ref_time) % (uint32_t)app_period);
+  lcec_pll_jitter(pll);
+
+  // When sync_to_ref_clock = false: adjust app_phase to a stable position using PLL
+  // This is needed because app_phase is random at startup
+  if (!pll->sync_to_ref_clock) {
+    if (!pll->phase_calibrated) {
+      // still measuring the jitter
+    } else if (!pll->initf_activated) {
+      // Use PLL to move app_phase towards target.
+      // Only runs when activation was dirty (legacy load-time path or inline
+      // fallback after forgot-to-initf). With initf_activated=1 the master was
+      // activated cleanly in RT context, app_phase is born stable, and the
+      // BANG-BANG would only add noise -- skip it entirely.
+      // Positive error (app_phase > target) means we need to speed up to reduce app_phase
+      // Negative error (app_phase < target) means we need to slow down to increase app_phase
+      int32_t phase_error = pll->app_phase - pll->phase_target;
+
+      // app_phase wraps at the period: just below zero is a small negative
+      // error, not a large positive one
+      if (phase_error > app_period / 2) {
+        phase_error -= app_period;
+      }
+
+      if (abs(phase_error) < abs(pll->step) * 3) {
+        pll->phased = 1;
+      }
+
+      // BANG-BANG control: small steps to move towards target
+      // Positive pll_out = slow down = app_phase increases
+      // Negative pll_out = speed up = app_phase decreases
+      if (pll->controller == LCEC_PLL_PI) {
+        // PI keeps running once locked; positive output speeds up here
+        pll->out = -lcec_pll_pi(pll, phase_error);
+      } else if (pll->phased) {
+        pll->out = 0;
+      } else if (phase_error > 0) {
+        pll->out = -pll->step;  // Speed up to reduce app_phase
+      } else if (phase_error < 0) {
+        pll->out = pll->step;  // Slow down to increase app_phase
+      }
+    } else {
+      // initf_activated: clean RT-context activation, app_phase is born stable.
+      // Force PLL outputs to safe values so rtapi_task_pll_get_reference does
+      // not see stale BANG-BANG state. Manual pll_drift still applies via
+      // final = out + drift further down.
+      pll->out = 0;
+      pll->phased = 1;
+    }
+  }
+
+  // the first read dc_time value seems to be invalid, so wait for two successive successful reads
+  if (dc_time_valid && pll->dc_time_valid_last) {
+    // Raw offset between app_time and dc_time (this is what varies at each startup)
+    int32_t raw_offset = pll->app_time_last - dc_time;
+
+    // Apply drift compensation based on drift-mode:
+    //   0 = simple: (app_period - app_phase) % app_period
+    //   1 = manual: use pll-drift pin value
+    //   other = same as 1 (manual)
+    int32_t drift = 0;
+    if (pll->sync_to_ref_clock && pll->drift_mode == 0) {
+      int32_t calc_val = (app_period - pll->app_phase) % app_period;
+      if (calc_val < 0) calc_val += app_period;
+      if (pll->auto_drift_delay > 0) {
+        pll->auto_drift_delay--;
+      } else {
+        drift = calc_val;
+      }
+    }
+
+    // Fold pll_err into (-period/2, period/2]. drift jumps a full period
+    // when app_phase crosses zero; raw_offset is physical and cannot
+    // follow. Two steps handle the startup cycle where the sum can exceed
+    // 1.5 periods in one pass (#501).
+    int32_t pll_err = raw_offset + drift;
+    if (pll_err > app_period / 2) {
+      pll_err -= app_period;
+    } else if (pll_err < -(app_period / 2)) {
+      pll_err += app_period;
+    }
+    if (pll_err > app_period / 2) {
+      pll_err -= app_period;
+    } else if (pll_err < -(app_period / 2)) {
+      pll_err += app_period;
+    }
+    pll->err = pll_err;
+
+    // PLL is considered phased if error is within 10% of period
+    if (abs(pll_err) < app_period / 10) {
+      pll->phased = 1;
+    }
+
+    // Only run automatic PLL adjustment when sync_to_ref_clock is enabled
+    // When sync_to_ref_clock = false, master is the clock source, DC syncs to us
+    // When sync_to_ref_clock = true, DC is the clock source, we sync to DC
+    if (pll->sync_to_ref_clock) {
+      // Watchdog on the physical offset, not the folded error: folded,
+      // |pll_err| <= period/2 could never reach the default threshold, and
+      // a whole-period displacement would go undetected. Remove only whole
+      // periods; the controller drives the remainder to zero.
+      if ((uint32_t)abs(raw_offset) > pll->max_err) {
+        int32_t resync_corr = raw_offset;
+        if (raw_offset >= app_period || raw_offset <= -app_period) {
+          // the division runs only on the cycle a resync fires
+          resync_corr = (raw_offset / app_period) * app_period;
+        }
+        // force resync of master time
+        pll->raw_offset = raw_offset;
+        pll->resync = resync_corr;
+        pll->reset_cnt++;
+        // skip next control cycle to allow resync
+        dc_time_valid = 0;
+        // Reset auto-drift delay on resync
+        if (pll->drift_mode == 0) {
+          pll->auto_drift_delay = 100;
+        }
+        pll->lock_start = now;
+        // app_phase jumps with dc_ref; don't count that as jitter
+      } else if (pll->controller == LCEC_PLL_PI) {
+        pll->out = lcec_pll_pi(pll, pll_err);
+      } else {
+        pll->out = (pll_err < 0) ? -pll->step : pll->step;
+      }
+    }
+    // Note: When sync_to_ref_clock = false, out is set in the phase calibration code above
+  }
+
+  // Apply PLL correction with debug offset
+  // drift is user-provided offset for debugging
+  if (pll->sync_to_ref_clock) {
+    // sync_to_ref_clock = true: always use PLL output for continuous sync
+    pll->final = pll->out + pll->drift;
+  } else if (pll->phased && pll->controller != LCEC_PLL_PI) {
+    // sync_to_ref_clock = false: BANG-BANG stops adjusting once locked
+    pll->final = pll->drift;
+  } else {
+    pll->final = pll->out + pll->drift;
+  }
+
+  if (pll->controller != LCEC_PLL_PI) {
+    pll->integrator = 0;
+  }
+  if (pll->lock_start != 0 && pll->phased) {
+    pll->lock_time = (now - pll->lock_start) * 1e-9;
+    pll->lock_start = 0;
+  }
+
+  if (pll->resync == 0) {
+    pll->phase_last = pll->app_phase + (pll->sync_to_ref_clock ? 0 : pll->final);
+    pll->phase_last_valid = 1;
+  }
+  pll->app_time_last = (uint32_t)app_time;
+  pll->dc_time_valid_last = dc_time_valid;
+  return pll->final;
+}
+
+/// @brief Time from the frame leaving the master until a slave has all of it (ns).
+///
+/// Outputs are only valid once the whole frame has passed the slave,
+/// so this is the frame's wire time plus the forwarding delay of every
+/// slave up to and including this one.
+///
+/// @param bytes Process data in the frame.
+/// @param position The slave's position on the bus.
+int32_t lcec_sync0_frame_time(uint32_t bytes, int position) {
+  return (bytes + LCEC_SYNC0_FRAME_OVERHEAD) * LCEC_SYNC0_NS_PER_BYTE + (position + 1) * LCEC_SYNC0_SLAVE_DELAY;
+}
+
+/// @brief Smallest `sync0Shift` at which outputs reach a slave before SYNC0.
+///
+/// @param send_phase_max Latest app_phase at which the frame was sent (ns).
+/// @param bytes Process data in the frame.
+/// @param position The slave's position on the bus.
+/// @param margin Extra time to allow (ns).
+int32_t lcec_sync0_safe_shift(int32_t send_phase_max, uint32_t bytes, int position, uint32_t margin) {
+  return send_phase_max + lcec_sync0_frame_time(bytes, position) + (int32_t)margin;
+}
+
+/// @brief Input-to-actuation latency of a slave (ns).
+///
+/// From the frame picking up the slave's inputs in one cycle to SYNC0
+/// applying the outputs computed from them in the next, assuming the
+/// outputs make it before that SYNC0.
+///
+/// @param period Cycle time (ns).
+/// @param shift The slave's `sync0Shift`.
+/// @param send_phase Typical app_phase at which the frame is sent (ns).
+/// @param bytes Process data in the frame.
+/// @param position The slave's position on the bus.
+int32_t lcec_sync0_latency(int32_t period, int32_t shift, int32_t send_phase, uint32_t bytes, int position) {
+  return period + shift - send_phase - lcec_sync0_frame_time(bytes, position);
+}
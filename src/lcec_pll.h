@@ -0,0 +1,95 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Servo thread PLL controller.
+///
+/// The controller is kept free of HAL and EtherCAT calls, so the same
+/// code runs in `lcec_send_master()` and in the userspace simulator in
+/// `tests/test_pll.c`.  The caller copies the HAL params into the
+/// struct, calls `lcec_pll_update()` once per cycle, and copies the
+/// results back to the pins.
+
+#ifndef _LCEC_PLL_H_
+#define _LCEC_PLL_H_
+
+#include <rtapi_stdint.h>
+
+#define LCEC_PLL_BANG_BANG 0  ///< `pll-controller`: fixed +/-`pll-step` corrections.
+#define LCEC_PLL_PI         1  ///< `pll-controller`: proportional-integral controller.
+
+#define LCEC_PLL_HIST_BUCKETS 256  ///< Phase jitter histogram buckets, covering a quarter period.
+
+#define LCEC_SYNC0_FRAME_OVERHEAD 100   ///< Bytes per cyclic frame besides process data: headers, DC datagrams, gap.
+#define LCEC_SYNC0_NS_PER_BYTE    80    ///< Wire time of one byte at 100 Mbit/s.
+#define LCEC_SYNC0_SLAVE_DELAY    1000  ///< Forwarding delay per slave and cable (ns), on the safe side.
+
+typedef struct {
+  // Config, set before the first update
+  int32_t period;          ///< Servo thread period (`appTimePeriod`, ns).
+  int sync_to_ref_clock;   ///< M2R: the thread follows the DC reference clock.
+  int initf_activated;     ///< R2M: activated from `lcec.activate`, so app_phase is born stable.
+  // Params, copied from HAL before every update
+  int32_t step;            ///< `pll-step` (ns).
+  uint32_t max_err;        ///< `pll-max-err` (ns).
+  uint32_t controller;     ///< `pll-controller`: `LCEC_PLL_BANG_BANG` or `LCEC_PLL_PI`.
+  double kp;               ///< `pll-kp`.
+  double ki;               ///< `pll-ki`.
+  uint32_t max_out;        ///< `pll-max-out` (ns).
+  int32_t drift_mode;      ///< `drift-mode`: 0 = simple, other = manual.
+  int32_t drift;           ///< `pll-drift` (ns).
+  int retarget;            ///< `phase-retarget`: re-derive the R2M target as the jitter changes.
+  int recalibrate;         ///< `phase-recalibrate`: re-derive the R2M target now; cleared once done.
+  // Results of the last update
+  int32_t app_phase;       ///< `app-phase`.
+  int32_t err;             ///< `pll-err`.
+  int32_t out;             ///< `pll-out`.
+  int32_t final;           ///< `pll-final`, the correction for `rtapi_task_pll_set_correction()`.
+  int phased;              ///< `dc-phased`.
+  int32_t phase_jitter;    ///< `phase-jitter`, the p99 jitter the R2M target was derived from.
+  int32_t jitter_p50;      ///< `phase-jitter-p50`.
+  int32_t jitter_p99;      ///< `phase-jitter-p99`.
+  int32_t jitter_p999;     ///< `phase-jitter-p999`.
+  double integrator;       ///< `pll-integrator`.
+  double lock_time;        ///< `pll-lock-time` (s).
+  int32_t raw_offset;      ///< Offset that caused the last resync (ns).
+  int32_t resync;          ///< Correction applied by a resync this cycle, else 0; subtract it from `dc_ref`.
+  uint32_t reset_cnt;      ///< `pll-reset-count`.
+  // State
+  uint64_t dc_ref_time;       ///< App time sent before activation.
+  uint32_t app_time_last;     ///< Low 32 bits of the previous cycle's app time.
+  int dc_time_valid_last;     ///< Previous cycle's dc_time was valid.
+  long long lock_start;       ///< Time of activation or the last resync; 0 once phased.
+  int32_t auto_drift_delay;   ///< Cycles before drift-mode 0 compensation starts.
+  int32_t phase_last;         ///< Expected app_phase: the last one, plus the correction applied since in R2M.
+  int phase_last_valid;       ///< `phase_last` is set.
+  int32_t phase_target;       ///< R2M: target app_phase position.
+  int phase_calibrated;       ///< R2M: 0 = measuring, 1 = calibrated.
+  uint32_t hist[LCEC_PLL_HIST_BUCKETS];  ///< Histogram of the cycle-to-cycle app_phase change.
+  uint32_t hist_total;        ///< Samples in `hist`.
+  uint32_t hist_new;          ///< Samples since the percentiles were last updated.
+  int32_t hist_bucket_ns;     ///< Width of one bucket (ns).
+} lcec_pll_t;
+
+int32_t lcec_sync0_frame_time(uint32_t bytes, int position);
+int32_t lcec_sync0_safe_shift(int32_t send_phase_max, uint32_t bytes, int position, uint32_t margin);
+int32_t lcec_sync0_latency(int32_t period, int32_t shift, int32_t send_phase, uint32_t bytes, int position);
+void lcec_pll_start(lcec_pll_t *pll, uint64_t dc_ref_time, long long now);
+int32_t lcec_pll_update(lcec_pll_t *pll, uint64_t app_time, uint32_t dc_time, int dc_time_valid, long long now);
+
+#endif
@@ -0,0 +1,241 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Process-image flight recorder.
+///
+/// Every cycle `lcec_receive_master()` copies each received Sync Unit's
+/// process data into the next frame of a ring in shared memory, with
+/// one `memcpy` per domain into memory allocated at startup.  When a
+/// trigger fires the recorder keeps going for `post-cycles` more
+/// cycles and then freezes, so the ring holds the cycles leading up to
+/// the problem until `lcec_recorder_dump` has saved them.
+
+#include "lcec.h"
+
+#define LCEC_RECORDER_MAX_BYTES (64 * 1024 * 1024)
+
+extern int lcec_comp_id;
+
+static const char *const lcec_recorder_reason_names[] = {"none", "wkc", "pin", "oper"};
+
+static void lcec_recorder_freeze(lcec_recorder_t *rec) {
+  rec->shm->frozen = rec->pending;
+  *(rec->frozen) = 1;
+  *(rec->reason) = rec->pending;
+  rec->pending = LCEC_RECORDER_TRIGGER_NONE;
+}
+
+/// @brief Create a master's recorder and its shared memory.
+///
+/// Must be called after the Sync Units' domain sizes are known.
+///
+/// @param master The master.
+/// @param pfx HAL name prefix, e.g. `lcec.0`.
+/// @param cycles Number of cycles to keep.
+/// @return The recorder, or NULL on failure.
+lcec_recorder_t *lcec_recorder_init(lcec_master_t *master, const char *pfx, int cycles) {
+  lcec_recorder_t *rec;
+  lcec_recorder_shm_t *shm;
+  lcec_sync_unit_t *sync_unit;
+  uint32_t data_len, unit_count, frame_size, frames_offset;
+  uint64_t total_size;
+  void *ptr;
+
+  rec = (lcec_recorder_t *)lcec_hal_malloc(sizeof(lcec_recorder_t), __FILE__, __func__, __LINE__);
+
+  if (lcec_pin_newf(HAL_BIT, HAL_OUT, (void **)&rec->frozen, "%s.recorder.frozen", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&rec->reason, "%s.recorder.reason", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_BIT, HAL_IN, (void **)&rec->trigger, "%s.recorder.trigger", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_BIT, HAL_IO, (void **)&rec->rearm, "%s.recorder.rearm", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_param_newf(HAL_BIT, HAL_RW, (void *)&rec->trigger_wkc, "%s.recorder.trigger-wkc", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_param_newf(HAL_BIT, HAL_RW, (void *)&rec->trigger_oper, "%s.recorder.trigger-oper", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_param_newf(HAL_U32, HAL_RW, (void *)&rec->post_cycles, "%s.recorder.post-cycles", pfx) != 0) {
+    return NULL;
+  }
+  rec->trigger_wkc = 1;
+  rec->trigger_oper = 1;
+
+  // lay out one frame: header, then every Sync Unit's process data
+  data_len = 0;
+  unit_count = 0;
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (unit_count == LCEC_RECORDER_MAX_UNITS) {
+      rtapi_print_msg(RTAPI_MSG_WARN, LCEC_MSG_PFX "master %s recorder: only the first %d syncUnits are recorded\n", master->name,
+          LCEC_RECORDER_MAX_UNITS);
+      break;
+    }
+    unit_count++;
+    data_len += sync_unit->process_data_len;
+  }
+  frame_size = (sizeof(lcec_recorder_frame_t) + data_len + 7) & ~7u;
+  frames_offset = (sizeof(lcec_recorder_shm_t) + 7) & ~7u;
+  total_size = frames_offset + (uint64_t)frame_size * cycles;
+  if (total_size > LCEC_RECORDER_MAX_BYTES) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s recorder: %d cycles of %u bytes is too large\n", master->name, cycles,
+        frame_size);
+    return NULL;
+  }
+
+  rec->shmem_id = rtapi_shmem_new(LCEC_RECORDER_SHMEM_KEY + master->index, lcec_comp_id, total_size);
+  if (rec->shmem_id < 0) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s recorder: couldn't allocate user/RT shared memory\n", master->name);
+    return NULL;
+  }
+  if (lcec_rtapi_shmem_getptr(rec->shmem_id, &ptr) < 0) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "master %s recorder: couldn't map user/RT shared memory\n", master->name);
+    rtapi_shmem_delete(rec->shmem_id, lcec_comp_id);
+    return NULL;
+  }
+
+  shm = (lcec_recorder_shm_t *)ptr;
+  memset(shm, 0, total_size);
+  shm->total_size = total_size;
+  shm->cycles = cycles;
+  shm->frame_size = frame_size;
+  shm->frames_offset = frames_offset;
+  shm->unit_count = unit_count;
+  data_len = 0;
+  sync_unit = master->first_sync_unit;
+  for (uint32_t i = 0; i < unit_count; i++, sync_unit = sync_unit->next) {
+    rtapi_snprintf(shm->units[i].name, LCEC_RECORDER_NAME_LEN, "%s", sync_unit->name);
+    shm->units[i].offset = data_len;
+    shm->units[i].len = sync_unit->process_data_len;
+    data_len += sync_unit->process_data_len;
+  }
+  shm->magic = LCEC_RECORDER_MAGIC;
+
+  rec->shm = shm;
+  rec->frames = (uint8_t *)shm + frames_offset;
+  return rec;
+}
+
+/// @brief Release a recorder's shared memory.
+void lcec_recorder_free(lcec_recorder_t *rec) { rtapi_shmem_delete(rec->shmem_id, lcec_comp_id); }
+
+/// @brief Start recording a cycle.
+///
+/// Handles `rearm`.  The caller copies Sync Unit `i`'s process data to
+/// the returned pointer plus `shm->units[i].offset`, then calls
+/// `lcec_recorder_end()`.
+///
+/// @return Where the frame's process data goes, or NULL while frozen.
+uint8_t *lcec_recorder_begin(lcec_recorder_t *rec) {
+  lcec_recorder_shm_t *shm = rec->shm;
+
+  if (*(rec->rearm)) {
+    *(rec->rearm) = 0;
+    shm->head = 0;
+    shm->slot = 0;
+    shm->frozen = LCEC_RECORDER_TRIGGER_NONE;
+    rec->pending = LCEC_RECORDER_TRIGGER_NONE;
+    *(rec->frozen) = 0;
+    *(rec->reason) = LCEC_RECORDER_TRIGGER_NONE;
+  }
+
+  if (shm->frozen) {
+    return NULL;
+  }
+  return rec->frames + shm->slot * shm->frame_size + sizeof(lcec_recorder_frame_t);
+}
+
+/// @brief Finish the cycle started by `lcec_recorder_begin()`.
+///
+/// @param rec The recorder.
+/// @param fresh Bit per Sync Unit whose data was copied this cycle.
+/// @param wkc Combined working counter.
+/// @param wkc_state Combined `ec_wc_state_t`.
+void lcec_recorder_end(lcec_recorder_t *rec, uint32_t fresh, uint32_t wkc, int wkc_state) {
+  lcec_recorder_shm_t *shm = rec->shm;
+  lcec_recorder_frame_t *frame = (lcec_recorder_frame_t *)(rec->frames + shm->slot * shm->frame_size);
+
+  frame->time = rtapi_get_time();
+  frame->wkc = wkc;
+  frame->wkc_state = wkc_state;
+  frame->fresh = fresh;
+  shm->head++;
+  shm->slot = (shm->slot + 1 < shm->cycles) ? shm->slot + 1 : 0;
+
+  if (rec->pending && --rec->post_remaining == 0) {
+    lcec_recorder_freeze(rec);
+  }
+
+  if (*(rec->trigger) && !rec->trigger_last) {
+    lcec_recorder_trigger(rec, LCEC_RECORDER_TRIGGER_PIN);
+  }
+  rec->trigger_last = *(rec->trigger);
+}
+
+/// @brief Fire a trigger.
+///
+/// Marks the last recorded cycle as the trigger cycle; the recorder
+/// freezes after `post-cycles` more cycles.  Ignored while a trigger is
+/// already pending, the recorder is frozen, or nothing was recorded yet.
+void lcec_recorder_trigger(lcec_recorder_t *rec, int reason) {
+  lcec_recorder_shm_t *shm = rec->shm;
+
+  if (shm->frozen || rec->pending || shm->head == 0) {
+    return;
+  }
+  rec->pending = reason;
+  shm->trigger_frame = shm->head - 1;
+  // keep the trigger cycle itself in the window
+  rec->post_remaining = (rec->post_cycles < shm->cycles) ? rec->post_cycles : shm->cycles - 1;
+  if (rec->post_remaining == 0) {
+    lcec_recorder_freeze(rec);
+  }
+}
+
+/// @brief Find the recorded cycles still in the ring.
+///
+/// @param shm The recorder.
+/// @param[out] first Value of `head` when the oldest recorded cycle was recorded.
+/// @return Number of recorded cycles; they are `*first` up to `*first + n - 1`.
+int lcec_recorder_window(const lcec_recorder_shm_t *shm, uint32_t *first) {
+  uint32_t n = (shm->head < shm->cycles) ? shm->head : shm->cycles;
+
+  *first = shm->head - n;
+  return n;
+}
+
+/// @brief Get recorded cycle `n`, which must be within `lcec_recorder_window()`.
+const lcec_recorder_frame_t *lcec_recorder_frame(const lcec_recorder_shm_t *shm, uint32_t n) {
+  uint32_t slot = (shm->slot + shm->cycles - (shm->head - n)) % shm->cycles;
+
+  return (const lcec_recorder_frame_t *)((const uint8_t *)shm + shm->frames_offset + (size_t)slot * shm->frame_size);
+}
+
+/// @brief Name of a trigger, as printed by `lcec_recorder_dump`.
+const char *lcec_recorder_reason_name(int reason) {
+  if (reason < 0 || reason > LCEC_RECORDER_TRIGGER_OPER) {
+    return "unknown";
+  }
+  return lcec_recorder_reason_names[reason];
+}
@@ -0,0 +1,77 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Layout of the per-master process-image flight recorder.
+///
+/// Shared between `lcec.so`, which records a frame per cycle, and the
+/// `lcec_recorder_dump` tool, which reads the frozen window from
+/// user/RT shared memory.  The memory holds an `lcec_recorder_shm_t`
+/// followed, at `frames_offset`, by `cycles` frames of `frame_size`
+/// bytes.  Each frame is an `lcec_recorder_frame_t` followed by the
+/// process data of every Sync Unit at its `units[].offset`.
+
+#ifndef _LCEC_RECORDER_H_
+#define _LCEC_RECORDER_H_
+
+#include <rtapi_stdint.h>
+
+#define LCEC_RECORDER_SHMEM_KEY 0xACB57400  ///< Plus the master index.
+#define LCEC_RECORDER_MAGIC     0x4C434652  ///< "LCFR"
+#define LCEC_RECORDER_MAX_UNITS 32          ///< Sync Units recorded per master.
+#define LCEC_RECORDER_NAME_LEN  32
+
+#define LCEC_RECORDER_TRIGGER_NONE 0
+#define LCEC_RECORDER_TRIGGER_WKC  1  ///< `wkc-state` left complete.
+#define LCEC_RECORDER_TRIGGER_PIN  2  ///< Rising edge on the `recorder.trigger` pin.
+#define LCEC_RECORDER_TRIGGER_OPER 3  ///< A slave left OP.
+
+typedef struct {
+  char name[LCEC_RECORDER_NAME_LEN];  ///< Sync Unit name.
+  uint32_t offset;                    ///< Offset of its process data after the frame header.
+  uint32_t len;                       ///< Length of its process data.
+} lcec_recorder_unit_t;
+
+/// @brief Header of one recorded cycle.
+typedef struct {
+  int64_t time;        ///< `rtapi_get_time()` when the cycle was received, in ns.
+  uint32_t wkc;        ///< Sum of all Sync Units' working counters.
+  int32_t wkc_state;   ///< Combined `ec_wc_state_t`.
+  uint32_t fresh;      ///< Bit per Sync Unit: data was received this cycle; otherwise it is a stale copy.
+  uint32_t pad;
+} lcec_recorder_frame_t;
+
+typedef struct {
+  uint32_t magic;          ///< `LCEC_RECORDER_MAGIC` once initialized.
+  uint32_t total_size;     ///< Size of the whole shared memory block.
+  uint32_t cycles;         ///< Number of frames in the ring.
+  uint32_t frame_size;     ///< Bytes per frame, header included.
+  uint32_t frames_offset;  ///< Offset of the first frame from the start of this struct.
+  uint32_t unit_count;     ///< Entries in `units`.
+  uint32_t head;           ///< Number of frames recorded since (re)arming.
+  uint32_t slot;           ///< Slot the next frame goes to.
+  uint32_t frozen;         ///< `LCEC_RECORDER_TRIGGER_*` that froze the ring, 0 while recording.
+  uint32_t trigger_frame;  ///< Value of `head` - 1 when the trigger fired.
+  lcec_recorder_unit_t units[LCEC_RECORDER_MAX_UNITS];
+} lcec_recorder_shm_t;
+
+int lcec_recorder_window(const lcec_recorder_shm_t *shm, uint32_t *first);
+const lcec_recorder_frame_t *lcec_recorder_frame(const lcec_recorder_shm_t *shm, uint32_t n);
+const char *lcec_recorder_reason_name(int reason);
+
+#endif
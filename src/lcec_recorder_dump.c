@@ -0,0 +1,165 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Code for the `lcec_recorder_dump` tool, which saves a master's frozen flight recorder window.
+///
+/// Usage: `lcec_recorder_dump [-o file] [master-index]`.  Writes one
+/// line per received Sync Unit per recorded cycle:
+///
+///     <cycle> <time-ns> <wkc> <wkc-state> <syncUnit> <hex process data>
+///
+/// where `<cycle>` counts from the trigger cycle (0), negative before it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hal.h"
+#include "lcec_recorder.h"
+#include "lcec_rtapi.h"
+#include "rtapi.h"
+
+static const char *modname = "lcec_recorder_dump";
+
+static void usage(void) { fprintf(stderr, "usage: %s [-o file] [master-index]\n", modname); }
+
+/// @brief Map the recorder's shared memory, first just the header to learn its size.
+static lcec_recorder_shm_t *attach(int comp_id, int master_index, int *shmem_id) {
+  void *ptr;
+  uint32_t total_size;
+
+  *shmem_id = rtapi_shmem_new(LCEC_RECORDER_SHMEM_KEY + master_index, comp_id, sizeof(lcec_recorder_shm_t));
+  if (*shmem_id < 0 || lcec_rtapi_shmem_getptr(*shmem_id, &ptr) < 0) {
+    return NULL;
+  }
+  if (((lcec_recorder_shm_t *)ptr)->magic != LCEC_RECORDER_MAGIC) {
+    return NULL;
+  }
+  total_size = ((lcec_recorder_shm_t *)ptr)->total_size;
+  rtapi_shmem_delete(*shmem_id, comp_id);
+
+  *shmem_id = rtapi_shmem_new(LCEC_RECORDER_SHMEM_KEY + master_index, comp_id, total_size);
+  if (*shmem_id < 0 || lcec_rtapi_shmem_getptr(*shmem_id, &ptr) < 0) {
+    return NULL;
+  }
+  return (lcec_recorder_shm_t *)ptr;
+}
+
+static void dump(FILE *out, const lcec_recorder_shm_t *shm, int master_index) {
+  uint32_t first, n, i, u, b;
+
+  n = lcec_recorder_window(shm, &first);
+  fprintf(out, "# lcec flight recorder, master %d\n", master_index);
+  fprintf(out, "# trigger: %s\n", lcec_recorder_reason_name(shm->frozen));
+  fprintf(out, "# cycles: %u before trigger, %u after\n", shm->trigger_frame - first, first + n - 1 - shm->trigger_frame);
+  for (u = 0; u < shm->unit_count; u++) {
+    fprintf(out, "# syncUnit %s: %u bytes\n", shm->units[u].name, shm->units[u].len);
+  }
+  fprintf(out, "# cycle time-ns wkc wkc-state syncUnit data\n");
+
+  for (i = first; i < first + n; i++) {
+    const lcec_recorder_frame_t *frame = lcec_recorder_frame(shm, i);
+    const uint8_t *data = (const uint8_t *)(frame + 1);
+
+    for (u = 0; u < shm->unit_count; u++) {
+      if (!(frame->fresh & (1u << u))) {
+        continue;
+      }
+      fprintf(out, "%d %lld %u %d %s ", (int)(i - shm->trigger_frame), (long long)frame->time, frame->wkc, frame->wkc_state,
+          shm->units[u].name);
+      for (b = 0; b < shm->units[u].len; b++) {
+        fprintf(out, "%02x", data[shm->units[u].offset + b]);
+      }
+      fprintf(out, "\n");
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  int ret = 1;
+  int master_index = 0;
+  const char *filename = NULL;
+  int comp_id, shmem_id, opt;
+  lcec_recorder_shm_t *shm, *copy;
+  FILE *out;
+
+  while ((opt = getopt(argc, argv, "o:h")) != -1) {
+    switch (opt) {
+      case 'o':
+        filename = optarg;
+        break;
+      default:
+        usage();
+        return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (optind < argc) {
+    master_index = atoi(argv[optind]);
+  }
+
+  comp_id = hal_init(modname);
+  if (comp_id < 1) {
+    fprintf(stderr, "%s: ERROR: hal_init failed\n", modname);
+    goto fail0;
+  }
+
+  shm = attach(comp_id, master_index, &shmem_id);
+  if (shm == NULL) {
+    fprintf(stderr, "%s: ERROR: no flight recorder for master %d; is recorderCycles set?\n", modname, master_index);
+    goto fail1;
+  }
+  if (!shm->frozen) {
+    fprintf(stderr, "%s: ERROR: recorder of master %d has not been triggered yet\n", modname, master_index);
+    goto fail1;
+  }
+
+  // copy first, so a rearm while writing the file can't mix cycles
+  copy = malloc(shm->total_size);
+  if (copy == NULL) {
+    fprintf(stderr, "%s: ERROR: out of memory\n", modname);
+    goto fail1;
+  }
+  memcpy(copy, shm, shm->total_size);
+  if (!shm->frozen || shm->head != copy->head) {
+    fprintf(stderr, "%s: ERROR: recorder of master %d was rearmed while reading\n", modname, master_index);
+    goto fail2;
+  }
+
+  out = (filename != NULL) ? fopen(filename, "w") : stdout;
+  if (out == NULL) {
+    fprintf(stderr, "%s: ERROR: couldn't open %s\n", modname, filename);
+    goto fail2;
+  }
+  dump(out, copy, master_index);
+  if (out != stdout) {
+    fclose(out);
+  }
+  ret = 0;
+
+fail2:
+  free(copy);
+fail1:
+  if (shmem_id >= 0) {
+    rtapi_shmem_delete(shmem_id, comp_id);
+  }
+  hal_exit(comp_id);
+fail0:
+  return ret;
+}
@@ -0,0 +1,283 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Per-master scheduler for SDO writes made while running.
+///
+/// Drivers register every object they may write at runtime with
+/// `lcec_sdo_sched_add()` before activation, and then hand new values
+/// to `lcec_sdo_sched_write()` from their write functions.  Writes
+/// wait in one FIFO queue per priority; `lcec_sdo_sched_run()`, called
+/// once per cycle by the master, starts the oldest writes of the
+/// highest priority while fewer than `sdo.max-in-flight` are in
+/// flight, and collects the results of the ones that finished.
+///
+/// A value written to an object that is already queued replaces the
+/// queued value.  A value written while the object's write is in
+/// flight is queued again once it finishes.  Either way the last value
+/// always reaches the slave, while a pin that changes every cycle
+/// costs at most one mailbox transfer at a time.
+///
+/// Write functions of Sync Units with their own functions run in their
+/// own thread, so `lcec_sdo_sched_write()` never touches the queues.
+/// It stores the value and bumps the entry's `dirty` count; only
+/// `lcec_sdo_sched_run()` picks the dirty entries up and queues them,
+/// in the order they were registered.
+
+#include "lcec.h"
+
+#define LCEC_SDO_DEFAULT_MAX_IN_FLIGHT 4
+
+static ec_request_state_t lcec_sdo_ecrt_state(ec_sdo_request_t *req) { return ecrt_sdo_request_state(req); }
+static uint8_t *lcec_sdo_ecrt_data(ec_sdo_request_t *req) { return ecrt_sdo_request_data(req); }
+static void lcec_sdo_ecrt_write(ec_sdo_request_t *req) { ecrt_sdo_request_write(req); }
+
+/// @brief Backend using Etherlab's SDO requests.
+const lcec_sdo_backend_t lcec_sdo_ecrt_backend = {
+    .state = lcec_sdo_ecrt_state,
+    .data = lcec_sdo_ecrt_data,
+    .write = lcec_sdo_ecrt_write,
+};
+
+/// @brief Create a master's SDO scheduler and its pins.
+///
+/// @param master The master.
+/// @param pfx HAL name prefix, e.g. `lcec.0`.
+/// @return The scheduler, or NULL on failure.
+lcec_sdo_sched_t *lcec_sdo_sched_init(lcec_master_t *master, const char *pfx) {
+  lcec_sdo_sched_t *sched;
+
+  sched = (lcec_sdo_sched_t *)lcec_hal_malloc(sizeof(lcec_sdo_sched_t), __FILE__, __func__, __LINE__);
+
+  if (lcec_param_newf(HAL_U32, HAL_RW, (void *)&sched->max_in_flight, "%s.sdo.max-in-flight", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->queued, "%s.sdo.queued", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->in_flight, "%s.sdo.in-flight", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->completed, "%s.sdo.completed", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->aborted, "%s.sdo.aborted", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->coalesced, "%s.sdo.coalesced", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_S32, HAL_OUT, (void **)&sched->last_abort_slave, "%s.sdo.last-abort-slave", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&sched->last_abort_object, "%s.sdo.last-abort-object", pfx) != 0) {
+    return NULL;
+  }
+  sched->max_in_flight = LCEC_SDO_DEFAULT_MAX_IN_FLIGHT;
+  *(sched->last_abort_slave) = -1;
+  sched->backend = &lcec_sdo_ecrt_backend;
+  sched->master = master;
+
+  return sched;
+}
+
+/// @brief Register an object with an existing SDO request.
+///
+/// Used by `lcec_sdo_sched_add()`, and by tests with a fake backend.
+///
+/// @return The entry to pass to `lcec_sdo_sched_write()`, or NULL on failure.
+lcec_sdo_entry_t *lcec_sdo_sched_add_request(
+    lcec_sdo_sched_t *sched, ec_sdo_request_t *request, int slave_index, uint16_t index, uint8_t subindex, size_t size, int prio) {
+  lcec_sdo_entry_t *entry, **link;
+
+  if (size != 1 && size != 2 && size != 4) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "SDO %04x:%02x: runtime writes of %d bytes are not supported\n", index, subindex,
+        (int)size);
+    return NULL;
+  }
+  if (prio < 0 || prio >= LCEC_SDO_PRIO_COUNT) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "SDO %04x:%02x: invalid priority %d\n", index, subindex, prio);
+    return NULL;
+  }
+
+  entry = (lcec_sdo_entry_t *)lcec_hal_malloc(sizeof(lcec_sdo_entry_t), __FILE__, __func__, __LINE__);
+  entry->request = request;
+  entry->slave_index = slave_index;
+  entry->index = index;
+  entry->subindex = subindex;
+  entry->size = size;
+  entry->prio = prio;
+  entry->status = LCEC_SDO_IDLE;
+  // keep registration order, which is the queueing order within a cycle
+  link = &sched->entries;
+  while (*link != NULL) {
+    link = &(*link)->link;
+  }
+  *link = entry;
+
+  return entry;
+}
+
+/// @brief Register an object that a driver writes at runtime.
+///
+/// Creates the SDO request, so must be called before the master is
+/// activated, typically from the driver's init function.
+///
+/// @param slave The slave.
+/// @param index Object index.
+/// @param subindex Object subindex.
+/// @param size Object size in bytes: 1, 2 or 4.
+/// @param prio `LCEC_SDO_PRIO_*`.
+/// @return The entry to pass to `lcec_sdo_sched_write()`, or NULL on failure.
+lcec_sdo_entry_t *lcec_sdo_sched_add(lcec_slave_t *slave, uint16_t index, uint8_t subindex, size_t size, int prio) {
+  lcec_master_t *master = slave->master;
+  ec_sdo_request_t *request;
+
+  if (master->sdo_sched == NULL) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: no SDO scheduler\n", master->name, slave->name);
+    return NULL;
+  }
+  if ((request = ecrt_slave_config_create_sdo_request(slave->config, index, subindex, size)) == NULL) {
+    rtapi_print_msg(RTAPI_MSG_ERR, LCEC_MSG_PFX "slave %s.%s: failed to create SDO request %04x:%02x\n", master->name, slave->name,
+        index, subindex);
+    return NULL;
+  }
+
+  return lcec_sdo_sched_add_request(master->sdo_sched, request, slave->index, index, subindex, size, prio);
+}
+
+static void lcec_sdo_sched_enqueue(lcec_sdo_sched_t *sched, lcec_sdo_entry_t *entry) {
+  entry->next = NULL;
+  if (sched->tail[entry->prio] != NULL) {
+    sched->tail[entry->prio]->next = entry;
+  } else {
+    sched->head[entry->prio] = entry;
+  }
+  sched->tail[entry->prio] = entry;
+  entry->status = LCEC_SDO_QUEUED;
+  sched->queued_count++;
+}
+
+/// @brief Queue a write of `value`.
+///
+/// Call it when the value changes.  Safe to call from any thread, but
+/// each entry should only be written from one.
+void lcec_sdo_sched_write(lcec_sdo_entry_t *entry, uint32_t value) {
+  __atomic_store_n(&entry->value, value, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&entry->dirty, 1, __ATOMIC_RELEASE);
+}
+
+// Queue the entries written since the last run.
+static void lcec_sdo_sched_collect(lcec_sdo_sched_t *sched) {
+  lcec_sdo_entry_t *entry;
+
+  for (entry = sched->entries; entry != NULL; entry = entry->link) {
+    uint32_t writes = __atomic_exchange_n(&entry->dirty, 0, __ATOMIC_ACQUIRE);
+
+    if (writes == 0) {
+      continue;
+    }
+    // all but the last of the writes never started
+    *(sched->coalesced) += writes - 1;
+
+    if (entry->status == LCEC_SDO_QUEUED || entry->pending) {
+      // not started yet; the new value replaces the old one
+      (*(sched->coalesced))++;
+    } else if (entry->status == LCEC_SDO_BUSY) {
+      entry->pending = 1;
+    } else {
+      lcec_sdo_sched_enqueue(sched, entry);
+    }
+  }
+}
+
+static void lcec_sdo_sched_start(lcec_sdo_sched_t *sched, lcec_sdo_entry_t *entry) {
+  uint8_t *data = sched->backend->data(entry->request);
+  uint32_t value = __atomic_load_n(&entry->value, __ATOMIC_RELAXED);
+
+  switch (entry->size) {
+    case 1:
+      EC_WRITE_U8(data, value);
+      break;
+    case 2:
+      EC_WRITE_U16(data, value);
+      break;
+    default:
+      EC_WRITE_U32(data, value);
+      break;
+  }
+  sched->backend->write(entry->request);
+  entry->sent = value;
+  entry->status = LCEC_SDO_BUSY;
+  entry->next = sched->busy;
+  sched->busy = entry;
+  sched->busy_count++;
+}
+
+/// @brief Collect finished writes, queue new ones and start queued ones.
+///
+/// Called once per cycle by the master, and only from its thread.
+void lcec_sdo_sched_run(lcec_sdo_sched_t *sched) {
+  lcec_sdo_entry_t **link = &sched->busy;
+  lcec_sdo_entry_t *entry;
+  uint32_t max_in_flight = (sched->max_in_flight > 0) ? sched->max_in_flight : 1;
+
+  // collect finished writes
+  while ((entry = *link) != NULL) {
+    ec_request_state_t state = sched->backend->state(entry->request);
+
+    if (state == EC_REQUEST_BUSY) {
+      link = &entry->next;
+      continue;
+    }
+    *link = entry->next;
+    sched->busy_count--;
+
+    if (state == EC_REQUEST_SUCCESS) {
+      entry->status = LCEC_SDO_DONE;
+      (*(sched->completed))++;
+    } else {
+      entry->status = LCEC_SDO_ABORTED;
+      (*(sched->aborted))++;
+      *(sched->last_abort_slave) = entry->slave_index;
+      *(sched->last_abort_object) = (uint32_t)entry->index << 8 | entry->subindex;
+      lcec_trace_event(sched->master->trace, LCEC_TRACE_SDO_DOWNLOAD_FAIL, entry->slave_index, *(sched->last_abort_object), 0);
+    }
+    if (entry->pending) {
+      entry->pending = 0;
+      lcec_sdo_sched_enqueue(sched, entry);
+    }
+  }
+
+  lcec_sdo_sched_collect(sched);
+
+  // start queued writes, highest priority first
+  for (int prio = 0; prio < LCEC_SDO_PRIO_COUNT && sched->busy_count < max_in_flight; prio++) {
+    while ((entry = sched->head[prio]) != NULL && sched->busy_count < max_in_flight) {
+      sched->head[prio] = entry->next;
+      if (sched->head[prio] == NULL) {
+        sched->tail[prio] = NULL;
+      }
+      sched->queued_count--;
+      lcec_sdo_sched_start(sched, entry);
+    }
+  }
+
+  *(sched->queued) = sched->queued_count;
+  *(sched->in_flight) = sched->busy_count;
+}
@@ -0,0 +1,127 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief RT execution-time statistics for the exported HAL functs.
+///
+/// Each timed section gets min/max/mean pins and a log2 histogram.
+/// Timestamps are only taken while the `time-enable` param is set, so
+/// the cost when disabled is one branch per section.
+
+#include "lcec.h"
+
+/// @brief Allocate and export execution-time statistics.
+///
+/// Pins are named `<pfx>.time.<section>.{min,max,mean,hist-NN}`,
+/// plus `<pfx>.time-enable` and `<pfx>.time-reset`.
+///
+/// @param pfx HAL name prefix, e.g. `lcec.0`.
+/// @param section_names Pin name for each section.
+/// @param section_count Number of sections.
+/// @return The statistics, or NULL if exporting pins failed.
+lcec_timing_t *lcec_timing_init(const char *pfx, const char *const *section_names, int section_count) {
+  lcec_timing_t *timing;
+  int i, b;
+
+  timing = (lcec_timing_t *)lcec_hal_malloc(
+      sizeof(lcec_timing_t) + section_count * sizeof(lcec_timing_stat_t), __FILE__, __func__, __LINE__);
+  timing->stat_count = section_count;
+
+  if (lcec_param_newf(HAL_BIT, HAL_RW, (void *)&timing->enable, "%s.time-enable", pfx) != 0) {
+    return NULL;
+  }
+  if (lcec_pin_newf(HAL_BIT, HAL_IO, (void **)&timing->reset, "%s.time-reset", pfx) != 0) {
+    return NULL;
+  }
+
+  for (i = 0; i < section_count; i++) {
+    lcec_timing_stat_t *st = &timing->stats[i];
+
+    if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&st->min, "%s.time.%s.min", pfx, section_names[i]) != 0) {
+      return NULL;
+    }
+    if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&st->max, "%s.time.%s.max", pfx, section_names[i]) != 0) {
+      return NULL;
+    }
+    if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&st->mean, "%s.time.%s.mean", pfx, section_names[i]) != 0) {
+      return NULL;
+    }
+    for (b = 0; b < LCEC_TIMING_BUCKETS; b++) {
+      if (lcec_pin_newf(HAL_U32, HAL_OUT, (void **)&st->hist[b], "%s.time.%s.hist-%02d", pfx, section_names[i], b) != 0) {
+        return NULL;
+      }
+    }
+  }
+
+  return timing;
+}
+
+/// @brief Record one run of `section` that took `ns` nanoseconds.
+///
+/// Bucket 0 counts runs under 1 us, bucket N counts runs from
+/// 2^(N-1) us up to 2^N us, and the last bucket collects everything
+/// from 1 ms up.
+void lcec_timing_add(lcec_timing_t *timing, int section, long long ns) {
+  lcec_timing_stat_t *st = &timing->stats[section];
+  uint32_t t = (ns < 0) ? 0 : (ns > 0xffffffffLL) ? 0xffffffffu : (uint32_t)ns;
+  int bucket;
+
+  if (st->count == 0 || t < *(st->min)) {
+    *(st->min) = t;
+  }
+  if (t > *(st->max)) {
+    *(st->max) = t;
+  }
+  if (st->count == 0x80000000u) {
+    // keep the mean meaningful on long runs instead of wrapping
+    st->sum >>= 1;
+    st->count >>= 1;
+  }
+  st->sum += t;
+  st->count++;
+  *(st->mean) = (uint32_t)(st->sum / st->count);
+
+  if (t < 1024) {
+    bucket = 0;
+  } else {
+    bucket = (31 - __builtin_clz(t)) - 9;
+    if (bucket >= LCEC_TIMING_BUCKETS) {
+      bucket = LCEC_TIMING_BUCKETS - 1;
+    }
+  }
+  (*(st->hist[bucket]))++;
+}
+
+/// @brief Clear all statistics; called from the RT thread when the reset pin is set.
+void lcec_timing_reset(lcec_timing_t *timing) {
+  int i, b;
+
+  *(timing->reset) = 0;
+  for (i = 0; i < timing->stat_count; i++) {
+    lcec_timing_stat_t *st = &timing->stats[i];
+
+    st->sum = 0;
+    st->count = 0;
+    *(st->min) = 0;
+    *(st->max) = 0;
+    *(st->mean) = 0;
+    for (b = 0; b < LCEC_TIMING_BUCKETS; b++) {
+      *(st->hist[b]) = 0;
+    }
+  }
+}
@@ -0,0 +1,156 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Per-master RT event trace ring.
+///
+/// The RT side only ever calls `lcec_trace_event()` from `lcec.h`.
+/// Everything here is setup, or reading and decoding for `lcec_trace`.
+
+#include "lcec_trace.h"
+
+#include "lcec_rtapi.h"
+#include "rtapi_string.h"
+
+static const char *const lcec_trace_type_names[LCEC_TRACE_TYPE_COUNT] = {
+    "none",
+    "activate",
+    "master-state",
+    "slave-state",
+    "wkc",
+    "pll-reset",
+    "dc-sync-miss",
+    "sdo-upload-fail",
+    "sdo-download-fail",
+    "lock-wait",
+};
+
+/// @brief Create and initialize the trace ring for a master in user/RT shared memory.
+///
+/// @param master_index Index of the master; selects the shared memory key.
+/// @param comp_id HAL component that owns the memory.
+/// @param[out] shmem_id Shared memory id, for `rtapi_shmem_delete`.
+/// @return The ring, or NULL on failure.
+lcec_trace_ring_t *lcec_trace_init(int master_index, int comp_id, int *shmem_id) {
+  void *ptr;
+
+  *shmem_id = rtapi_shmem_new(LCEC_TRACE_SHMEM_KEY + master_index, comp_id, sizeof(lcec_trace_ring_t));
+  if (*shmem_id < 0) {
+    return NULL;
+  }
+  if (lcec_rtapi_shmem_getptr(*shmem_id, &ptr) < 0) {
+    rtapi_shmem_delete(*shmem_id, comp_id);
+    *shmem_id = -1;
+    return NULL;
+  }
+
+  lcec_trace_reset((lcec_trace_ring_t *)ptr);
+  return (lcec_trace_ring_t *)ptr;
+}
+
+/// @brief Empty a ring and mark it valid.
+void lcec_trace_reset(lcec_trace_ring_t *ring) {
+  memset(ring, 0, sizeof(lcec_trace_ring_t));
+  ring->size = LCEC_TRACE_SIZE;
+  ring->magic = LCEC_TRACE_MAGIC;
+}
+
+/// @brief Copy events written since `*tail` out of a ring.
+///
+/// Never blocks the writer.  Events the writer overwrote before they
+/// could be read, either before this call or while copying, are
+/// dropped and added to `*lost`.
+///
+/// @param ring The ring.
+/// @param[in,out] tail Index of the next event to read.  Start at 0 to
+///   read everything still in the ring.
+/// @param[out] events Copied events, oldest first.
+/// @param max Size of `events`.
+/// @param[in,out] lost Incremented by the number of dropped events.
+/// @return Number of events copied to `events`.
+int lcec_trace_read(const lcec_trace_ring_t *ring, uint32_t *tail, lcec_trace_event_t *events, int max, uint32_t *lost) {
+  uint32_t head, start, avail;
+  int32_t overrun;
+  int i, n;
+
+  head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+  avail = head - *tail;
+  if (avail > LCEC_TRACE_SIZE) {
+    *lost += avail - LCEC_TRACE_SIZE;
+    *tail = head - LCEC_TRACE_SIZE;
+    avail = LCEC_TRACE_SIZE;
+  }
+  n = (avail < (uint32_t)max) ? (int)avail : max;
+  start = *tail;
+  for (i = 0; i < n; i++) {
+    events[i] = ring->events[(start + i) & (LCEC_TRACE_SIZE - 1)];
+  }
+
+  // The writer may have lapped us while copying.  Event `head` may be
+  // half-written, so anything sharing its slot or older is suspect.
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+  overrun = (int32_t)(head + 1 - LCEC_TRACE_SIZE - start);
+  if (overrun > 0) {
+    if (overrun > n) {
+      overrun = n;
+    }
+    memmove(events, events + overrun, (n - overrun) * sizeof(lcec_trace_event_t));
+    *lost += overrun;
+    n -= overrun;
+    start += overrun;
+  }
+
+  *tail = start + n;
+  return n;
+}
+
+/// @brief Name of an event type, as printed by `lcec_trace`.
+const char *lcec_trace_type_name(int type) {
+  if (type < 0 || type >= LCEC_TRACE_TYPE_COUNT) {
+    return "unknown";
+  }
+  return lcec_trace_type_names[type];
+}
+
+/// @brief Describe an event's arguments in human-readable form.
+///
+/// @return Length of the text, as `rtapi_snprintf`.
+int lcec_trace_format(const lcec_trace_event_t *ev, char *buf, unsigned long size) {
+  switch (ev->type) {
+    case LCEC_TRACE_ACTIVATE:
+      return rtapi_snprintf(buf, size, "%s", ev->a == 0 ? "ok" : "failed");
+    case LCEC_TRACE_MASTER_STATE:
+      return rtapi_snprintf(buf, size, "al_states 0x%02x -> 0x%02x", ev->a, ev->b);
+    case LCEC_TRACE_SLAVE_STATE:
+      return rtapi_snprintf(buf, size, "al_state 0x%02x -> 0x%02x", ev->a, ev->b);
+    case LCEC_TRACE_WKC:
+      return rtapi_snprintf(buf, size, "%u -> %u", ev->a, ev->b);
+    case LCEC_TRACE_PLL_RESET:
+      return rtapi_snprintf(buf, size, "offset %d ns, correction %d ns", (int32_t)ev->a, (int32_t)ev->b);
+    case LCEC_TRACE_DC_SYNC_MISS:
+      return rtapi_snprintf(buf, size, "%u consecutive", ev->a);
+    case LCEC_TRACE_SDO_UPLOAD_FAIL:
+    case LCEC_TRACE_SDO_DOWNLOAD_FAIL:
+      return rtapi_snprintf(buf, size, "0x%04x:0x%02x abort_code %08x", ev->a >> 8, ev->a & 0xff, ev->b);
+    case LCEC_TRACE_LOCK_WAIT:
+      return rtapi_snprintf(buf, size, "%u ns%s", ev->a, ev->b ? ", gave up" : "");
+    default:
+      return rtapi_snprintf(buf, size, "a=0x%08x b=0x%08x", ev->a, ev->b);
+  }
+}
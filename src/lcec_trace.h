@@ -0,0 +1,77 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Layout of the per-master RT event trace ring.
+///
+/// Shared between `lcec.so`, which writes events from the master's
+/// thread, and the `lcec_trace` tool, which reads them from user/RT
+/// shared memory.  Keep both sides in sync when changing anything here.
+
+#ifndef _LCEC_TRACE_H_
+#define _LCEC_TRACE_H_
+
+#include <rtapi_stdint.h>
+
+#define LCEC_TRACE_SHMEM_KEY 0xACB57300  ///< Plus the master index.
+#define LCEC_TRACE_MAGIC     0x4C435452  ///< "LCTR"
+#define LCEC_TRACE_SIZE      1024        ///< Events per ring; power of 2.
+
+#define LCEC_TRACE_NONE              0
+#define LCEC_TRACE_ACTIVATE          1   ///< Master activated.  `a`: 0 on success, else -1.
+#define LCEC_TRACE_MASTER_STATE      2   ///< Master AL states changed.  `a`: old, `b`: new.
+#define LCEC_TRACE_SLAVE_STATE       3   ///< Slave AL state changed.  `a`: old, `b`: new.
+#define LCEC_TRACE_WKC               4   ///< Working counter changed.  `a`: old, `b`: new.
+#define LCEC_TRACE_PLL_RESET         5   ///< PLL resync.  `a`: offset (ns, signed), `b`: correction (ns, signed).
+#define LCEC_TRACE_DC_SYNC_MISS      6   ///< DC synchrony monitor datagram lost.  `a`: consecutive misses.
+#define LCEC_TRACE_SDO_UPLOAD_FAIL   7   ///< SDO read failed.  `a`: index << 8 | subindex, `b`: abort code.
+#define LCEC_TRACE_SDO_DOWNLOAD_FAIL 8   ///< SDO write failed.  `a`: index << 8 | subindex, `b`: abort code.
+#define LCEC_TRACE_LOCK_WAIT         9   ///< Cyclic path waited for the master lock.  `a`: wait (ns), `b`: 1 if it gave up.
+#define LCEC_TRACE_TYPE_COUNT        10
+
+/// @brief One trace event.
+typedef struct {
+  int64_t time;    ///< `rtapi_get_time()` when the event was written, in ns.
+  uint16_t type;   ///< One of `LCEC_TRACE_*`.
+  int16_t slave;   ///< Slave index, or -1 for master events.
+  uint32_t a;      ///< First argument, see the event type.
+  uint32_t b;      ///< Second argument, see the event type.
+  uint32_t pad;
+} lcec_trace_event_t;
+
+/// @brief Single-producer ring of trace events.
+///
+/// Only the master's thread writes: it fills `events[head % size]`,
+/// then publishes it by incrementing `head`.  Readers never write to
+/// the ring; each keeps its own tail and checks after copying whether
+/// the writer lapped it (see `lcec_trace_read`).
+typedef struct {
+  uint32_t magic;  ///< `LCEC_TRACE_MAGIC` once initialized.
+  uint32_t size;   ///< `LCEC_TRACE_SIZE`.
+  uint32_t head;   ///< Number of events written so far; wraps.
+  uint32_t pad;
+  lcec_trace_event_t events[LCEC_TRACE_SIZE];
+} lcec_trace_ring_t;
+
+lcec_trace_ring_t *lcec_trace_init(int master_index, int comp_id, int *shmem_id);
+void lcec_trace_reset(lcec_trace_ring_t *ring);
+int lcec_trace_read(const lcec_trace_ring_t *ring, uint32_t *tail, lcec_trace_event_t *events, int max, uint32_t *lost);
+const char *lcec_trace_type_name(int type);
+int lcec_trace_format(const lcec_trace_event_t *ev, char *buf, unsigned long size);
+
+#endif
@@ -0,0 +1,140 @@
+//
+//    Copyright (C) 2026 LinuxCNC EtherCAT
+//
+//    This program is free software; you can redistribute it and/or modify
+//    it under the terms of the GNU General Public License as published by
+//    the Free Software Foundation; either version 2 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//    GNU General Public License for more details.
+//
+//    You should have received a copy of the GNU General Public License
+//    along with this program; if not, write to the Free Software
+//    Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301 USA
+//
+
+/// @file
+/// @brief Code for the `lcec_trace` tool, which prints a master's RT event trace.
+///
+/// Usage: `lcec_trace [-f] [master-index]`.  Without `-f` it prints
+/// the events still in the ring and exits; with `-f` it keeps
+/// printing new events until interrupted.
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hal.h"
+#include "lcec_rtapi.h"
+#include "lcec_trace.h"
+#include "rtapi.h"
+
+#define POLL_US 100000
+
+static volatile int done;
+
+static void exitHandler(int sig) { done = 1; }
+
+static void usage(const char *prog) { fprintf(stderr, "usage: %s [-f] [master-index]\n", prog); }
+
+int main(int argc, char **argv) {
+  int ret = 1;
+  int follow = 0;
+  int master_index = 0;
+  int comp_id, shmem_id;
+  void *shmem_ptr;
+  lcec_trace_ring_t *ring;
+  lcec_trace_event_t events[64];
+  uint32_t tail, lost, reported_lost;
+  int64_t last_time;
+  char text[128];
+  int opt, i, n;
+
+  while ((opt = getopt(argc, argv, "fh")) != -1) {
+    switch (opt) {
+      case 'f':
+        follow = 1;
+        break;
+      default:
+        usage(argv[0]);
+        return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (optind < argc) {
+    master_index = atoi(argv[optind]);
+  }
+
+  comp_id = hal_init("lcec_trace");
+  if (comp_id < 1) {
+    fprintf(stderr, "lcec_trace: ERROR: hal_init failed\n");
+    goto fail0;
+  }
+
+  shmem_id = rtapi_shmem_new(LCEC_TRACE_SHMEM_KEY + master_index, comp_id, sizeof(lcec_trace_ring_t));
+  if (shmem_id < 0) {
+    fprintf(stderr, "lcec_trace: ERROR: couldn't attach to the trace of master %d\n", master_index);
+    goto fail1;
+  }
+  if (lcec_rtapi_shmem_getptr(shmem_id, &shmem_ptr) < 0) {
+    fprintf(stderr, "lcec_trace: ERROR: couldn't map the trace of master %d\n", master_index);
+    goto fail2;
+  }
+  ring = (lcec_trace_ring_t *)shmem_ptr;
+  if (ring->magic != LCEC_TRACE_MAGIC || ring->size != LCEC_TRACE_SIZE) {
+    fprintf(stderr, "lcec_trace: ERROR: no trace for master %d; is lcec loaded?\n", master_index);
+    goto fail2;
+  }
+
+  signal(SIGINT, exitHandler);
+  signal(SIGTERM, exitHandler);
+
+  // start at whatever is still in the ring
+  tail = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+  tail = (tail > LCEC_TRACE_SIZE) ? tail - LCEC_TRACE_SIZE : 0;
+  lost = reported_lost = 0;
+  last_time = 0;
+
+  ret = 0;
+  while (!done) {
+    n = lcec_trace_read(ring, &tail, events, sizeof(events) / sizeof(events[0]), &lost);
+    if (lost != reported_lost) {
+      printf("-- %u events lost\n", lost - reported_lost);
+      reported_lost = lost;
+    }
+    for (i = 0; i < n; i++) {
+      lcec_trace_event_t *ev = &events[i];
+
+      lcec_trace_format(ev, text, sizeof(text));
+      printf("%lld.%09lld %+12.6f ms  %-17s ", (long long)(ev->time / 1000000000), (long long)(ev->time % 1000000000),
+          last_time ? (ev->time - last_time) / 1e6 : 0.0, lcec_trace_type_name(ev->type));
+      if (ev->slave >= 0) {
+        printf("slave %-3d ", ev->slave);
+      } else {
+        printf("          ");
+      }
+      printf("%s\n", text);
+      last_time = ev->time;
+    }
+    fflush(stdout);
+
+    if (n == sizeof(events) / sizeof(events[0])) {
+      continue;
+    }
+    if (!follow) {
+      break;
+    }
+    usleep(POLL_US);
+  }
+
+fail2:
+  rtapi_shmem_delete(shmem_id, comp_id);
+fail1:
+  hal_exit(comp_id);
+fail0:
+  return ret;
+}
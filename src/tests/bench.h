@@ -0,0 +1,43 @@
+/// Very simple benchmark setup for LinuxCNC-Ethercat.
+///
+/// Benchmarks live in `tests/bench_*.c` and are built and run by
+/// `make bench`.  They are not part of `make test`: they never fail,
+/// they just print timings.  Each benchmark is a `main()` that times
+/// the code under test with `BENCH_RUN()` and prints one line per
+/// case with `BENCH_REPORT()`, so old and new code paths can be
+/// compared side by side.  Numbers are only meaningful relative to
+/// each other on the same machine; run them on an idle core (e.g.
+/// `taskset -c 3 tests/bench_dispatch.bin`) for stable results.
+
+#include <stdio.h>
+#include <time.h>
+
+/// Current monotonic time in ns.
+static inline long long bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/// Run `body` `iterations` times and store the mean time per
+/// iteration (in ns, as a double) in `result`.  `setup` runs before
+/// every iteration and is not timed.
+#define BENCH_RUN(result, iterations, setup, body)              \
+  do {                                                          \
+    long long bench_total = 0;                                  \
+    for (long bench_i = 0; bench_i < (iterations); bench_i++) { \
+      long long bench_start;                                    \
+      setup;                                                    \
+      bench_start = bench_now_ns();                             \
+      body;                                                     \
+      bench_total += bench_now_ns() - bench_start;              \
+    }                                                           \
+    (result) = (double)bench_total / (iterations);              \
+  } while (0)
+
+/// Print one result line comparing an old and a new implementation.
+#define BENCH_REPORT(name, old_ns, new_ns) \
+  printf("%-40s old %10.1f ns  new %10.1f ns  speedup %5.2fx\n", name, old_ns, new_ns, (new_ns) > 0 ? (old_ns) / (new_ns) : 0.0)
+
+/// Keep the compiler from optimizing away a computed value.
+#define BENCH_KEEP(x) __asm__ volatile("" : : "g"(x) : "memory")
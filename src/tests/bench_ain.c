@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/devices/lcec_class_ain.h"
+#include "../../src/lcec.h"
+#include "bench.h"
+#include "tests.h"
+
+// Compares reducing oversampled analog inputs one sample at a time in
+// floating point, with a per-sample offset lookup, against
+// lcec_ain_oversample() and its integer lane kernels, for 8 channels
+// of 10 to 100 samples each as an EL3702 maps them.
+
+#define ITERATIONS 20000
+#define CHANNELS   8
+#define PD_BYTES   (CHANNELS * LCEC_AIN_MAX_OVERSAMPLING * 2)
+
+static uint8_t pd[PD_BYTES];
+
+// The straightforward reduction: read every sample, then fold it into
+// a double.
+static double legacy_reduce(lcec_class_ain_oversampling_t *os, const uint8_t *pd) {
+  double acc = 0, y = os->state;
+
+  for (int k = 0; k < os->count; k++) {
+    double sample = EC_READ_S16(&pd[os->sample_os[k]]);
+
+    switch (os->filter) {
+      case LCEC_AIN_FILTER_MIN:
+        acc = (k == 0 || sample < acc) ? sample : acc;
+        break;
+      case LCEC_AIN_FILTER_MAX:
+        acc = (k == 0 || sample > acc) ? sample : acc;
+        break;
+      case LCEC_AIN_FILTER_FIR:
+        acc += sample * os->weights[k] * (1.0 / (1 << 15));
+        break;
+      case LCEC_AIN_FILTER_IIR:
+        y += os->alpha * (sample - y);
+        break;
+      default:
+        acc += sample;
+        break;
+    }
+  }
+  switch (os->filter) {
+    case LCEC_AIN_FILTER_MEAN:
+      return acc / os->count;
+    case LCEC_AIN_FILTER_IIR:
+      os->state = y;
+      return y;
+  }
+  return acc;
+}
+
+static lcec_class_ain_oversampling_t *new_channel(lcec_slave_t *slave, int id, int samples, int filter) {
+  lcec_class_ain_options_t *opt = lcec_ain_options();
+  lcec_class_ain_channel_t *channel;
+
+  opt->valueonly = 1;
+  opt->oversampling = samples;
+  opt->oversampling_filter = filter;
+  channel = lcec_ain_register_channel(slave, id, 0x6000, opt);
+  // consecutive samples, as lcec_ain_plan() finds them
+  for (int k = 0; k < samples; k++) {
+    channel->oversampling->sample_os[k] = (id * samples + k) * 2;
+  }
+  channel->oversampling->contiguous = 1;
+  return channel->oversampling;
+}
+
+int main(int argc, char **argv) {
+  static const int counts[] = {10, 25, 50, 100};
+  static const char *const names[] = {"mean", "min", "max", "fir", "iir"};
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+  char name[64];
+
+  snprintf(slave->name, sizeof(slave->name), "ain");
+  srand(1);
+  for (int i = 0; i < PD_BYTES; i++) {
+    pd[i] = rand();
+  }
+
+  for (int c = 0; c < (int)(sizeof(counts) / sizeof(counts[0])); c++) {
+    for (int f = LCEC_AIN_FILTER_MEAN; f <= LCEC_AIN_FILTER_IIR; f++) {
+      lcec_class_ain_oversampling_t *os[CHANNELS];
+      double old_ns, new_ns;
+
+      for (int i = 0; i < CHANNELS; i++) {
+        os[i] = new_channel(slave, i, counts[c], f);
+      }
+      BENCH_RUN(old_ns, ITERATIONS, , for (int i = 0; i < CHANNELS; i++) BENCH_KEEP(legacy_reduce(os[i], pd)));
+      BENCH_RUN(new_ns, ITERATIONS, , for (int i = 0; i < CHANNELS; i++) BENCH_KEEP(lcec_ain_oversample(os[i], pd, 0x8000)));
+      snprintf(name, sizeof(name), "%d x %d samples, %s", CHANNELS, counts[c], names[f]);
+      BENCH_REPORT(name, old_ns, new_ns);
+    }
+  }
+
+  return 0;
+}
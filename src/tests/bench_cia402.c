@@ -0,0 +1,117 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "../../src/devices/lcec_class_cia402.h"
+#include "../../src/devices/lcec_class_cia402_opt.h"
+#include "../../src/lcec.h"
+#include "bench.h"
+#include "tests.h"
+
+// Compares the per-object `READ_OPT` / `WRITE_OPT` / `WRITE_OPT_SDO`
+// expansions that lcec_cia402_read() and lcec_cia402_write() used to
+// run, which test every object's enable flag each cycle, against the
+// op tables lcec_cia402_register_channel() now builds, for 8 axes.
+// Both hand SDO changes to the master's SDO scheduler.
+// The old versions are kept out of line, like the library's.
+
+#define ITERATIONS 200000
+#define AXES       8
+#define PD_BYTES   (AXES * 64)
+
+static uint8_t pd[PD_BYTES];
+
+static __attribute__((noinline)) void legacy_read(lcec_slave_t *slave, lcec_class_cia402_channel_t *data) {
+  uint8_t *pd = slave->sync_unit->process_data;
+
+#define READ_OPT(pin_name)              \
+  if (data->enabled->enable_##pin_name) \
+  *(data->pin_name) = (SUBSTJOIN3(EC_READ_, PDO_SIGN_##pin_name, PDO_BITS_##pin_name)(&pd[data->pin_name##_os]))
+
+  *(data->statusword) = EC_READ_U16(&pd[data->statusword_os]);
+  FOR_ALL_READ_PDOS_DO(READ_OPT);
+}
+
+static __attribute__((noinline)) void legacy_write(lcec_slave_t *slave, lcec_class_cia402_channel_t *data) {
+  uint8_t *pd = slave->sync_unit->process_data;
+
+#define WRITE_OPT(name) \
+  if (data->enabled->enable_##name) SUBSTJOIN3(EC_WRITE_, PDO_SIGN_##name, PDO_BITS_##name)(&pd[data->name##_os], *(data->name))
+#define WRITE_OPT_SDO(name)                                       \
+  do {                                                            \
+    if (data->enabled->enable_##name) {                           \
+      if (*(data->name) != data->name##_old) {                    \
+        data->name##_old = *(data->name);                         \
+        lcec_sdo_sched_write(data->name##_sdo, data->name##_old); \
+      }                                                           \
+    }                                                             \
+  } while (0)
+
+  EC_WRITE_U16(&pd[data->controlword_os], (uint16_t)(*(data->controlword)));
+  FOR_ALL_WRITE_PDOS_DO(WRITE_OPT);
+  FOR_ALL_WRITE_SDOS_DO(WRITE_OPT_SDO);
+}
+
+// Lay the enabled objects out back to back, as lcec_pdo_init() would.
+static unsigned int place(const int *enabled, unsigned int *os, unsigned int at, int bits) {
+  if (!enabled || *enabled) {
+    *os = at;
+    at += bits / 8;
+  }
+  return at;
+}
+
+static lcec_class_cia402_channel_t *new_axis(lcec_slave_t *slave, int axis, int everything) {
+  lcec_class_cia402_channel_options_t *opt = lcec_cia402_channel_options();
+  lcec_class_cia402_channel_t *data;
+  unsigned int at = axis * 64;
+
+  opt->enable_csp = 1;
+  opt->digital_in_channels = opt->digital_out_channels = 0;
+  if (everything) {
+    opt->enable_pv = 1;
+    opt->enable_actual_current = opt->enable_actual_following_error = opt->enable_actual_torque = 1;
+    opt->enable_actual_velocity_sensor = opt->enable_actual_vl = opt->enable_actual_voltage = 1;
+    opt->enable_control_effort = opt->enable_error_code = opt->enable_position_demand = opt->enable_probe_status = 1;
+    opt->enable_torque_demand = opt->enable_velocity_demand = opt->enable_vl_demand = 1;
+    opt->enable_profile_velocity = opt->enable_target_torque = opt->enable_target_vl = 1;
+  }
+  data = lcec_cia402_register_channel(slave, 0x6000 + axis * 0x800, opt);
+
+  at = place(NULL, &data->controlword_os, at, 16);
+  at = place(NULL, &data->statusword_os, at, 16);
+#define PLACE(name) at = place(&data->enabled->enable_##name, &data->name##_os, at, PDO_BITS_##name)
+  FOR_ALL_READ_PDOS_DO(PLACE);
+  FOR_ALL_WRITE_PDOS_DO(PLACE);
+  lcec_cia402_plan(slave, data);
+  return data;
+}
+
+int main(int argc, char **argv) {
+  static const char *const names[] = {"csp", "all pdos"};
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+  char name[64];
+
+  snprintf(slave->name, sizeof(slave->name), "cia402");
+  memset(pd, 0x5a, sizeof(pd));
+
+  for (int everything = 0; everything < 2; everything++) {
+    lcec_class_cia402_channel_t *axes[AXES];
+    double old_ns, new_ns;
+
+    for (int i = 0; i < AXES; i++) {
+      axes[i] = new_axis(slave, i, everything);
+    }
+
+    BENCH_RUN(old_ns, ITERATIONS, , for (int i = 0; i < AXES; i++) legacy_read(slave, axes[i]));
+    BENCH_RUN(new_ns, ITERATIONS, , for (int i = 0; i < AXES; i++) lcec_cia402_read(slave, axes[i]));
+    snprintf(name, sizeof(name), "read %d axes, %s", AXES, names[everything]);
+    BENCH_REPORT(name, old_ns, new_ns);
+
+    BENCH_RUN(old_ns, ITERATIONS, , for (int i = 0; i < AXES; i++) legacy_write(slave, axes[i]));
+    BENCH_RUN(new_ns, ITERATIONS, , for (int i = 0; i < AXES; i++) lcec_cia402_write(slave, axes[i]));
+    snprintf(name, sizeof(name), "write %d axes, %s", AXES, names[everything]);
+    BENCH_REPORT(name, old_ns, new_ns);
+  }
+
+  return 0;
+}
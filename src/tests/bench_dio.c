@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/devices/lcec_class_din.h"
+#include "../../src/devices/lcec_class_dout.h"
+#include "../../src/lcec.h"
+#include "bench.h"
+#include "tests.h"
+
+// Compares the per-channel digital I/O access that lcec_din_read_all()
+// and lcec_dout_write_all() used to do with the per-word channel
+// groups, on a bus of 64 EL1809 and 64 EL2809 terminals with 16
+// channels each, packed back to back in one Sync Unit.
+
+#define ITERATIONS 100000
+#define SLAVES     64
+#define CHANNELS   16
+#define PD_BYTES   (2 * SLAVES * CHANNELS / 8)
+
+static uint8_t pd[PD_BYTES];
+
+// One terminal, with its channels placed the way an EL1809/EL2809 maps
+// them: bit i of the 2 bytes at `os`.
+static lcec_slave_t *new_slave(int index, unsigned int os, int out) {
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+
+  snprintf(slave->name, sizeof(slave->name), "%s%d", out ? "dout" : "din", index);
+
+  if (out) {
+    lcec_class_dout_channels_t *channels = lcec_dout_allocate_channels(CHANNELS);
+    for (int i = 0; i < CHANNELS; i++) {
+      channels->channels[i] = lcec_dout_register_channel(slave, i, 0x7000 + (i << 4), 0x01);
+      channels->channels[i]->pdo_os = os + i / 8;
+      channels->channels[i]->pdo_bp = i % 8;
+      *(channels->channels[i]->out) = (index + i) & 1;
+    }
+    lcec_dout_plan(slave, channels);
+    slave->hal_data = channels;
+  } else {
+    lcec_class_din_channels_t *channels = lcec_din_allocate_channels(CHANNELS);
+    for (int i = 0; i < CHANNELS; i++) {
+      channels->channels[i] = lcec_din_register_channel(slave, i, 0x6000 + (i << 4), 0x01);
+      channels->channels[i]->pdo_os = os + i / 8;
+      channels->channels[i]->pdo_bp = i % 8;
+    }
+    lcec_din_plan(slave, channels);
+    slave->hal_data = channels;
+  }
+  return slave;
+}
+
+// The cyclic loops as they were before channel groups.
+static void legacy_read(lcec_slave_t **slaves) {
+  for (int s = 0; s < SLAVES; s++) {
+    lcec_class_din_channels_t *channels = (lcec_class_din_channels_t *)slaves[s]->hal_data;
+    for (int i = 0; i < channels->count; i++) {
+      lcec_din_read(slaves[s], channels->channels[i]);
+    }
+  }
+}
+
+static void legacy_write(lcec_slave_t **slaves) {
+  for (int s = 0; s < SLAVES; s++) {
+    lcec_class_dout_channels_t *channels = (lcec_class_dout_channels_t *)slaves[s]->hal_data;
+    for (int i = 0; i < channels->count; i++) {
+      lcec_dout_write(slaves[s], channels->channels[i]);
+    }
+  }
+}
+
+static void grouped_read(lcec_slave_t **slaves) {
+  for (int s = 0; s < SLAVES; s++) {
+    lcec_din_read_all(slaves[s], (lcec_class_din_channels_t *)slaves[s]->hal_data);
+  }
+}
+
+static void grouped_write(lcec_slave_t **slaves) {
+  for (int s = 0; s < SLAVES; s++) {
+    lcec_dout_write_all(slaves[s], (lcec_class_dout_channels_t *)slaves[s]->hal_data);
+  }
+}
+
+int main(int argc, char **argv) {
+  lcec_slave_t *in[SLAVES], *out[SLAVES];
+  char name[64];
+  double old_ns, new_ns;
+
+  for (int i = 0; i < PD_BYTES; i++) {
+    pd[i] = i * 13;
+  }
+  for (int s = 0; s < SLAVES; s++) {
+    in[s] = new_slave(s, s * CHANNELS / 8, 0);
+    out[s] = new_slave(s, (SLAVES + s) * CHANNELS / 8, 1);
+  }
+
+  BENCH_RUN(old_ns, ITERATIONS, , legacy_read(in); BENCH_KEEP(pd));
+  BENCH_RUN(new_ns, ITERATIONS, , grouped_read(in); BENCH_KEEP(pd));
+  snprintf(name, sizeof(name), "read %d x EL1809", SLAVES);
+  BENCH_REPORT(name, old_ns, new_ns);
+
+  BENCH_RUN(old_ns, ITERATIONS, , legacy_write(out); BENCH_KEEP(pd));
+  BENCH_RUN(new_ns, ITERATIONS, , grouped_write(out); BENCH_KEEP(pd));
+  snprintf(name, sizeof(name), "write %d x EL2809", SLAVES);
+  BENCH_REPORT(name, old_ns, new_ns);
+
+  return 0;
+}
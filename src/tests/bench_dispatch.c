@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/lcec.h"
+#include "bench.h"
+
+// Compares the per-slave linked-list walk that lcec_read_master() and
+// lcec_write_master() used to do every cycle against the per-Sync-Unit
+// dispatch tables.  Slaves are split between a `fast` Sync Unit that is
+// exchanged every cycle and a `slow` one with divider 4 that is idle on
+// the measured cycle, as on a typical mixed servo/IO bus.  Between
+// iterations the cache is flushed, which is what the servo thread sees
+// after motion and the rest of the HAL functs ran.
+
+#define ITERATIONS  2000
+#define FLUSH_BYTES (8 * 1024 * 1024)
+#define PD_BYTES    4096
+
+typedef struct {
+  unsigned int off;
+  hal_u32_t value;
+} bench_hal_data_t;
+
+static char *flush_buf;
+
+static void flush_cache(void) {
+  for (int i = 0; i < FLUSH_BYTES; i += 64) {
+    flush_buf[i]++;
+  }
+}
+
+static void bench_read(lcec_slave_t *slave, long period) {
+  bench_hal_data_t *hal_data = (bench_hal_data_t *)slave->hal_data;
+  hal_data->value = EC_READ_U8(&slave->sync_unit->process_data[hal_data->off]);
+}
+
+static void bench_write(lcec_slave_t *slave, long period) {
+  bench_hal_data_t *hal_data = (bench_hal_data_t *)slave->hal_data;
+  EC_WRITE_U8(&slave->sync_unit->process_data[hal_data->off], hal_data->value);
+}
+
+// The cyclic slave loops as they were before dispatch tables, which
+// also pointed the master's process data at each slave's Sync Unit.
+static uint8_t *volatile legacy_process_data;
+static volatile int legacy_process_data_len;
+
+static void legacy_read(lcec_master_t *master) {
+  lcec_slave_t *slave;
+
+  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+    if (slave->sync_unit->process && slave->proc_read != NULL) {
+      legacy_process_data = slave->sync_unit->process_data;
+      legacy_process_data_len = slave->sync_unit->process_data_len;
+      slave->proc_read(slave, slave->sync_unit->cycle_time);
+    }
+  }
+}
+
+static void legacy_write(lcec_master_t *master) {
+  lcec_slave_t *slave;
+
+  for (slave = master->first_slave; slave != NULL; slave = slave->next) {
+    if (slave->sync_unit->write && slave->proc_write != NULL) {
+      legacy_process_data = slave->sync_unit->process_data;
+      legacy_process_data_len = slave->sync_unit->process_data_len;
+      slave->proc_write(slave, slave->sync_unit->cycle_time);
+    }
+  }
+}
+
+static void dispatch_read(lcec_master_t *master) {
+  lcec_sync_unit_t *sync_unit;
+
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->process) {
+      lcec_sync_unit_read(master, sync_unit);
+    }
+  }
+}
+
+static void dispatch_write(lcec_master_t *master) {
+  lcec_sync_unit_t *sync_unit;
+
+  for (sync_unit = master->first_sync_unit; sync_unit != NULL; sync_unit = sync_unit->next) {
+    if (sync_unit->write) {
+      lcec_sync_unit_write(master, sync_unit);
+    }
+  }
+}
+
+static lcec_sync_unit_t *new_sync_unit(lcec_master_t *master, const char *name, unsigned int divider, int active) {
+  lcec_sync_unit_t *sync_unit = LCEC_ALLOCATE(lcec_sync_unit_t);
+
+  snprintf(sync_unit->name, sizeof(sync_unit->name), "%s", name);
+  sync_unit->cycle_divider = divider;
+  sync_unit->cycle_time = 250000 * divider;
+  sync_unit->process_data = LCEC_ALLOCATE_ARRAY(uint8_t, PD_BYTES);
+  sync_unit->process_data_len = PD_BYTES;
+  sync_unit->process = active;
+  sync_unit->write = active;
+  LCEC_LIST_APPEND(master->first_sync_unit, master->last_sync_unit, sync_unit);
+  return sync_unit;
+}
+
+static lcec_master_t *new_master(int slave_count) {
+  lcec_master_t *master = LCEC_ALLOCATE(lcec_master_t);
+  lcec_sync_unit_t *fast = new_sync_unit(master, "fast", 1, 1);
+  lcec_sync_unit_t *slow = new_sync_unit(master, "slow", 4, 0);
+
+  for (int i = 0; i < slave_count; i++) {
+    lcec_slave_t *slave = LCEC_ALLOCATE(lcec_slave_t);
+    bench_hal_data_t *hal_data = LCEC_ALLOCATE(bench_hal_data_t);
+
+    // Real slaves carry state pins, configs and SDO data between
+    // their structs; spread them out the same way.
+    LCEC_ALLOCATE_STRING(512);
+
+    slave->master = master;
+    slave->index = i;
+    slave->sync_unit = (i % 4 == 3) ? slow : fast;
+    slave->hal_data = hal_data;
+    slave->proc_read = bench_read;
+    slave->proc_write = bench_write;
+    hal_data->off = i % PD_BYTES;
+    LCEC_LIST_APPEND(master->first_slave, master->last_slave, slave);
+  }
+
+  lcec_sync_unit_build_dispatch(master, fast);
+  lcec_sync_unit_build_dispatch(master, slow);
+  return master;
+}
+
+int main(int argc, char **argv) {
+  static const int slave_counts[] = {10, 100, 500};
+  char name[64];
+
+  flush_buf = LCEC_ALLOCATE_STRING(FLUSH_BYTES);
+
+  for (size_t i = 0; i < sizeof(slave_counts) / sizeof(slave_counts[0]); i++) {
+    lcec_master_t *master = new_master(slave_counts[i]);
+    double old_ns, new_ns;
+
+    BENCH_RUN(old_ns, ITERATIONS, flush_cache(), legacy_read(master); legacy_write(master));
+    BENCH_RUN(new_ns, ITERATIONS, flush_cache(), dispatch_read(master); dispatch_write(master));
+
+    snprintf(name, sizeof(name), "read+write cycle, %d slaves", slave_counts[i]);
+    BENCH_REPORT(name, old_ns, new_ns);
+  }
+
+  return 0;
+}
@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/devices/lcec_generic.h"
+#include "../../src/lcec.h"
+#include "bench.h"
+#include "tests.h"
+
+// Compares the generic slave's bit-by-bit access to fields that aren't
+// byte-aligned 8/16/32 bit values with the access plans, for a bank of
+// packed 12- and 24-bit signed fields as found on analog terminals and
+// encoder interfaces.  Also compares bit-by-bit access to banks of
+// digital I/O with the word-wide bit arrays and with packed U32 pins.
+
+#define ITERATIONS 100000
+#define FIELDS     64
+#define PD_BYTES   256
+#define BANKS      8
+#define BANK_BITS  32
+
+// The per-field state and access code as it was before access plans.
+typedef struct {
+  hal_s32_t value;
+  uint8_t bitOffset;
+  uint8_t bitLength;
+  unsigned int pdo_os;
+  unsigned int pdo_bp;
+} legacy_pin_t;
+
+static hal_s32_t legacy_read_s32(uint8_t *pd, legacy_pin_t *hal_data) {
+  int i, offset;
+  hal_s32_t sval;
+
+  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
+    switch (hal_data->bitLength) {
+      case 8:
+        return EC_READ_S8(&pd[hal_data->pdo_os]);
+      case 16:
+        return EC_READ_S16(&pd[hal_data->pdo_os]);
+      case 32:
+        return EC_READ_S32(&pd[hal_data->pdo_os]);
+    }
+  }
+
+  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
+  for (sval = 0, i = 0; i < hal_data->bitLength; i++, offset++) {
+    if (EC_READ_BIT(&pd[offset >> 3], offset & 0x07)) {
+      sval |= (1 << i);
+    }
+  }
+
+  switch (hal_data->bitLength) {
+    case 8:
+      return (int8_t)sval;
+    case 16:
+      return (int16_t)sval;
+  }
+
+  return sval;
+}
+
+static void legacy_write_s32(uint8_t *pd, legacy_pin_t *hal_data, hal_s32_t sval) {
+  int i, offset;
+
+  hal_s32_t lim = ((1LL << hal_data->bitLength) >> 1) - 1LL;
+  if (sval > lim) sval = lim;
+  lim = ~lim;
+  if (sval < lim) sval = lim;
+
+  if (hal_data->pdo_bp == 0 && hal_data->bitOffset == 0) {
+    switch (hal_data->bitLength) {
+      case 8:
+        EC_WRITE_S8(&pd[hal_data->pdo_os], sval);
+        return;
+      case 16:
+        EC_WRITE_S16(&pd[hal_data->pdo_os], sval);
+        return;
+      case 32:
+        EC_WRITE_S32(&pd[hal_data->pdo_os], sval);
+        return;
+    }
+  }
+
+  offset = ((hal_data->pdo_os << 3) | (hal_data->pdo_bp & 0x07)) + hal_data->bitOffset;
+  for (i = 0; i < hal_data->bitLength; i++, offset++) {
+    EC_WRITE_BIT(&pd[offset >> 3], offset & 0x07, sval & 1);
+    sval >>= 1;
+  }
+}
+
+static void legacy_read(legacy_pin_t *pins, uint8_t *pd) {
+  for (int i = 0; i < FIELDS; i++) {
+    pins[i].value = legacy_read_s32(pd, &pins[i]);
+  }
+}
+
+static void legacy_write(legacy_pin_t *pins, uint8_t *pd) {
+  for (int i = 0; i < FIELDS; i++) {
+    legacy_write_s32(pd, &pins[i], pins[i].value);
+  }
+}
+
+// FIELDS fields of `bits` bits, packed back to back from bit 3.
+static legacy_pin_t *new_legacy(int bits) {
+  legacy_pin_t *pins = LCEC_ALLOCATE_ARRAY(legacy_pin_t, FIELDS);
+
+  for (int i = 0; i < FIELDS; i++) {
+    unsigned int pos = 3 + i * bits;
+    pins[i].pdo_os = pos >> 3;
+    pins[i].bitOffset = pos & 0x07;
+    pins[i].bitLength = bits;
+    pins[i].value = i * 37 - 1000;
+  }
+  return pins;
+}
+
+static lcec_slave_t *new_generic(int bits, hal_pin_dir_t dir, uint8_t *pd) {
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, FIELDS);
+  lcec_generic_data_t *hal_data;
+
+  slave->generic_pdo_entry_count = FIELDS;
+  slave->hal_data = conf;
+  for (int i = 0; i < FIELDS; i++) {
+    snprintf(conf[i].name, sizeof(conf[i].name), "field-%d", i);
+    conf[i].type = HAL_S32;
+    conf[i].dir = dir;
+    conf[i].bitOffset = (3 + i * bits) & 0x07;
+    conf[i].bitLength = bits;
+  }
+
+  lcec_generic_init(0, slave);
+  hal_data = (lcec_generic_data_t *)slave->hal_data;
+  for (int i = 0; i < FIELDS; i++) {
+    hal_data->pins[i].pdo_os = (3 + i * bits) >> 3;
+    *((hal_s32_t *)hal_data->pins[i].pin) = i * 37 - 1000;
+  }
+  lcec_generic_post_reg(slave);
+  return slave;
+}
+
+// The bit array access as it was before, one EC_READ_BIT/EC_WRITE_BIT per bit.
+static void legacy_read_bits(hal_bit_t *bits, uint8_t *pd) {
+  for (int offset = 3; offset < 3 + BANKS * BANK_BITS; offset++, bits++) {
+    *bits = EC_READ_BIT(&pd[offset >> 3], offset & 0x07);
+  }
+}
+
+static void legacy_write_bits(hal_bit_t *bits, uint8_t *pd) {
+  for (int offset = 3; offset < 3 + BANKS * BANK_BITS; offset++, bits++) {
+    EC_WRITE_BIT(&pd[offset >> 3], offset & 0x07, *bits);
+  }
+}
+
+// BANKS digital banks of BANK_BITS bits, back to back from bit 3, as
+// bit arrays or as packed U32 pins.
+static lcec_slave_t *new_bank(hal_type_t type, hal_pin_dir_t dir, uint8_t *pd) {
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, BANKS);
+  lcec_generic_data_t *hal_data;
+
+  slave->generic_pdo_entry_count = BANKS;
+  slave->hal_data = conf;
+  for (int i = 0; i < BANKS; i++) {
+    snprintf(conf[i].name, sizeof(conf[i].name), "bank-%d", i);
+    conf[i].type = type;
+    conf[i].subType = (type == HAL_U32) ? lcecPdoEntTypeBitPacked : lcecPdoEntTypeSimple;
+    conf[i].dir = dir;
+    conf[i].bitOffset = 3;
+    conf[i].bitLength = BANK_BITS;
+  }
+
+  lcec_generic_init(0, slave);
+  hal_data = (lcec_generic_data_t *)slave->hal_data;
+  for (int i = 0; i < BANKS; i++) {
+    hal_data->pins[i].pdo_os = i * BANK_BITS / 8;
+  }
+  lcec_generic_post_reg(slave);
+  return slave;
+}
+
+int main(int argc, char **argv) {
+  static const int widths[] = {12, 24};
+  uint8_t *pd = LCEC_ALLOCATE_ARRAY(uint8_t, PD_BYTES);
+  char name[64];
+
+  for (int i = 0; i < PD_BYTES; i++) {
+    pd[i] = i * 13;
+  }
+
+  for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); w++) {
+    legacy_pin_t *legacy = new_legacy(widths[w]);
+    lcec_slave_t *in = new_generic(widths[w], HAL_OUT, pd);
+    lcec_slave_t *out = new_generic(widths[w], HAL_IN, pd);
+    double old_ns, new_ns;
+
+    BENCH_RUN(old_ns, ITERATIONS, , legacy_read(legacy, pd); BENCH_KEEP(legacy[FIELDS - 1].value));
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_read(in, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "read %d x %d-bit fields", FIELDS, widths[w]);
+    BENCH_REPORT(name, old_ns, new_ns);
+
+    BENCH_RUN(old_ns, ITERATIONS, , legacy_write(legacy, pd); BENCH_KEEP(pd));
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_write(out, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "write %d x %d-bit fields", FIELDS, widths[w]);
+    BENCH_REPORT(name, old_ns, new_ns);
+  }
+
+  {
+    hal_bit_t *legacy = LCEC_ALLOCATE_ARRAY(hal_bit_t, BANKS * BANK_BITS);
+    lcec_slave_t *in = new_bank(HAL_BIT, HAL_OUT, pd);
+    lcec_slave_t *out = new_bank(HAL_BIT, HAL_IN, pd);
+    lcec_slave_t *packed_in = new_bank(HAL_U32, HAL_OUT, pd);
+    lcec_slave_t *packed_out = new_bank(HAL_U32, HAL_IN, pd);
+    double old_ns, new_ns;
+
+    BENCH_RUN(old_ns, ITERATIONS, , legacy_read_bits(legacy, pd); BENCH_KEEP(legacy[0]));
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_read(in, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "read %d x %d-bit bit arrays", BANKS, BANK_BITS);
+    BENCH_REPORT(name, old_ns, new_ns);
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_read(packed_in, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "read %d x %d-bit packed", BANKS, BANK_BITS);
+    BENCH_REPORT(name, old_ns, new_ns);
+
+    BENCH_RUN(old_ns, ITERATIONS, , legacy_write_bits(legacy, pd); BENCH_KEEP(pd));
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_write(out, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "write %d x %d-bit bit arrays", BANKS, BANK_BITS);
+    BENCH_REPORT(name, old_ns, new_ns);
+    BENCH_RUN(new_ns, ITERATIONS, , lcec_generic_write(packed_out, 0); BENCH_KEEP(pd));
+    snprintf(name, sizeof(name), "write %d x %d-bit packed", BANKS, BANK_BITS);
+    BENCH_REPORT(name, old_ns, new_ns);
+  }
+
+  return 0;
+}
@@ -0,0 +1,179 @@
+#include <math.h>
+#include <stdio.h>
+
+#include "../../src/devices/lcec_class_ain.h"
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+#define PD_BYTES 12
+
+static uint8_t pd[PD_BYTES];
+
+static lcec_slave_t *new_slave(void) {
+  memset(pd, 0, sizeof(pd));
+  return lcec_test_slave(pd, PD_BYTES);
+}
+
+// Places a channel the way an EL31xx maps it: a 16-bit status word at
+// `os`, with underrange in bit 0, overrange in bit 1, error in bit 6
+// and sync error in bit 13, followed by the 16-bit value.
+static void place(lcec_class_ain_channel_t *channel, unsigned int os) {
+  channel->udr_pdo_os = channel->ovr_pdo_os = channel->error_pdo_os = os;
+  channel->udr_pdo_bp = 0;
+  channel->ovr_pdo_bp = 1;
+  channel->error_pdo_bp = 6;
+  channel->sync_err_pdo_os = os + 1;
+  channel->sync_err_pdo_bp = 5;
+  channel->val_pdo_os = os + 2;
+}
+
+TESTFUNC(test_ain_read_all) {
+  TESTSETUP;
+  lcec_slave_t *slave = new_slave();
+  lcec_class_ain_channels_t *channels = lcec_ain_allocate_channels(4);
+  lcec_class_ain_options_t *opt = lcec_ain_options();
+  lcec_class_ain_options_t *temp = lcec_ain_options();
+
+  opt->has_sync = 1;
+  temp->is_temperature = 1;
+  temp->valueonly = 1;
+  temp->value_sidx = 0x11;
+  channels->channels[0] = lcec_ain_register_channel(slave, 0, 0x6000, opt);
+  channels->channels[2] = lcec_ain_register_channel(slave, 2, 0x6020, opt);
+  channels->channels[3] = lcec_ain_register_channel(slave, 3, 0x6030, temp);
+  channels->channels[3]->is_unsigned = 1;
+  place(channels->channels[0], 0);
+  place(channels->channels[2], 4);
+  channels->channels[3]->val_pdo_os = 10;
+  *(channels->channels[0]->scale) = 10.0;
+  *(channels->channels[0]->bias) = 1.0;
+
+  pd[0] = 0x42;  // overrange, error
+  pd[1] = 0x20;  // sync error
+  pd[2] = 0x00;  // -0x4000
+  pd[3] = 0xc0;
+  pd[4] = 0x01;  // underrange
+  pd[6] = 0xff;  // 0x7fff
+  pd[7] = 0x7f;
+  pd[10] = 0x10;  // 0xf010 unsigned
+  pd[11] = 0xf0;
+  lcec_ain_plan(slave, channels);
+  lcec_ain_read_all(slave, channels);
+  TESTINT(channels->batched, 1);
+  TESTINT(channels->batch_count, 3);
+  TESTINT(*(channels->channels[0]->raw_val), -0x4000);
+  TESTINT(fabs(*(channels->channels[0]->val) - (1.0 - 10.0 * 0x4000 / 0x7fff)) < 1e-9, 1);
+  TESTINT(*(channels->channels[0]->overrange), 1);
+  TESTINT(*(channels->channels[0]->underrange), 0);
+  TESTINT(*(channels->channels[0]->error), 1);
+  TESTINT(*(channels->channels[0]->sync_err), 1);
+  TESTINT(*(channels->channels[2]->raw_val), 0x7fff);
+  TESTINT(fabs(*(channels->channels[2]->val) - 1.0) < 1e-9, 1);
+  TESTINT(*(channels->channels[2]->overrange), 0);
+  TESTINT(*(channels->channels[2]->underrange), 1);
+  TESTINT(*(channels->channels[2]->sync_err), 0);
+  TESTINT(*(channels->channels[3]->raw_val), 0xf010);
+  TESTINT(fabs(*(channels->channels[3]->val) - 0.1 * 0xf010) < 1e-9, 1);
+
+  // a changed scale is picked up on the next cycle
+  *(channels->channels[2]->scale) = -2.0;
+  lcec_ain_read_all(slave, channels);
+  TESTINT(fabs(*(channels->channels[2]->val) + 2.0) < 1e-9, 1);
+
+  TESTRESULTS;
+}
+
+// Registers a channel with 5 samples per cycle at `offsets`.
+static lcec_class_ain_channel_t *oversampled(lcec_slave_t *slave, int id, int filter, const unsigned int *offsets) {
+  lcec_class_ain_options_t *opt = lcec_ain_options();
+  lcec_class_ain_channel_t *channel;
+
+  opt->valueonly = 1;
+  opt->oversampling = 5;
+  opt->oversampling_filter = filter;
+  opt->oversampling_pins = (id == 0);
+  channel = lcec_ain_register_channel(slave, id, 0x6000, opt);
+  for (int k = 0; k < 5; k++) {
+    channel->oversampling->sample_os[k] = offsets[k];
+  }
+  return channel;
+}
+
+TESTFUNC(test_ain_oversampling) {
+  TESTSETUP;
+  lcec_slave_t *slave = new_slave();
+  lcec_class_ain_channels_t *channels = lcec_ain_allocate_channels(5);
+  static const unsigned int forward[5] = {0, 2, 4, 6, 8}, backward[5] = {8, 6, 4, 2, 0};
+  static const int16_t samples[5] = {100, -200, 300, 50, 0};
+  lcec_class_ain_oversampling_t *fir;
+
+  channels->channels[0] = oversampled(slave, 0, LCEC_AIN_FILTER_MEAN, forward);
+  channels->channels[1] = oversampled(slave, 1, LCEC_AIN_FILTER_MIN, backward);
+  channels->channels[2] = oversampled(slave, 2, LCEC_AIN_FILTER_MAX, forward);
+  channels->channels[3] = oversampled(slave, 3, LCEC_AIN_FILTER_FIR, forward);
+  channels->channels[4] = oversampled(slave, 4, LCEC_AIN_FILTER_IIR, forward);
+  channels->channels[4]->oversampling->alpha = 0.5;
+  for (int k = 0; k < 5; k++) {
+    EC_WRITE_S16(&pd[2 * k], samples[k]);
+  }
+
+  // the taps of a 5-sample triangle are 1 2 3 2 1 / 9
+  fir = channels->channels[3]->oversampling;
+  TESTINT(fir->padded, LCEC_AIN_LANES);
+  TESTINT(fir->weights[0] + fir->weights[1] + fir->weights[2] + fir->weights[3] + fir->weights[4], 1 << 15);
+  TESTINT(fir->weights[5], 0);
+
+  lcec_ain_plan(slave, channels);
+  lcec_ain_read_all(slave, channels);
+  TESTINT(channels->batched, 1);
+  TESTINT(channels->channels[0]->oversampling->contiguous, 1);
+  TESTINT(channels->channels[1]->oversampling->contiguous, 0);
+  TESTINT(*(channels->channels[0]->raw_val), 50);
+  TESTINT(fabs(*(channels->channels[0]->val) - 50.0 / 0x7fff) < 1e-9, 1);
+  TESTINT(*(channels->channels[0]->oversampling->sample_pins[1]), -200);
+  TESTINT(channels->channels[1]->oversampling->sample_pins == NULL, 1);
+  TESTINT(*(channels->channels[1]->raw_val), -200);
+  TESTINT(*(channels->channels[2]->raw_val), 300);
+  TESTINT(*(channels->channels[3]->raw_val), 78);
+  TESTINT(fabs(*(channels->channels[3]->val) - 700.0 / 9 / 0x7fff) < 1e-6, 1);
+  // the IIR starts from the first sample: 100 -50 125 87.5 43.75
+  TESTINT(*(channels->channels[4]->raw_val), 44);
+
+  // and carries its state into the next cycle
+  memset(pd, 0, sizeof(pd));
+  lcec_ain_read(slave, channels->channels[4]);
+  TESTINT(fabs(channels->channels[4]->oversampling->state - 43.75 / 32) < 1e-9, 1);
+  lcec_ain_read(slave, channels->channels[0]);
+  TESTINT(*(channels->channels[0]->raw_val), 0);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_ain_scattered_status) {
+  TESTSETUP;
+  lcec_slave_t *slave = new_slave();
+  lcec_class_ain_channels_t *channels = lcec_ain_allocate_channels(2);
+  static const unsigned int forward[5] = {2, 4, 6, 8, 10};
+
+  // status bits further apart than one word fall back to lcec_ain_read(),
+  // which still decodes contiguous samples in one pass
+  channels->channels[0] = lcec_ain_register_channel(slave, 0, 0x6000, NULL);
+  channels->channels[1] = oversampled(slave, 1, LCEC_AIN_FILTER_MEAN, forward);
+  place(channels->channels[0], 0);
+  channels->channels[0]->error_pdo_os = 9;
+  pd[9] = 0x40;
+  pd[2] = 0x34;
+  pd[3] = 0x12;
+  lcec_ain_plan(slave, channels);
+  lcec_ain_read_all(slave, channels);
+  TESTINT(channels->batched, 0);
+  TESTINT(channels->channels[1]->oversampling->contiguous, 1);
+  TESTINT(*(channels->channels[0]->raw_val), 0x1234);
+  TESTINT(*(channels->channels[0]->error), 1);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
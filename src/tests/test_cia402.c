@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 
 #include "../../src/devices/lcec_class_cia402.h"
 #include "../../src/lcec.h"
@@ -193,4 +194,69 @@ TESTFUNC(test_cia402_modparam_ratio) {
   TESTRESULTS;
 }
 
+TESTFUNC(test_cia402_pdo_ops) {
+  TESTSETUP;
+  static uint8_t pd[24];
+  lcec_slave_t *slave = lcec_test_slave(pd, sizeof(pd));
+  lcec_class_cia402_channel_options_t *opt = lcec_cia402_channel_options();
+  lcec_class_cia402_channel_t *data;
+
+  opt->enable_pp = 1;
+  opt->enable_actual_torque = 1;
+  opt->enable_target_torque = 1;
+  opt->enable_error_code = 1;
+  opt->digital_in_channels = opt->digital_out_channels = 0;
+
+  data = lcec_cia402_register_channel(slave, 0x6000, opt);
+  TESTNOTNULL(data);
+
+  // offsets as lcec_pdo_init() would fill them in once the domain is
+  // registered; bytes 20-23 aren't mapped
+  data->controlword_os = 0;
+  data->statusword_os = 2;
+  data->opmode_os = 4;
+  data->opmode_display_os = 5;
+  data->actual_position_os = 6;
+  data->target_position_os = 10;
+  data->actual_torque_os = 14;
+  data->target_torque_os = 16;
+  data->error_code_os = 18;
+  lcec_cia402_plan(slave, data);
+  // controlword, opmode, target-position, target-torque
+  TESTINT(data->write_op_count, 4);
+  // statusword, opmode-display, actual-position, actual-torque, error-code
+  TESTINT(data->read_op_count, 5);
+  TESTINT(data->sdo_op_count, 0);
+  memset(pd, 0xaa, sizeof(pd));
+
+  EC_WRITE_U16(&pd[2], 0x8237);
+  EC_WRITE_S8(&pd[5], -3);
+  EC_WRITE_S32(&pd[6], -123456789);
+  EC_WRITE_S16(&pd[14], -1000);
+  EC_WRITE_U16(&pd[18], 0xff01);
+  lcec_cia402_read(slave, data);
+  TESTINT(*(data->statusword), 0x8237);
+  TESTINT(*(data->opmode_display), -3);
+  TESTINT(*(data->actual_position), -123456789);
+  TESTINT(*(data->actual_torque), -1000);
+  TESTINT(*(data->error_code), 0xff01);
+
+  *(data->controlword) = 0x1f;
+  *(data->opmode) = -1;
+  *(data->target_position) = 987654321;
+  *(data->target_torque) = -2;
+  lcec_cia402_write(slave, data);
+  TESTINT(EC_READ_U16(&pd[0]), 0x1f);
+  TESTINT(EC_READ_S8(&pd[4]), -1);
+  TESTINT(EC_READ_S32(&pd[10]), 987654321);
+  TESTINT(EC_READ_S16(&pd[16]), -2);
+  // neighbouring inputs and unmapped bytes are left alone
+  TESTINT(EC_READ_S8(&pd[5]), -3);
+  TESTINT(EC_READ_S16(&pd[14]), -1000);
+  TESTINT(EC_READ_U16(&pd[18]), 0xff01);
+  TESTINT(EC_READ_U32(&pd[20]), 0xaaaaaaaa);
+
+  TESTRESULTS;
+}
+
 TESTMAIN
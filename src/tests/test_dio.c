@@ -0,0 +1,111 @@
+#include <stdio.h>
+
+#include "../../src/devices/lcec_class_din.h"
+#include "../../src/devices/lcec_class_dout.h"
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+#define PD_BYTES 12
+
+static uint8_t pd[PD_BYTES];
+
+static lcec_slave_t *new_slave(void) {
+  memset(pd, 0, sizeof(pd));
+  return lcec_test_slave(pd, PD_BYTES);
+}
+
+TESTFUNC(test_din_groups) {
+  TESTSETUP;
+  lcec_slave_t *slave = new_slave();
+  lcec_class_din_channels_t *channels = lcec_din_allocate_channels(20);
+
+  // 16 channels in bytes 2-3, one unused, 2 packed ones in a U32 at
+  // byte 8, and one back at byte 0
+  for (int i = 0; i < 16; i++) {
+    channels->channels[i] = lcec_din_register_channel(slave, i, 0x6000 + (i << 4), 1);
+    channels->channels[i]->pdo_os = 2 + i / 8;
+    channels->channels[i]->pdo_bp = i % 8;
+  }
+  channels->channels[17] = lcec_din_register_channel_packed(slave, 0x60fd, 0, 3, "limit");
+  channels->channels[18] = lcec_din_register_channel_packed(slave, 0x60fd, 0, 17, "home");
+  channels->channels[17]->pdo_os = channels->channels[18]->pdo_os = 8;
+  channels->channels[19] = lcec_din_register_channel(slave, 19, 0x6100, 1);
+  channels->channels[19]->pdo_os = 0;
+  channels->channels[19]->pdo_bp = 5;
+
+  pd[0] = 0x20;
+  pd[2] = 0x81;
+  pd[3] = 0x40;
+  pd[8] = 0x08;
+  lcec_din_plan(slave, channels);
+  lcec_din_read_all(slave, channels);
+  // byte 8 is within the first group's word, byte 10 isn't
+  TESTINT(channels->group_count, 3);
+  TESTINT(channels->groups[0].count, 17);
+  TESTINT(channels->groups[1].count, 1);
+  TESTINT(*(channels->channels[0]->in), 1);
+  TESTINT(*(channels->channels[0]->in_not), 0);
+  TESTINT(*(channels->channels[1]->in), 0);
+  TESTINT(*(channels->channels[1]->in_not), 1);
+  TESTINT(*(channels->channels[7]->in), 1);
+  TESTINT(*(channels->channels[14]->in), 1);
+  TESTINT(*(channels->channels[15]->in), 0);
+  TESTINT(*(channels->channels[17]->in), 1);
+  TESTINT(*(channels->channels[18]->in), 0);
+  TESTINT(*(channels->channels[19]->in), 1);
+
+  // the U32 group ends within 8 bytes of the end of the process data
+  pd[10] = 0x02;
+  lcec_din_read_all(slave, channels);
+  TESTINT(*(channels->channels[18]->in), 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_dout_groups) {
+  TESTSETUP;
+  lcec_slave_t *slave = new_slave();
+  lcec_class_dout_channels_t *channels = lcec_dout_allocate_channels(11);
+
+  // 8 channels in byte 1, and 2 packed ones plus a plain one near the end
+  for (int i = 0; i < 8; i++) {
+    channels->channels[i] = lcec_dout_register_channel(slave, i, 0x7000 + (i << 4), 1);
+    channels->channels[i]->pdo_os = 1;
+    channels->channels[i]->pdo_bp = i;
+    *(channels->channels[i]->out) = (i & 1);
+  }
+  channels->channels[8] = lcec_dout_register_channel_packed(slave, 0x60fe, 1, 0, "brake");
+  channels->channels[9] = lcec_dout_register_channel_packed(slave, 0x60fe, 1, 16, "dout-0");
+  channels->channels[8]->pdo_os = channels->channels[9]->pdo_os = 8;
+  channels->channels[10] = lcec_dout_register_channel(slave, 10, 0x7100, 1);
+  channels->channels[10]->pdo_os = 11;
+  channels->channels[10]->pdo_bp = 7;
+  *(channels->channels[8]->out) = 1;
+  *(channels->channels[9]->out) = 1;
+  channels->channels[0]->invert = 1;
+
+  // the bits around the channels are left alone
+  memset(pd, 0x5a, sizeof(pd));
+  lcec_dout_plan(slave, channels);
+  lcec_dout_write_all(slave, channels);
+  TESTINT(channels->group_count, 2);
+  TESTINT(pd[0], 0x5a);
+  TESTINT(pd[1], 0xab);
+  TESTINT(pd[2], 0x5a);
+  TESTINT(pd[8], 0x5b);
+  TESTINT(pd[9], 0x5a);
+  TESTINT(pd[10], 0x5b);
+  TESTINT(pd[11], 0x5a);
+
+  *(channels->channels[9]->out) = 0;
+  *(channels->channels[10]->out) = 1;
+  lcec_dout_write_all(slave, channels);
+  TESTINT(pd[10], 0x5a);
+  TESTINT(pd[11], 0xda);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
@@ -0,0 +1,230 @@
+#include <stdio.h>
+
+#include "../../src/devices/lcec_generic.h"
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+#define PD_BYTES 16
+
+static uint8_t pd[PD_BYTES];
+
+static lcec_generic_pin_t *add_pin(lcec_generic_pin_t *conf, const char *name, hal_type_t type, hal_pin_dir_t dir, uint8_t bit_offset,
+    uint8_t bit_length) {
+  strcpy(conf->name, name);
+  conf->type = type;
+  conf->subType = lcecPdoEntTypeSimple;
+  conf->dir = dir;
+  conf->bitOffset = bit_offset;
+  conf->bitLength = bit_length;
+  conf->floatScale = 1.0;
+  return conf + 1;
+}
+
+// Builds a generic slave the way lcec_parse_config() and
+// rtapi_app_main() do, and places PDO entry `i` at process data byte
+// offsets[i], as ecrt_domain_reg_pdo_entry_list() would.
+static lcec_slave_t *new_slave(lcec_generic_pin_t *conf, int count, const unsigned int *offsets) {
+  lcec_slave_t *slave = lcec_test_slave(pd, PD_BYTES);
+
+  slave->generic_pdo_entry_count = count;
+  slave->hal_data = conf;
+  memset(pd, 0, sizeof(pd));
+
+  if (lcec_generic_init(0, slave) != 0) {
+    return NULL;
+  }
+  for (int i = 0; i < slave->regs->current; i++) {
+    *(slave->regs->pdo_entry_regs[i].offset) = offsets[i];
+  }
+  slave->proc_post_reg(slave);
+  return slave;
+}
+
+TESTFUNC(test_generic_layout) {
+  TESTSETUP;
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, 4);
+  lcec_generic_pin_t *c = conf;
+  static const unsigned int offsets[] = {0, 2, 4};
+  lcec_generic_data_t *hal_data;
+  lcec_slave_t *slave;
+
+  c = add_pin(c, "out", HAL_U32, HAL_IN, 0, 16);
+  c = add_pin(c, "in", HAL_U32, HAL_OUT, 0, 16);
+  c = add_pin(c, "too-long", HAL_S32, HAL_OUT, 0, 64);
+  c = add_pin(c, "bits", HAL_BIT, HAL_OUT, 0, 4);
+  slave = new_slave(conf, 4, offsets);
+  TESTINT(slave != NULL, 1);
+  hal_data = (lcec_generic_data_t *)slave->hal_data;
+
+  // inputs first, invalid pins dropped
+  TESTINT(hal_data->read_count, 2);
+  TESTINT(hal_data->write_count, 1);
+  TESTINT(slave->regs->current, 3);
+  TESTINT(hal_data->pins[1].bitCount, 4);
+  TESTINT(sizeof(lcec_generic_hal_pin_t) <= 80, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_generic_read_write) {
+  TESTSETUP;
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, 6);
+  lcec_generic_pin_t *c = conf;
+  static const unsigned int offsets[] = {0, 2, 2, 6, 8, 10};
+  lcec_generic_hal_pin_t *pins;
+  lcec_slave_t *slave;
+  hal_bit_t **bits;
+
+  c = add_pin(c, "u16", HAL_U32, HAL_OUT, 0, 16);
+  c = add_pin(c, "s12", HAL_S32, HAL_OUT, 4, 12);
+  c = add_pin(c, "bits", HAL_BIT, HAL_OUT, 0, 4);
+  c = add_pin(c, "float", HAL_FLOAT, HAL_OUT, 0, 16);
+  conf[3].subType = lcecPdoEntTypeFloatSigned;
+  conf[3].floatScale = 0.5;
+  c = add_pin(c, "s12-out", HAL_S32, HAL_IN, 4, 12);
+  c = add_pin(c, "bit-out", HAL_BIT, HAL_IN, 3, 1);
+  slave = new_slave(conf, 6, offsets);
+  TESTINT(slave != NULL, 1);
+  pins = ((lcec_generic_data_t *)slave->hal_data)->pins;
+
+  pd[0] = 0x34;
+  pd[1] = 0x12;
+  pd[2] = 0x05;  // bits 0-3: 0b0101; s12 at bit 4: 0x800
+  pd[3] = 0x80;
+  pd[6] = 0xf6;  // -10
+  pd[7] = 0xff;
+  lcec_generic_read(slave, 0);
+  TESTINT(*(hal_u32_t *)pins[0].pin, 0x1234);
+  TESTINT(*(hal_s32_t *)pins[1].pin, -2048);
+  bits = (hal_bit_t **)pins[2].pin;
+  TESTINT(*(bits[0]), 1);
+  TESTINT(*(bits[1]), 0);
+  TESTINT(*(bits[2]), 1);
+  TESTINT(*(bits[3]), 0);
+  TESTINT((int)*(hal_float_t *)pins[3].pin, -5);
+
+  // s12 is clamped, the bits around the fields are left alone
+  pd[8] = 0x0f;
+  *(hal_s32_t *)pins[4].pin = 5000;
+  *(hal_bit_t *)pins[5].pin = 1;
+  lcec_generic_write(slave, 0);
+  TESTINT(pd[8], 0xff);
+  TESTINT(pd[9], 0x7f);
+  TESTINT(pd[10], 0x08);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_generic_fields) {
+  TESTSETUP;
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, 6);
+  lcec_generic_pin_t *c = conf;
+  // tail fields end within 8 bytes of the end of the process data
+  static const unsigned int offsets[] = {1, 4, PD_BYTES - 3, 1, 4, PD_BYTES - 3};
+  lcec_generic_hal_pin_t *pins;
+  lcec_slave_t *slave;
+
+  c = add_pin(c, "u24", HAL_U32, HAL_OUT, 3, 24);
+  c = add_pin(c, "s24", HAL_S32, HAL_OUT, 3, 24);
+  c = add_pin(c, "tail", HAL_S32, HAL_OUT, 5, 12);
+  c = add_pin(c, "u24-out", HAL_U32, HAL_IN, 3, 24);
+  c = add_pin(c, "s24-out", HAL_S32, HAL_IN, 3, 24);
+  c = add_pin(c, "tail-out", HAL_U32, HAL_IN, 5, 12);
+  slave = new_slave(conf, 6, offsets);
+  TESTINT(slave != NULL, 1);
+  pins = ((lcec_generic_data_t *)slave->hal_data)->pins;
+
+  // 0xabcdef at bit 3 of byte 1, -0x800000 at bit 3 of byte 4, -1 at bit 5 of the tail
+  pd[1] = 0x7f;
+  pd[2] = 0x6f;
+  pd[3] = 0x5e;
+  pd[4] = 0x05;
+  pd[7] = 0x04;
+  pd[PD_BYTES - 3] = 0xe0;
+  pd[PD_BYTES - 2] = 0xff;
+  pd[PD_BYTES - 1] = 0x01;
+  lcec_generic_read(slave, 0);
+  TESTINT(pins[0].wide, 1);
+  TESTINT(*(hal_u32_t *)pins[0].pin, 0xabcdef);
+  TESTINT(*(hal_s32_t *)pins[1].pin, -0x800000);
+  TESTINT(pins[2].wide, 0);
+  TESTINT(*(hal_s32_t *)pins[2].pin, -1);
+
+  // writes clamp and keep the neighbouring bits
+  memset(pd, 0xff, sizeof(pd));
+  memset(&pd[PD_BYTES - 3], 0, 3);
+  *(hal_u32_t *)pins[3].pin = 0x123456;
+  *(hal_s32_t *)pins[4].pin = -10000000;
+  *(hal_u32_t *)pins[5].pin = 5000;
+  lcec_generic_write(slave, 0);
+  TESTINT(pd[0], 0xff);
+  TESTINT(pd[1], 0xb7);
+  TESTINT(pd[2], 0xa2);
+  TESTINT(pd[3], 0x91);
+  TESTINT(pd[4], 0x00);
+  TESTINT(pd[5], 0x00);
+  TESTINT(pd[6], 0x00);
+  TESTINT(pd[7], 0xfc);
+  TESTINT(pd[8], 0xff);
+  TESTINT(pd[PD_BYTES - 3], 0xe0);
+  TESTINT(pd[PD_BYTES - 2], 0xff);
+  TESTINT(pd[PD_BYTES - 1], 0x01);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_generic_bit_banks) {
+  TESTSETUP;
+  lcec_generic_pin_t *conf = LCEC_ALLOCATE_ARRAY(lcec_generic_pin_t, 5);
+  lcec_generic_pin_t *c = conf;
+  static const unsigned int offsets[] = {0, 4, 8, 10, PD_BYTES - 1};
+  lcec_generic_hal_pin_t *pins;
+  lcec_slave_t *slave;
+  hal_bit_t **bits;
+
+  c = add_pin(c, "bits", HAL_BIT, HAL_OUT, 3, 16);
+  c = add_pin(c, "packed", HAL_U32, HAL_OUT, 4, 12);
+  c = add_pin(c, "bits-out", HAL_BIT, HAL_IN, 2, 12);
+  c = add_pin(c, "packed-out", HAL_U32, HAL_IN, 4, 12);
+  c = add_pin(c, "packed8-out", HAL_U32, HAL_IN, 0, 8);
+  conf[1].subType = lcecPdoEntTypeBitPacked;
+  conf[3].subType = lcecPdoEntTypeBitPacked;
+  conf[4].subType = lcecPdoEntTypeBitPacked;
+  slave = new_slave(conf, 5, offsets);
+  TESTINT(slave != NULL, 1);
+  pins = ((lcec_generic_data_t *)slave->hal_data)->pins;
+
+  // 0xa5c3 at bit 3 of byte 0, 0xabc at bit 4 of byte 4
+  pd[0] = 0x18;
+  pd[1] = 0x2e;
+  pd[2] = 0x05;
+  pd[4] = 0xcf;
+  pd[5] = 0xab;
+  lcec_generic_read(slave, 0);
+  bits = (hal_bit_t **)pins[0].pin;
+  for (int j = 0; j < 16; j++) {
+    TESTINT(*(bits[j]), ((0xa5c3 >> j) & 1));
+  }
+  TESTINT(*(hal_u32_t *)pins[1].pin, 0xabc);
+
+  // packed values drop the bits that don't fit, and the bits around the fields are left alone
+  memset(pd, 0xff, sizeof(pd));
+  bits = (hal_bit_t **)pins[2].pin;
+  for (int j = 0; j < 12; j++) {
+    *(bits[j]) = !(j & 1);
+  }
+  *(hal_u32_t *)pins[3].pin = 0xfffff123;
+  *(hal_u32_t *)pins[4].pin = 0x3a5;
+  lcec_generic_write(slave, 0);
+  TESTINT(pd[8], 0x57);
+  TESTINT(pd[9], 0xd5);
+  TESTINT(pd[10], 0x3f);
+  TESTINT(pd[11], 0x12);
+  TESTINT(pd[PD_BYTES - 1], 0xa5);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+// Servo thread PLL simulator.  Runs lcec_pll_update() the way
+// lcec_send_master() does, against a DC reference clock that drifts
+// against the thread's clock, with random wake-up latency and with
+// each cycle's correction applied to the next period.
+
+#define PERIOD   1000000
+#define APP_BASE 1700000000000000000ULL
+#define T0       1000000000LL
+
+typedef struct {
+  int sync_to_ref_clock;
+  uint32_t controller;
+  double drift_ppm;     // DC reference clock rate error
+  int32_t jitter;       // max wake-up latency (ns), uniform
+  int load_cycle;       // cycle from which the max latency is load_jitter instead
+  int32_t load_jitter;
+  int outlier_cycle;    // cycle with one extra latency of outlier ns
+  int32_t outlier;
+  int retarget;         // phase-retarget
+  int recalibrate_cycle;  // cycle at which phase-recalibrate is set, 0 for never
+  int32_t dc_offset;    // M2R: DC time minus app time at activation (ns)
+  int32_t start_phase;  // R2M: first wake-up relative to activation (ns)
+  int step_cycle;       // M2R: cycle at which the DC time jumps by dc_step
+  int32_t dc_step;
+  int cycles;
+} sim_config_t;
+
+typedef struct {
+  double lock_time;        // s, 0 if never phased
+  int32_t p50, p99, p999;  // |phase error| over the second half of the run (ns)
+  uint32_t resets;
+  int phased;  // phased at the end of the run
+  int32_t target, jitter_p99;  // R2M app_phase target and p99 jitter at the end of the run
+} sim_result_t;
+
+static uint32_t rng_state;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+static int cmp_int32(const void *a, const void *b) {
+  int32_t x = *(const int32_t *)a, y = *(const int32_t *)b;
+  return (x > y) - (x < y);
+}
+
+static void sim_run(const sim_config_t *cfg, sim_result_t *res) {
+  lcec_pll_t pll = {0};
+  int32_t *errs = calloc(cfg->cycles, sizeof(int32_t));
+  int n = 0;
+  long long wake = T0 + cfg->start_phase, send_last = T0;
+  uint64_t dc_ref = 0;
+
+  rng_state = 12345;
+  pll.period = PERIOD;
+  pll.sync_to_ref_clock = cfg->sync_to_ref_clock;
+  pll.step = PERIOD / 1000;
+  pll.max_err = PERIOD;
+  pll.controller = cfg->controller;
+  pll.kp = 0.05;
+  pll.ki = 0.0005;
+  pll.max_out = PERIOD / 200;
+  pll.retarget = cfg->retarget;
+  lcec_pll_start(&pll, APP_BASE, T0);
+
+  for (int k = 0; k < cfg->cycles; k++) {
+    long long ref = wake;
+    int32_t jitter = (cfg->load_cycle && k >= cfg->load_cycle) ? cfg->load_jitter : cfg->jitter;
+    long long now = wake + (jitter ? rng() % jitter : 0) + (k == cfg->outlier_cycle ? cfg->outlier : 0);
+    uint64_t app_time;
+    uint32_t dc_time = 0;
+    int dc_time_valid = 0;
+
+    if (cfg->sync_to_ref_clock) {
+      // M2R: app time counts nominal periods, the DC clock runs on its own.
+      // The DC time read back was latched by the previous frame.
+      long long elapsed = send_last - T0;
+      app_time = APP_BASE + dc_ref + (now - ref);
+      dc_ref += PERIOD;
+      dc_time = (uint32_t)(APP_BASE + elapsed + (long long)(elapsed * cfg->drift_ppm * 1e-6) + cfg->dc_offset +
+                           (k >= cfg->step_cycle ? cfg->dc_step : 0));
+      dc_time_valid = (k > 0);
+    } else {
+      // R2M, free running: app time is the thread's clock
+      app_time = APP_BASE + (now - T0);
+    }
+
+    if (cfg->recalibrate_cycle && k == cfg->recalibrate_cycle) {
+      pll.recalibrate = 1;
+    }
+    int32_t corr = lcec_pll_update(&pll, app_time, dc_time, dc_time_valid, now);
+    if (pll.resync != 0) {
+      dc_ref -= pll.resync;
+    }
+
+    if (k >= cfg->cycles / 2) {
+      int32_t err = cfg->sync_to_ref_clock ? pll.err : pll.app_phase - pll.phase_target;
+      if (err > PERIOD / 2) {
+        err -= PERIOD;
+      }
+      errs[n++] = abs(err);
+    }
+    send_last = now;
+    wake += PERIOD + corr;
+  }
+
+  qsort(errs, n, sizeof(int32_t), cmp_int32);
+  res->p50 = errs[n / 2];
+  res->p99 = errs[n * 99 / 100];
+  res->p999 = errs[n * 999 / 1000];
+  res->lock_time = pll.lock_time;
+  res->resets = pll.reset_cnt;
+  res->phased = pll.phased;
+  res->target = pll.phase_target;
+  res->jitter_p99 = pll.jitter_p99;
+  free(errs);
+
+  fprintf(stderr, "  %s %s: lock %.3f s, |err| p50 %d p99 %d p99.9 %d ns, %u resyncs\n", cfg->sync_to_ref_clock ? "M2R" : "R2M",
+      cfg->controller == LCEC_PLL_PI ? "PI" : "bang-bang", res->lock_time, res->p50, res->p99, res->p999, res->resets);
+}
+
+TESTFUNC(test_pll_m2r_drift) {
+  TESTSETUP;
+  sim_config_t cfg = {.sync_to_ref_clock = 1, .drift_ppm = 50, .jitter = 2000, .dc_offset = 20000, .cycles = 20000};
+  sim_result_t bb, pi;
+
+  sim_run(&cfg, &bb);
+  TESTINT(bb.lock_time > 0, 1);
+  TESTINT(bb.phased, 1);
+  TESTINT(bb.resets, 0);
+  TESTINT(bb.p99 < 10000, 1);
+
+  cfg.controller = LCEC_PLL_PI;
+  sim_run(&cfg, &pi);
+  TESTINT(pi.lock_time > 0, 1);
+  TESTINT(pi.phased, 1);
+  TESTINT(pi.resets, 0);
+  TESTINT(pi.p99 < 10000, 1);
+  // PI doesn't dither by a full pll-step around the lock point
+  TESTINT(pi.p99 < bb.p99, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_pll_m2r_resync) {
+  TESTSETUP;
+  sim_config_t cfg = {.sync_to_ref_clock = 1, .drift_ppm = -20, .jitter = 2000, .step_cycle = 2000, .dc_step = 2 * PERIOD + PERIOD / 4,
+      .cycles = 20000};
+  sim_result_t res;
+
+  // a DC time jump of more than pll-max-err resyncs once, then relocks
+  sim_run(&cfg, &res);
+  TESTINT(res.resets, 1);
+  TESTINT(res.phased, 1);
+  TESTINT(res.p99 < 10000, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_pll_r2m_calibration) {
+  TESTSETUP;
+  sim_config_t cfg = {.jitter = 5000, .start_phase = PERIOD / 3, .cycles = 20000};
+  sim_result_t bb, pi;
+
+  // dirty activation: app_phase starts a third of a period off and is
+  // moved to 1.5 times the measured jitter
+  sim_run(&cfg, &bb);
+  TESTINT(bb.lock_time > 0, 1);
+  TESTINT(bb.p99 < 10000, 1);
+
+  cfg.controller = LCEC_PLL_PI;
+  sim_run(&cfg, &pi);
+  TESTINT(pi.lock_time > 0, 1);
+  TESTINT(pi.p99 < 10000, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_pll_r2m_outlier) {
+  TESTSETUP;
+  sim_config_t cfg = {.jitter = 5000, .outlier_cycle = 50, .outlier = 200000, .cycles = 5000};
+  sim_result_t res;
+
+  // one late wake-up during calibration doesn't move the target
+  sim_run(&cfg, &res);
+  TESTINT(res.target < 10000, 1);
+  TESTINT(res.jitter_p99 < 7000, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_pll_r2m_load_change) {
+  TESTSETUP;
+  sim_config_t cfg = {.jitter = 5000, .load_cycle = 5000, .load_jitter = 20000, .cycles = 40000};
+  sim_result_t res;
+
+  // without phase-retarget the target stays where calibration put it,
+  // while the jitter pins follow the load
+  sim_run(&cfg, &res);
+  TESTINT(res.target < 10000, 1);
+  TESTINT(res.jitter_p99 > 15000, 1);
+
+  // phase-recalibrate picks up the new load once
+  cfg.recalibrate_cycle = 30000;
+  sim_run(&cfg, &res);
+  TESTINT(res.target > 20000, 1);
+
+  // phase-retarget follows it on its own
+  cfg.recalibrate_cycle = 0;
+  cfg.retarget = 1;
+  sim_run(&cfg, &res);
+  TESTINT(res.target > 20000, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_sync0_shift) {
+  TESTSETUP;
+
+  // 100 bytes of process data plus overhead take 16 us on the wire,
+  // and the third slave adds 3 us of forwarding
+  TESTINT(lcec_sync0_frame_time(100, 2), 19000);
+  TESTINT(lcec_sync0_safe_shift(30000, 100, 2, 50000), 99000);
+  // inputs picked up at 20 us + 19 us, applied at the next SYNC0 at 99 us
+  TESTINT(lcec_sync0_latency(PERIOD, 99000, 20000, 100, 2), PERIOD + 60000);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
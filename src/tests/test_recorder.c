@@ -0,0 +1,109 @@
+#include <stdio.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+#define CYCLES 4
+#define BYTES  8
+
+static hal_bit_t frozen, trigger, rearm;
+static hal_u32_t reason;
+
+// Same layout as lcec_recorder_init() makes for one 8-byte Sync Unit,
+// without the shared memory.
+static lcec_recorder_t *new_recorder(void) {
+  lcec_recorder_t *rec = LCEC_ALLOCATE(lcec_recorder_t);
+  uint32_t frame_size = sizeof(lcec_recorder_frame_t) + BYTES;
+  uint32_t frames_offset = (sizeof(lcec_recorder_shm_t) + 7) & ~7u;
+  lcec_recorder_shm_t *shm = (lcec_recorder_shm_t *)LCEC_ALLOCATE_STRING(frames_offset + CYCLES * frame_size);
+
+  shm->magic = LCEC_RECORDER_MAGIC;
+  shm->cycles = CYCLES;
+  shm->frame_size = frame_size;
+  shm->frames_offset = frames_offset;
+  shm->unit_count = 1;
+  shm->units[0].len = BYTES;
+  rec->shm = shm;
+  rec->frames = (uint8_t *)shm + frames_offset;
+  rec->frozen = &frozen;
+  rec->reason = &reason;
+  rec->trigger = &trigger;
+  rec->rearm = &rearm;
+  frozen = trigger = rearm = 0;
+  reason = 0;
+  return rec;
+}
+
+static int record(lcec_recorder_t *rec, uint8_t value) {
+  uint8_t *data = lcec_recorder_begin(rec);
+
+  if (data == NULL) {
+    return 0;
+  }
+  memset(data, value, BYTES);
+  lcec_recorder_end(rec, 1, value, 2);
+  return 1;
+}
+
+static int frame_value(lcec_recorder_t *rec, uint32_t n) { return ((const uint8_t *)(lcec_recorder_frame(rec->shm, n) + 1))[0]; }
+
+TESTFUNC(test_recorder_trigger) {
+  TESTSETUP;
+  lcec_recorder_t *rec = new_recorder();
+  uint32_t first;
+
+  // trigger before anything was recorded is ignored
+  lcec_recorder_trigger(rec, LCEC_RECORDER_TRIGGER_WKC);
+  TESTINT(frozen, 0);
+
+  for (int i = 1; i <= 6; i++) {
+    TESTINT(record(rec, i), 1);
+  }
+  lcec_recorder_trigger(rec, LCEC_RECORDER_TRIGGER_WKC);
+  TESTINT(frozen, 1);
+  TESTINT(reason, LCEC_RECORDER_TRIGGER_WKC);
+  TESTINT(record(rec, 7), 0);
+
+  // the window ends with the trigger cycle
+  TESTINT(lcec_recorder_window(rec->shm, &first), CYCLES);
+  TESTINT(first, 2);
+  TESTINT(rec->shm->trigger_frame, 5);
+  TESTINT(frame_value(rec, first), 3);
+  TESTINT(frame_value(rec, 5), 6);
+  TESTINT(lcec_recorder_frame(rec->shm, 5)->wkc, 6);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_recorder_post_cycles) {
+  TESTSETUP;
+  lcec_recorder_t *rec = new_recorder();
+  uint32_t first;
+
+  rec->post_cycles = 2;
+  TESTINT(record(rec, 1), 1);
+  TESTINT(record(rec, 2), 1);
+  trigger = 1;
+  TESTINT(record(rec, 3), 1);
+  TESTINT(frozen, 0);
+  TESTINT(record(rec, 4), 1);
+  TESTINT(record(rec, 5), 1);
+  TESTINT(frozen, 1);
+  TESTINT(reason, LCEC_RECORDER_TRIGGER_PIN);
+  TESTINT(lcec_recorder_window(rec->shm, &first), CYCLES);
+  TESTINT(frame_value(rec, rec->shm->trigger_frame), 3);
+
+  // rearm starts over, and the held pin doesn't fire again
+  rearm = 1;
+  TESTINT(record(rec, 6), 1);
+  TESTINT(frozen, 0);
+  TESTINT(rearm, 0);
+  TESTINT(lcec_recorder_window(rec->shm, &first), 1);
+  TESTINT(frame_value(rec, first), 6);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
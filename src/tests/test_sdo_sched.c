@@ -0,0 +1,216 @@
+#include <pthread.h>
+#include <stdio.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+// A fake request backend: each request records what was written to it,
+// and stays busy until the test completes or aborts it.
+
+#define FAKE_REQUESTS 8
+
+typedef struct {
+  uint8_t data[4];
+  ec_request_state_t state;
+  int writes;
+  uint32_t written;  // data at the last write
+  int order;         // sequence number of the last write
+} fake_request_t;
+
+static fake_request_t fakes[FAKE_REQUESTS];
+static int write_seq;
+
+static ec_request_state_t fake_state(ec_sdo_request_t *req) { return ((fake_request_t *)req)->state; }
+static uint8_t *fake_data(ec_sdo_request_t *req) { return ((fake_request_t *)req)->data; }
+static void fake_write(ec_sdo_request_t *req) {
+  fake_request_t *fake = (fake_request_t *)req;
+
+  fake->state = EC_REQUEST_BUSY;
+  fake->writes++;
+  fake->written = EC_READ_U32(fake->data);
+  fake->order = ++write_seq;
+}
+
+static const lcec_sdo_backend_t fake_backend = {
+    .state = fake_state,
+    .data = fake_data,
+    .write = fake_write,
+};
+
+static lcec_sdo_sched_t *new_sched(void) {
+  lcec_master_t *master = LCEC_ALLOCATE(lcec_master_t);
+  lcec_sdo_sched_t *sched = lcec_sdo_sched_init(master, "lcec.0");
+
+  sched->backend = &fake_backend;
+  memset(fakes, 0, sizeof(fakes));
+  write_seq = 0;
+  return sched;
+}
+
+static lcec_sdo_entry_t *new_entry(lcec_sdo_sched_t *sched, int i, int prio) {
+  return lcec_sdo_sched_add_request(sched, (ec_sdo_request_t *)&fakes[i], i, 0x6065, i, 4, prio);
+}
+
+TESTFUNC(test_sdo_sched_coalesce) {
+  TESTSETUP;
+  lcec_sdo_sched_t *sched = new_sched();
+  lcec_sdo_entry_t *entry = new_entry(sched, 0, LCEC_SDO_PRIO_NORMAL);
+
+  // three values before the scheduler runs: only the last is written
+  lcec_sdo_sched_write(entry, 1);
+  lcec_sdo_sched_write(entry, 2);
+  lcec_sdo_sched_write(entry, 3);
+  lcec_sdo_sched_run(sched);
+  TESTINT(*(sched->coalesced), 2);
+  TESTINT(fakes[0].writes, 1);
+  TESTINT(fakes[0].written, 3);
+  TESTINT(entry->status, LCEC_SDO_BUSY);
+  TESTINT(*(sched->in_flight), 1);
+
+  // values arriving while busy are held back, then the last one is sent
+  lcec_sdo_sched_write(entry, 4);
+  lcec_sdo_sched_write(entry, 5);
+  lcec_sdo_sched_run(sched);
+  TESTINT(fakes[0].writes, 1);
+  fakes[0].state = EC_REQUEST_SUCCESS;
+  lcec_sdo_sched_run(sched);
+  TESTINT(*(sched->completed), 1);
+  TESTINT(fakes[0].writes, 2);
+  TESTINT(fakes[0].written, 5);
+  TESTINT(*(sched->coalesced), 3);
+
+  fakes[0].state = EC_REQUEST_SUCCESS;
+  lcec_sdo_sched_run(sched);
+  TESTINT(entry->status, LCEC_SDO_DONE);
+  TESTINT(*(sched->completed), 2);
+  TESTINT(*(sched->in_flight), 0);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_sdo_sched_limit_and_priority) {
+  TESTSETUP;
+  lcec_sdo_sched_t *sched = new_sched();
+  lcec_sdo_entry_t *entries[6];
+
+  // queued in order low, normal, low, high, normal, high
+  static const int prios[] = {LCEC_SDO_PRIO_LOW, LCEC_SDO_PRIO_NORMAL, LCEC_SDO_PRIO_LOW, LCEC_SDO_PRIO_HIGH, LCEC_SDO_PRIO_NORMAL,
+      LCEC_SDO_PRIO_HIGH};
+  for (int i = 0; i < 6; i++) {
+    entries[i] = new_entry(sched, i, prios[i]);
+    lcec_sdo_sched_write(entries[i], 100 + i);
+  }
+
+  sched->max_in_flight = 2;
+  lcec_sdo_sched_run(sched);
+  TESTINT(*(sched->in_flight), 2);
+  TESTINT(*(sched->queued), 4);
+  // high priority first, in FIFO order
+  TESTINT(fakes[3].order, 1);
+  TESTINT(fakes[5].order, 2);
+  TESTINT(fakes[1].writes, 0);
+
+  // nothing finished, nothing new starts
+  lcec_sdo_sched_run(sched);
+  TESTINT(write_seq, 2);
+
+  // one slot frees up: the oldest normal one goes next
+  fakes[5].state = EC_REQUEST_SUCCESS;
+  lcec_sdo_sched_run(sched);
+  TESTINT(fakes[1].order, 3);
+  TESTINT(*(sched->in_flight), 2);
+
+  fakes[3].state = EC_REQUEST_SUCCESS;
+  fakes[1].state = EC_REQUEST_SUCCESS;
+  lcec_sdo_sched_run(sched);
+  TESTINT(fakes[4].order, 4);
+  TESTINT(fakes[0].order, 5);
+  TESTINT(fakes[2].writes, 0);
+  TESTINT(*(sched->queued), 1);
+  TESTINT(*(sched->completed), 3);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_sdo_sched_abort) {
+  TESTSETUP;
+  lcec_sdo_sched_t *sched = new_sched();
+  lcec_sdo_entry_t *a = new_entry(sched, 2, LCEC_SDO_PRIO_NORMAL);
+  lcec_sdo_entry_t *b = lcec_sdo_sched_add_request(sched, (ec_sdo_request_t *)&fakes[3], 7, 0x607d, 1, 2, LCEC_SDO_PRIO_NORMAL);
+
+  TESTINT(*(sched->last_abort_slave), -1);
+  lcec_sdo_sched_write(a, 0x12345678);
+  lcec_sdo_sched_write(b, 0xabcd);
+  lcec_sdo_sched_run(sched);
+  TESTINT(EC_READ_U32(fakes[2].data), 0x12345678);
+  TESTINT(EC_READ_U16(fakes[3].data), 0xabcd);
+
+  fakes[2].state = EC_REQUEST_SUCCESS;
+  fakes[3].state = EC_REQUEST_ERROR;
+  lcec_sdo_sched_run(sched);
+  TESTINT(a->status, LCEC_SDO_DONE);
+  TESTINT(b->status, LCEC_SDO_ABORTED);
+  TESTINT(*(sched->completed), 1);
+  TESTINT(*(sched->aborted), 1);
+  TESTINT(*(sched->last_abort_slave), 7);
+  TESTINT(*(sched->last_abort_object), 0x607d01);
+
+  // an aborted object can be written again
+  lcec_sdo_sched_write(b, 0x1234);
+  lcec_sdo_sched_run(sched);
+  TESTINT(fakes[3].writes, 2);
+  TESTINT(b->status, LCEC_SDO_BUSY);
+
+  // unsupported sizes and priorities are refused
+  TESTINT(lcec_sdo_sched_add_request(sched, (ec_sdo_request_t *)&fakes[4], 0, 0x1000, 0, 3, LCEC_SDO_PRIO_NORMAL) == NULL, 1);
+  TESTINT(lcec_sdo_sched_add_request(sched, (ec_sdo_request_t *)&fakes[4], 0, 0x1000, 0, 4, LCEC_SDO_PRIO_COUNT) == NULL, 1);
+
+  TESTRESULTS;
+}
+
+// A Sync Unit with its own functions writes from its own thread while
+// the master runs the scheduler.
+#define THREAD_WRITES 200000
+
+typedef struct {
+  lcec_sdo_entry_t *entry;
+  int done;
+} writer_t;
+
+static void *writer_thread(void *arg) {
+  writer_t *w = (writer_t *)arg;
+
+  for (uint32_t i = 1; i <= THREAD_WRITES; i++) {
+    lcec_sdo_sched_write(w->entry, i);
+  }
+  __atomic_store_n(&w->done, 1, __ATOMIC_RELEASE);
+  return NULL;
+}
+
+TESTFUNC(test_sdo_sched_thread) {
+  TESTSETUP;
+  lcec_sdo_sched_t *sched = new_sched();
+  writer_t w = {new_entry(sched, 0, LCEC_SDO_PRIO_NORMAL), 0};
+  pthread_t thread;
+  int done;
+
+  TESTINT(pthread_create(&thread, NULL, writer_thread, &w), 0);
+  do {
+    done = __atomic_load_n(&w.done, __ATOMIC_ACQUIRE);
+    lcec_sdo_sched_run(sched);
+    // every write finishes by the next cycle
+    fakes[0].state = EC_REQUEST_SUCCESS;
+  } while (!done || *(sched->queued) != 0 || *(sched->in_flight) != 0 || w.entry->pending);
+  pthread_join(thread, NULL);
+
+  // the last value reached the slave, and every write was either sent or replaced
+  TESTINT(fakes[0].written, THREAD_WRITES);
+  TESTINT(fakes[0].writes + *(sched->coalesced), THREAD_WRITES);
+  TESTINT(w.entry->status, LCEC_SDO_DONE);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
@@ -0,0 +1,77 @@
+#include <stdio.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+TESTFUNC(test_syncs_grow) {
+  TESTSETUP;
+  lcec_slave_t *slave = lcec_test_slave(NULL, 0);
+  lcec_syncs_t *syncs = LCEC_ALLOCATE(lcec_syncs_t);
+  ec_sync_info_t *sync_info;
+
+  // more syncs, PDOs and entries than the initial room, and more
+  // entries than the old fixed arrays held
+  lcec_syncs_init(slave, syncs);
+  TESTINT(slave->syncs == syncs, 1);
+  for (int s = 0; s < 8; s++) {
+    TESTINT(lcec_syncs_add_sync(syncs, (s & 1) ? EC_DIR_INPUT : EC_DIR_OUTPUT, EC_WD_DEFAULT), 0);
+    for (int p = 0; p < 5; p++) {
+      TESTINT(lcec_syncs_add_pdo_info(syncs, 0x1600 + s * 0x10 + p), 0);
+      for (int e = 0; e < 8; e++) {
+        TESTINT(lcec_syncs_add_pdo_entry(syncs, 0x6000 + s, p * 8 + e + 1, 16), 0);
+      }
+    }
+  }
+  TESTINT(syncs->error, 0);
+  TESTINT(syncs->pdo_entry_count, 320);
+
+  sync_info = lcec_syncs_compact(syncs);
+  TESTINT(sync_info == syncs->syncs, 1);
+  TESTINT((int)syncs->size, (int)(9 * sizeof(ec_sync_info_t) + 40 * sizeof(ec_pdo_info_t) + 320 * sizeof(ec_pdo_entry_info_t)));
+  TESTINT(sync_info[8].index, 0xff);
+  TESTINT(sync_info[7].dir, EC_DIR_INPUT);
+  TESTINT(sync_info[7].n_pdos, 5);
+  TESTINT(sync_info[7].pdos[4].index, 0x1674);
+  TESTINT(sync_info[7].pdos[4].n_entries, 8);
+  TESTINT(sync_info[7].pdos[4].entries[7].index, 0x6007);
+  TESTINT(sync_info[7].pdos[4].entries[7].subindex, 40);
+  TESTINT(sync_info[0].pdos[0].entries[0].subindex, 1);
+
+  // compacted layouts are final
+  TESTINT(lcec_syncs_compact(syncs) == sync_info, 1);
+  TESTINT(lcec_syncs_add_pdo_entry(syncs, 0x6000, 1, 16), -1);
+  TESTINT(syncs->error, 1);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_syncs_autoflow) {
+  TESTSETUP;
+  lcec_slave_t *slave = lcec_test_slave(NULL, 0);
+  lcec_syncs_t *syncs = LCEC_ALLOCATE(lcec_syncs_t);
+  ec_sync_info_t *sync_info;
+
+  // two entries per PDO, at most 4 PDOs
+  lcec_syncs_init(slave, syncs);
+  lcec_syncs_enable_autoflow(slave, syncs, 4, 2, 1);
+  lcec_syncs_add_sync(syncs, EC_DIR_OUTPUT, EC_WD_DEFAULT);
+  lcec_syncs_add_pdo_info(syncs, 0x1600);
+  for (int e = 0; e < 6; e++) {
+    lcec_syncs_add_pdo_entry(syncs, 0x2000, e, 32);
+  }
+  TESTINT(syncs->error, 0);
+
+  // a full PDO opens the next one right away, so the last one is empty
+  sync_info = lcec_syncs_compact(syncs);
+  TESTINT(sync_info[0].n_pdos, 4);
+  TESTINT(sync_info[0].pdos[3].n_entries, 0);
+  TESTINT(sync_info[0].pdos[2].index, 0x1602);
+  TESTINT(sync_info[0].pdos[2].entries[1].subindex, 5);
+  TESTINT(sync_info[1].index, 0xff);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
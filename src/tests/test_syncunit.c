@@ -0,0 +1,126 @@
+#include <stdio.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+static lcec_sync_unit_t *add_sync_unit(lcec_master_t *master, unsigned int divider, int phase, int size) {
+  lcec_sync_unit_t *sync_unit = LCEC_ALLOCATE(lcec_sync_unit_t);
+
+  sync_unit->cycle_divider = divider;
+  sync_unit->cycle_phase = phase;
+  sync_unit->process_data_len = size;
+  LCEC_LIST_APPEND(master->first_sync_unit, master->last_sync_unit, sync_unit);
+  return sync_unit;
+}
+
+TESTFUNC(test_spread_phases_even) {
+  TESTSETUP;
+  lcec_master_t *master = LCEC_ALLOCATE(lcec_master_t);
+  lcec_sync_unit_t *fast = add_sync_unit(master, 1, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 100);
+  lcec_sync_unit_t *a = add_sync_unit(master, 4, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 40);
+  lcec_sync_unit_t *b = add_sync_unit(master, 4, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 30);
+  lcec_sync_unit_t *c = add_sync_unit(master, 2, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 50);
+
+  TESTINT(lcec_sync_unit_spread_phases(master), 0);
+  TESTINT(fast->cycle_phase, 0);
+  // largest first: c takes cycles 0 and 2, a then fits on 1, b on 3
+  TESTINT(c->cycle_phase, 0);
+  TESTINT(a->cycle_phase, 1);
+  TESTINT(b->cycle_phase, 3);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_spread_phases_fixed) {
+  TESTSETUP;
+  lcec_master_t *master = LCEC_ALLOCATE(lcec_master_t);
+  lcec_sync_unit_t *fixed = add_sync_unit(master, 2, 0, 50);
+  lcec_sync_unit_t *a = add_sync_unit(master, 2, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 50);
+  lcec_sync_unit_t *b = add_sync_unit(master, 3, LCEC_CONF_SYNC_UNIT_PHASE_AUTO, 0);
+
+  TESTINT(lcec_sync_unit_spread_phases(master), 0);
+  TESTINT(fixed->cycle_phase, 0);
+  TESTINT(a->cycle_phase, 1);
+  TESTINT(b->cycle_phase, 0);
+
+  TESTRESULTS;
+}
+
+static int reads[3], writes[3];
+
+static void count_read(lcec_slave_t *slave, long period) { reads[slave->index]++; }
+
+static void count_write(lcec_slave_t *slave, long period) {
+  writes[slave->index]++;
+  EC_WRITE_U8(&slave->sync_unit->process_data[slave->index], 0x55);
+}
+
+static unsigned int out_offset[3];
+static ec_pdo_entry_info_t out_entries[] = {{0x7000, 0x01, 8}};
+static ec_pdo_info_t out_pdos[] = {{0x1600, 1, out_entries}};
+static ec_sync_info_t out_syncs[] = {{2, EC_DIR_OUTPUT, 1, out_pdos, EC_WD_DEFAULT}, {0xff}};
+
+static lcec_master_t *new_oper_master(lcec_sync_unit_t **sync_unit) {
+  lcec_master_t *master = LCEC_ALLOCATE(lcec_master_t);
+  *sync_unit = add_sync_unit(master, 1, 0, 3);
+  (*sync_unit)->process_data = LCEC_ALLOCATE_ARRAY(uint8_t, 3);
+
+  for (int i = 0; i < 3; i++) {
+    lcec_slave_t *slave = LCEC_ALLOCATE(lcec_slave_t);
+    slave->index = i;
+    slave->master = master;
+    slave->sync_unit = *sync_unit;
+    slave->proc_read = count_read;
+    slave->proc_write = count_write;
+    slave->sync_info = out_syncs;
+    slave->regs = LCEC_ALLOCATE(lcec_pdo_entry_reg_t);
+    slave->regs->max = 1;
+    slave->regs->pdo_entry_regs = LCEC_ALLOCATE_ARRAY(ec_pdo_entry_reg_t, 1);
+    lcec_pdo_init(slave, 0x7000, 0x01, &out_offset[i], NULL);
+    out_offset[i] = i;
+    LCEC_LIST_APPEND(master->first_slave, master->last_slave, slave);
+    reads[i] = writes[i] = 0;
+  }
+  lcec_sync_unit_build_dispatch(master, *sync_unit);
+  return master;
+}
+
+TESTFUNC(test_skip_non_op) {
+  TESTSETUP;
+  lcec_sync_unit_t *sync_unit;
+  lcec_master_t *master = new_oper_master(&sync_unit);
+
+  TESTINT(sync_unit->dispatch_count, 3);
+  TESTINT(sync_unit->dispatch[1].safe_offset, 1);
+  TESTINT(sync_unit->dispatch[1].safe_len, 1);
+
+  TESTINT(lcec_sync_unit_set_oper(sync_unit, 1, 0), 1);
+  TESTINT(lcec_sync_unit_set_oper(sync_unit, 1, 0), 0);
+  for (int i = 0; i < 3; i++) {
+    lcec_sync_unit_read(master, sync_unit);
+    lcec_sync_unit_write(master, sync_unit);
+  }
+  // slave 1 still sees the cycle it dropped out of OP, then is skipped
+  TESTINT(reads[0], 3);
+  TESTINT(reads[1], 1);
+  TESTINT(writes[1], 1);
+  TESTINT(sync_unit->process_data[1], 0x55);
+
+  sync_unit->safe_outputs = 1;
+  lcec_sync_unit_write(master, sync_unit);
+  TESTINT(sync_unit->process_data[0], 0x55);
+  TESTINT(sync_unit->process_data[1], 0);
+
+  TESTINT(lcec_sync_unit_set_oper(sync_unit, 1, 1), -1);
+  lcec_sync_unit_read(master, sync_unit);
+  lcec_sync_unit_write(master, sync_unit);
+  TESTINT(reads[1], 2);
+  TESTINT(writes[1], 2);
+  TESTINT(sync_unit->process_data[1], 0x55);
+
+  TESTRESULTS;
+}
+
+TESTMAIN
@@ -0,0 +1,78 @@
+#include <stdio.h>
+
+#include "../../src/lcec.h"
+#include "tests.h"
+
+TESTGLOBALSETUP;
+
+TESTFUNC(test_trace_read) {
+  TESTSETUP;
+  lcec_trace_ring_t *ring = LCEC_ALLOCATE(lcec_trace_ring_t);
+  lcec_trace_event_t events[8];
+  uint32_t tail = 0, lost = 0;
+
+  lcec_trace_reset(ring);
+  TESTINT(lcec_trace_read(ring, &tail, events, 8, &lost), 0);
+
+  lcec_trace_event(ring, LCEC_TRACE_WKC, -1, 12, 10);
+  lcec_trace_event(ring, LCEC_TRACE_SLAVE_STATE, 3, 8, 4);
+  TESTINT(lcec_trace_read(ring, &tail, events, 8, &lost), 2);
+  TESTINT(events[0].type, LCEC_TRACE_WKC);
+  TESTINT(events[0].a, 12);
+  TESTINT(events[1].slave, 3);
+  TESTINT(events[1].time >= events[0].time, 1);
+  TESTINT(tail, 2);
+  TESTINT(lost, 0);
+
+  // partial reads pick up where they stopped
+  for (int i = 0; i < 5; i++) {
+    lcec_trace_event(ring, LCEC_TRACE_LOCK_WAIT, -1, i, 0);
+  }
+  TESTINT(lcec_trace_read(ring, &tail, events, 3, &lost), 3);
+  TESTINT(lcec_trace_read(ring, &tail, events, 8, &lost), 2);
+  TESTINT(events[1].a, 4);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_trace_overrun) {
+  TESTSETUP;
+  lcec_trace_ring_t *ring = LCEC_ALLOCATE(lcec_trace_ring_t);
+  lcec_trace_event_t events[8];
+  uint32_t tail = 0, lost = 0;
+
+  lcec_trace_reset(ring);
+  for (int i = 0; i < LCEC_TRACE_SIZE + 10; i++) {
+    lcec_trace_event(ring, LCEC_TRACE_LOCK_WAIT, -1, i, 0);
+  }
+
+  // the oldest slot still in the ring is the next one to be written,
+  // so it is dropped too
+  TESTINT(lcec_trace_read(ring, &tail, events, 8, &lost), 7);
+  TESTINT(lost, 11);
+  TESTINT(events[0].a, 11);
+  TESTINT(tail, 18);
+
+  TESTRESULTS;
+}
+
+TESTFUNC(test_trace_format) {
+  TESTSETUP;
+  lcec_trace_event_t ev = {0, LCEC_TRACE_SDO_UPLOAD_FAIL, 2, 0x801001, 0x06020000};
+  char buf[64];
+
+  lcec_trace_format(&ev, buf, sizeof(buf));
+  TESTSTRING(buf, "0x8010:0x01 abort_code 06020000");
+  TESTSTRING(lcec_trace_type_name(ev.type), "sdo-upload-fail");
+  TESTSTRING(lcec_trace_type_name(LCEC_TRACE_TYPE_COUNT), "unknown");
+
+  ev.type = LCEC_TRACE_PLL_RESET;
+  ev.a = (uint32_t)-250000;
+  ev.b = (uint32_t)-250000;
+  lcec_trace_format(&ev, buf, sizeof(buf));
+  TESTSTRING(buf, "offset -250000 ns, correction -250000 ns");
+
+  TESTRESULTS;
+}
+
+TESTMAIN
@@ -88,3 +88,22 @@
   } while (0)
 #define TESTMAIN \
   int main(int argc, char **argv) { TESTMAINRESULTS; }
+
+/// @brief A slave on its own master and Sync Unit, for driver tests and
+/// benchmarks.
+///
+/// Include `lcec.h` first.  `pd` becomes the Sync Unit's process data;
+/// it is left as it is, so clear or fill it as the test needs.
+///
+/// @param pd Process data buffer, or NULL.
+/// @param pd_len Size of `pd` in bytes.
+static inline lcec_slave_t *lcec_test_slave(uint8_t *pd, int pd_len) {
+  lcec_slave_t *slave = LCEC_ALLOCATE(lcec_slave_t);
+
+  slave->master = LCEC_ALLOCATE(lcec_master_t);
+  slave->sync_unit = LCEC_ALLOCATE(lcec_sync_unit_t);
+  slave->sync_unit->process_data = pd;
+  slave->sync_unit->process_data_len = pd_len;
+  slave->regs = lcec_allocate_pdo_entry_reg(LCEC_PDO_REG_INITIAL_COUNT);
+  return slave;
+}